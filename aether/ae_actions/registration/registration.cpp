@@ -19,6 +19,7 @@
 #if AE_SUPPORT_REGISTRATION
 
 #  include <utility>
+#  include <algorithm>
 
 #  include "aether/crypto/crypto_definitions.h"
 #  include "aether/crypto/key_gen.h"
@@ -61,6 +62,7 @@ Registration::Registration(ActionContext action_context, PtrView<Aether> aether,
       state_{State::kConnection},
       // TODO: add configuration
       response_timeout_{std::chrono::seconds(20)},
+      crypto_lib_profile_{SelectCryptoLibProfile()},
       sign_pk_{aether_.Lock()->crypto->signs_pk_[kDefaultSignatureMethod]} {
   AE_TELE_INFO("Registration Started");
 
@@ -98,7 +100,9 @@ Registration::Registration(ActionContext action_context, PtrView<Aether> aether,
       protocol_context_.OnMessage<ClientApiRegSafe::ResolveServersResponse>(
           [this](auto const& action) {
             OnResolveCloudResponse(action.message());
-          }));
+          }),
+      protocol_context_.OnMessage<SendError>(
+          [this](auto const& action) { OnSendError(action.message()); }));
 }
 
 Registration::~Registration() { AE_TELED_DEBUG("~Registration"); }
@@ -107,6 +111,9 @@ TimePoint Registration::Update(TimePoint current_time) {
   AE_TELED_DEBUG("Registration::Update {}",
                  FormatTimePoint("UTC :%Y-%m-%d %H:%M:%S", current_time));
 
+  // fail requests without response, it may change the state
+  auto expiration_time = protocol_context_.ExpireSendResults(current_time);
+
   // TODO: add check for actual packet sending or method timeouts
   if (state_.changed()) {
     switch (state_.Acquire()) {
@@ -142,11 +149,14 @@ TimePoint Registration::Update(TimePoint current_time) {
   }
   switch (state_.get()) {
     case State::kWaitKeys:
-      return WaitKeys(current_time);
+      return std::min(WaitKeys(current_time), expiration_time);
     default:
       break;
   }
 
+  if (expiration_time != TimePoint::max()) {
+    return expiration_time;
+  }
   return current_time;
 }
 
@@ -203,12 +213,12 @@ void Registration::Connected(TimePoint current_time) {
 void Registration::GetKeys(TimePoint current_time) {
   AE_TELED_DEBUG("Registration::GetKeys");
   state_.Set(State::kWaitKeys);
+  request_id_ = RequestId::GenRequestId();
   auto packet = PacketBuilder{
       protocol_context_,
       PackMessage{
           RootApi{},
-          RootApi::GetAsymmetricPublicKey{
-              {}, RequestId::GenRequestId(), kDefaultCryptoLibProfile},
+          RootApi::GetAsymmetricPublicKey{{}, request_id_, crypto_lib_profile_},
       },
   };
 
@@ -217,20 +227,34 @@ void Registration::GetKeys(TimePoint current_time) {
 
   // on error try repeat
   raw_transport_send_action_subscription_ =
-      packet_write_action_->SubscribeOnError(
-          [this](auto const&) { state_.Set(State::kConnection); });
+      packet_write_action_->SubscribeOnError([this](auto const&) {
+        FallbackCryptoLibProfile();
+        state_.Set(State::kConnection);
+      });
   last_request_time_ = current_time;
 }
 
 TimePoint Registration::WaitKeys(TimePoint current_time) {
   if (last_request_time_ + response_timeout_ < current_time) {
     AE_TELED_DEBUG("Registration::WaitKeys: timeout");
+    FallbackCryptoLibProfile();
     state_.Set(State::kGetKeys);
     return current_time;
   }
   return last_request_time_ + response_timeout_;
 }
 
+void Registration::FallbackCryptoLibProfile() {
+  // the server may not support the offered profile, repeat with the default
+  if (crypto_lib_profile_ == kDefaultCryptoLibProfile) {
+    return;
+  }
+  AE_TELED_WARNING("No answer for crypto lib profile {}, fall back to {}",
+                   static_cast<int>(crypto_lib_profile_),
+                   static_cast<int>(kDefaultCryptoLibProfile));
+  crypto_lib_profile_ = kDefaultCryptoLibProfile;
+}
+
 void Registration::OnGetKeysResponse(
     ClientApiRegSafe::GetKeysResponse const& message) {
   AE_TELED_DEBUG("Registration::OnGetKeysResponse");
@@ -252,7 +276,7 @@ void Registration::RequestPowParams(TimePoint current_time) {
   AE_TELED_DEBUG("Registration::RequestPowParams");
 
   Key secret_key;
-  [[maybe_unused]] auto r = CryptoSyncKeygen(secret_key);
+  [[maybe_unused]] auto r = CryptoSyncKeygen(secret_key, crypto_lib_profile_);
   assert(r);
 
   server_async_key_provider_ = MakePtr<RegistrationAsyncKeyProvider>();
@@ -265,6 +289,7 @@ void Registration::RequestPowParams(TimePoint current_time) {
       StreamIdGenerator::GetNextClientStreamId(), server_async_key_provider_,
       server_sync_key_provider_);
 
+  request_id_ = RequestId::GenRequestId();
   packet_write_action_ = reg_server_stream_->in().Write(
       PacketBuilder{
           protocol_context_,
@@ -272,7 +297,7 @@ void Registration::RequestPowParams(TimePoint current_time) {
               ServerRegistrationApi{},
               ServerRegistrationApi::RequestProofOfWorkData{
                   {},
-                  RequestId::GenRequestId(),
+                  request_id_,
                   parent_uid_,
                   PowMethod::kBCryptCrc32,
                   std::move(secret_key),
@@ -353,13 +378,14 @@ void Registration::MakeRegistration(TimePoint current_time) {
 
   Tie(*global_reg_server_stream_, *reg_server_stream_);
 
+  request_id_ = RequestId::GenRequestId();
   packet_write_action_ = global_reg_server_stream_->in().Write(
       PacketBuilder{
           protocol_context_,
           PackMessage{
               GlobalRegServerApi{},
               GlobalRegServerApi::SetMasterKey{{}, master_key_},
-              GlobalRegServerApi::Finish{{}, RequestId::GenRequestId()},
+              GlobalRegServerApi::Finish{{}, request_id_},
           },
       },
       current_time);
@@ -388,6 +414,7 @@ void Registration::OnConfirmRegistration(
 void Registration::ResolveCloud(TimePoint current_time) {
   AE_TELED_DEBUG("Registration::ResolveCloud");
 
+  request_id_ = RequestId::GenRequestId();
   packet_write_action_ = reg_server_stream_->in().Write(
       PacketBuilder{
           protocol_context_,
@@ -395,7 +422,7 @@ void Registration::ResolveCloud(TimePoint current_time) {
               ServerRegistrationApi{},
               ServerRegistrationApi::ResolveServers{
                   {},
-                  RequestId::GenRequestId(),
+                  request_id_,
                   cloud_,
               },
           },
@@ -445,7 +472,8 @@ void Registration::OnResolveCloudResponse(
     aether->AddServer(std::move(server));
   }
 
-  client_->SetConfig(uid_, ephemeral_uid_, master_key_, std::move(new_cloud));
+  client_->SetConfig(uid_, ephemeral_uid_, master_key_, std::move(new_cloud),
+                     crypto_lib_profile_);
 
   AE_TELED_DEBUG("Client registered with uid {} and ephemeral uid {}",
                  client_->uid(), client_->ephemeral_uid());
@@ -453,6 +481,21 @@ void Registration::OnResolveCloudResponse(
   state_.Set(State::kRegistered);
 }
 
+void Registration::OnSendError(SendError const& error) {
+  if (error.request_id != request_id_) {
+    return;
+  }
+  AE_TELED_ERROR("Registration request {} failed with error {}",
+                 error.request_id.id, error.error_code);
+  if (state_.get() == State::kWaitKeys) {
+    // repeat as on the response timeout
+    FallbackCryptoLibProfile();
+    state_.Set(State::kGetKeys);
+    return;
+  }
+  state_.Set(State::kRegistrationFailed);
+}
+
 Ptr<ByteStream> Registration::CreateRegServerStream(
     StreamId stream_id, Ptr<IAsyncKeyProvider> async_key_provider,
     Ptr<ISyncKeyProvider> sync_key_provider) {
@@ -470,7 +513,7 @@ Ptr<ByteStream> Registration::CreateRegServerStream(
                         RootApi::Enter{
                             {},
                             stream_id,
-                            kDefaultCryptoLibProfile,
+                            crypto_lib_profile_,
                         }},
       ProtocolReadGate{protocol_context_, root_api_},
       TransportWriteGate{*aether->action_processor, current_server_transport_});
@@ -34,6 +34,7 @@
 
 #  include "aether/stream_api/istream.h"
 #  include "aether/crypto/ikey_provider.h"
+#  include "aether/crypto/crypto_definitions.h"
 
 #  include "aether/transport/itransport.h"
 #  include "aether/server_list/server_list.h"
@@ -84,6 +85,7 @@ class Registration : public Action<Registration> {
 
   void GetKeys(TimePoint current_time);
   TimePoint WaitKeys(TimePoint current_time);
+  void FallbackCryptoLibProfile();
   void OnGetKeysResponse(ClientApiRegSafe::GetKeysResponse const& message);
   void RequestPowParams(TimePoint current_time);
   void OnResponsePowParams(
@@ -94,6 +96,7 @@ class Registration : public Action<Registration> {
   void ResolveCloud(TimePoint current_time);
   void OnResolveCloudResponse(
       ClientApiRegSafe::ResolveServersResponse const& message);
+  void OnSendError(SendError const& error);
 
   Ptr<ByteStream> CreateRegServerStream(
       StreamId stream_id, Ptr<IAsyncKeyProvider> async_key_provider,
@@ -119,7 +122,12 @@ class Registration : public Action<Registration> {
 
   Duration response_timeout_;
   TimePoint last_request_time_;
+  // the request waiting for response, errors of older ones are ignored
+  RequestId request_id_{};
 
+  // AES-256-GCM if it's enabled and supported by CPU, default otherwise or if
+  // the server does not answer to it
+  CryptoLibProfile crypto_lib_profile_;
   Key server_pub_key_;
   Key master_key_;
   Uid uid_;
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_API_PROTOCOL_API_DISPATCH_H_
+#define AETHER_API_PROTOCOL_API_DISPATCH_H_
+
+#include <array>
+#include <limits>
+#include <cstddef>
+
+#include "aether/api_protocol/api_message.h"
+#include "aether/api_protocol/api_protocol.h"
+
+namespace ae {
+namespace _internal {
+template <typename TApiClass>
+using ApiMessageHandler = void (*)(TApiClass& api_class, ApiParser& parser);
+
+template <typename TApiClass>
+using ApiDispatchArray =
+    std::array<ApiMessageHandler<TApiClass>,
+               std::size_t{std::numeric_limits<MessageId>::max()} + 1>;
+
+template <typename TApiClass, typename TMessageCode>
+void LoadApiMessage(TApiClass& api_class, ApiParser& parser) {
+  parser.Load<typename TMessageCode::MessageType>(api_class);
+}
+
+template <MessageId... Codes>
+constexpr bool UniqueMessageCodes() {
+  constexpr auto codes = std::array<MessageId, sizeof...(Codes)>{Codes...};
+  for (std::size_t i = 0; i < codes.size(); ++i) {
+    for (std::size_t j = i + 1; j < codes.size(); ++j) {
+      if (codes[i] == codes[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename TApiClass, typename... TMessageCodes>
+constexpr ApiDispatchArray<TApiClass> MakeDispatchArray() {
+  auto table = ApiDispatchArray<TApiClass>{};
+  ((table[TMessageCodes::kCode] = &LoadApiMessage<TApiClass, TMessageCodes>),
+   ...);
+  return table;
+}
+}  // namespace _internal
+
+/**
+ * \brief Dispatch table for api class messages.
+ * Table has a handler for each possible MessageId and is built at compile
+ * time, so message loading is a single indexed call.
+ */
+template <typename TApiClass, typename TMessageList>
+class ApiDispatchTable;
+
+template <typename TApiClass, typename... TMessageCodes>
+class ApiDispatchTable<TApiClass, ApiMessageList<TMessageCodes...>> {
+  static_assert(_internal::UniqueMessageCodes<TMessageCodes::kCode...>(),
+                "Message codes must be unique");
+
+ public:
+  /**
+   * \brief Load message with code to api_class.
+   * \return false if api_class has no message with such code.
+   */
+  static bool Load(TApiClass& api_class, MessageId code, ApiParser& parser) {
+    auto handler = kTable[code];
+    if (handler == nullptr) {
+      return false;
+    }
+    handler(api_class, parser);
+    return true;
+  }
+
+ private:
+  static constexpr auto kTable =
+      _internal::MakeDispatchArray<TApiClass, TMessageCodes...>();
+};
+
+/**
+ * \brief Load message by code with the api class's message list.
+ * \see ApiDispatchTable
+ */
+template <typename TApiClass>
+bool DispatchLoad(TApiClass& api_class, MessageId code, ApiParser& parser) {
+  return ApiDispatchTable<TApiClass, typename TApiClass::Messages>::Load(
+      api_class, code, parser);
+}
+}  // namespace ae
+
+#endif  // AETHER_API_PROTOCOL_API_DISPATCH_H_
@@ -18,6 +18,7 @@
 #define AETHER_API_PROTOCOL_API_MESSAGE_H_
 
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 #include "aether/packed_int.h"
@@ -39,15 +40,59 @@ struct MessageBufferWriter : VectorWriter<PackedSize> {
 
   ApiPacker& packer;
 };
-struct MessageBufferReader : VectorReader<PackedSize> {
+// reads from memory owned by someone else, e.g. the parent packet
+struct MessageBufferReader {
+  using size_type = PackedSize;
+
+  MessageBufferReader(std::uint8_t const* data, std::size_t size, ApiParser& p)
+      : data_{data}, size_{size}, parser{p} {}
   MessageBufferReader(std::vector<uint8_t> const& data, ApiParser& p)
-      : VectorReader(data), parser{p} {}
+      : MessageBufferReader{data.data(), data.size(), p} {}
+
+  size_t read(void* data, size_t size, size_t /* min_size */) {
+    if (offset_ + size > size_) {
+      result_ = ReadResult::kNo;
+      return 0;
+    }
+    std::memcpy(data, data_ + offset_, size);
+    offset_ += size;
+    result_ = ReadResult::kYes;
+    return size;
+  }
+
+  ReadResult result() const { return result_; }
+  void result(ReadResult result) { result_ = result; }
+
+  std::uint8_t const* current() const { return data_ + offset_; }
+  std::size_t available() const { return size_ - offset_; }
+  void skip(std::size_t size) { offset_ += size; }
+
+  std::uint8_t const* data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+  ReadResult result_{};
   ApiParser& parser;
 };
 
 using message_ostream = ae::omstream<MessageBufferWriter>;
 using message_istream = ae::imstream<MessageBufferReader>;
 
+/**
+ * \brief Message with its code in api class.
+ */
+template <MessageId Code, typename TMessage>
+struct ApiMessageCode {
+  static constexpr MessageId kCode = Code;
+  using MessageType = TMessage;
+};
+
+/**
+ * \brief List of api class messages.
+ * Each element is an ApiMessageCode.
+ */
+template <typename... TMessageCodes>
+struct ApiMessageList {};
+
 // Base for all messages
 template <typename T>
 struct Message {
@@ -20,20 +20,25 @@
 #include <iostream>
 
 #include "aether/api_protocol/child_data.h"
+#include "aether/api_protocol/api_dispatch.h"
 
 namespace ae {
 ApiParser::ApiParser(ProtocolContext& protocol_context,
                      std::vector<std::uint8_t> const& data)
     : protocol_context_{protocol_context}, buffer_reader_{data, *this} {}
 
+ApiParser::ApiParser(ProtocolContext& protocol_context,
+                     std::uint8_t const* data, std::size_t size)
+    : protocol_context_{protocol_context}, buffer_reader_{data, size, *this} {}
+
 ApiParser::ApiParser(ProtocolContext& protocol_context_,
                      ChildData const& child_data)
-    : ApiParser{protocol_context_, child_data.PackData()} {}
+    : ApiParser{protocol_context_, child_data.data(), child_data.size()} {}
 
 ApiParser::~ApiParser() = default;
 
 void ApiParser::Parse(ApiClass& api_class) {
-  while (buffer_reader_.offset_ < buffer_reader_.data_.size()) {
+  while (buffer_reader_.offset_ < buffer_reader_.size_) {
     MessageId message_id{std::numeric_limits<MessageId>::max()};
     istream_ >> message_id;
     api_class.LoadFactory(message_id, *this);
@@ -43,7 +48,7 @@ void ApiParser::Parse(ApiClass& api_class) {
 ProtocolContext& ApiParser::Context() { return protocol_context_; }
 
 void ApiParser::Cancel() {
-  buffer_reader_.offset_ = buffer_reader_.data_.size();
+  buffer_reader_.offset_ = buffer_reader_.size_;
 }
 
 ApiPacker::ApiPacker(ProtocolContext& protocol_context_,
@@ -57,17 +62,7 @@ MessageBufferWriter& ApiPacker::Buffer() { return buffer_writer_; }
 ProtocolContext& ApiPacker::Context() { return protocol_context_; }
 
 bool ReturnResultApi::LoadResult(MessageId message_id, ApiParser& parser) {
-  switch (message_id) {
-    case kSendResult:
-      parser.Load<SendResult>(*this);
-      return true;
-    case kSendError:
-      parser.Load<SendError>(*this);
-      return true;
-    default:
-      break;
-  }
-  return false;
+  return DispatchLoad(*this, message_id, parser);
 }
 
 void ReturnResultApi::Execute(SendResult&& result, ApiParser& parser) {
@@ -77,7 +72,11 @@ void ReturnResultApi::Execute(SendResult&& result, ApiParser& parser) {
 void ReturnResultApi::Execute(SendError&& error, ApiParser& parser) {
   std::cerr << "SendError: id " << error.request_id.id << " error code "
             << error.error_code << std::endl;
-  parser.Context().MessageNotify(std::move(error));
+  // the request's error callback reports the error itself
+  if (!parser.Context().SetSendResultError(error.request_id,
+                                           error.error_code)) {
+    parser.Context().MessageNotify(std::move(error));
+  }
 }
 
 void ReturnResultApi::Pack(SendResult&& result, ApiPacker& packer) const {
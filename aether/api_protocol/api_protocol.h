@@ -48,6 +48,8 @@ class ApiParser {
  public:
   ApiParser(ProtocolContext& protocol_context_,
             std::vector<std::uint8_t> const& data);
+  ApiParser(ProtocolContext& protocol_context_, std::uint8_t const* data,
+            std::size_t size);
   ApiParser(ProtocolContext& protocol_context_, ChildData const& child_data);
   ~ApiParser();
 
@@ -57,7 +59,10 @@ class ApiParser {
   void Load(TApiClass& api_class) {
     Message msg{};
     msg.Load(istream_);
-    protocol_context_.PushApiClass(TApiClass::kClassId, &api_class);
+    if (!protocol_context_.PushApiClass(TApiClass::kClassId, &api_class)) {
+      Cancel();
+      return;
+    }
     api_class.Execute(std::move(msg), *this);
     protocol_context_.PopApiClass(TApiClass::kClassId);
   }
@@ -160,6 +165,9 @@ class ReturnResultApi {
   static constexpr MessageId kSendResult = 0;
   static constexpr MessageId kSendError = 1;
 
+  using Messages = ApiMessageList<ApiMessageCode<kSendResult, SendResult>,
+                                  ApiMessageCode<kSendError, SendError>>;
+
   bool LoadResult(MessageId message_id, ApiParser& parser);
 
   void Execute(SendResult&& result, ApiParser& parser);
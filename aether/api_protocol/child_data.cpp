@@ -16,6 +16,9 @@
 
 #include "aether/api_protocol/child_data.h"
 
+#include <cstring>
+#include <cassert>
+
 namespace ae {
 ChildData::ChildData() = default;
 
@@ -26,19 +29,67 @@ ChildData::ChildData(std::unique_ptr<IPackMessage> pack_message)
 
 std::vector<std::uint8_t> ChildData::PackData(
     ProtocolContext& protocol_context) && {
-  if (pack_data_.index() == 0) {
-    return DataPackMessage(protocol_context,
-                           std::move(*std::get<0>(pack_data_)));
-  } else {
-    return std::move(std::get<1>(pack_data_));
+  switch (pack_data_.index()) {
+    case 0:
+      return DataPackMessage(protocol_context,
+                             std::move(*std::get<0>(pack_data_)));
+    case 1:
+      return std::move(std::get<1>(pack_data_));
+    default:
+      return CopyData();
   }
 }
 
-std::vector<std::uint8_t> const& ChildData::PackData() const {
-  if (pack_data_.index() == 0) {
-    assert(false);
+std::uint8_t const* ChildData::data() const {
+  assert(pack_data_.index() != 0);
+  if (pack_data_.index() == 1) {
+    return std::get<1>(pack_data_).data();
   }
-  return std::get<1>(pack_data_);
+  return std::get<2>(pack_data_).data;
+}
+
+std::size_t ChildData::size() const {
+  assert(pack_data_.index() != 0);
+  if (pack_data_.index() == 1) {
+    return std::get<1>(pack_data_).size();
+  }
+  return std::get<2>(pack_data_).size;
+}
+
+std::vector<std::uint8_t> ChildData::CopyData() const {
+  return std::vector<std::uint8_t>{begin(), end()};
+}
+
+bool ChildData::is_view() const { return pack_data_.index() == 2; }
+
+void ChildData::Write(message_ostream& os) && {
+  if (pack_data_.index() != 0) {
+    // the same layout as a vector
+    os << static_cast<PackedSize>(size());
+    os.write(data(), size());
+    return;
+  }
+
+  auto& data = os.ob_.data_;
+  // reserve the max size prefix width, the real size is known only after pack
+  auto start = data.size();
+  data.resize(start + PackedSize::kMaxSize);
+  auto data_start = data.size();
+  {
+    auto packer = ApiPacker{os.ob_.packer.Context(), data};
+    std::move(*std::get<0>(pack_data_)).Pack(packer);
+  }
+  auto size = data.size() - data_start;
+
+  std::uint8_t prefix[PackedSize::kMaxSize];
+  auto prefix_size = PackedSize{size}.Encode(prefix);
+  // usually the prefix is shorter than reserved, so shift the data to it
+  if (prefix_size != PackedSize::kMaxSize) {
+    std::memmove(data.data() + start + prefix_size, data.data() + data_start,
+                 size);
+    data.resize(start + prefix_size + size);
+  }
+  std::memcpy(data.data() + start, prefix, prefix_size);
 }
 
 std::vector<std::uint8_t> ChildData::DataPackMessage(
@@ -49,4 +100,11 @@ std::vector<std::uint8_t> ChildData::DataPackMessage(
   return res;
 }
 
+ChildData::Data ChildData::TakeData() && {
+  if (is_view()) {
+    return CopyData();
+  }
+  return std::move(pack_data_);
+}
+
 }  // namespace ae
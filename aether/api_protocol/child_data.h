@@ -28,6 +28,14 @@
 #include "aether/api_protocol/packet_builder.h"
 
 namespace ae {
+/**
+ * \brief Nested api data of a message.
+ * It's a pack message to pack on send or a received data. Received child data
+ * is a view into the parent packet, it's parsed in place and copied only on
+ * the ChildData copy, move or CopyData.
+ * The view is valid only while the parent packet is parsed, a moved out
+ * ChildData owns its data, so it never dangles.
+ */
 class ChildData {
  public:
   ChildData();
@@ -43,47 +51,90 @@ class ChildData {
   ChildData(PacketBuilder&& packet_builder)
       : ChildData{std::move(packet_builder).Pack()} {}
 
-  ChildData(ChildData&& other) : pack_data_{std::move(other.pack_data_)} {}
-  ChildData(ChildData const& other) : ChildData{other.PackData()} {}
+  ChildData(ChildData&& other) : pack_data_{std::move(other).TakeData()} {}
+  ChildData(ChildData const& other) : ChildData{other.CopyData()} {}
 
   ChildData& operator=(ChildData const& other) {
     if (this != &other) {
-      pack_data_ = other.PackData();
+      pack_data_ = other.CopyData();
     }
     return *this;
   }
 
   ChildData& operator=(ChildData&& other) {
     if (this != &other) {
-      pack_data_ = std::move(other.pack_data_);
+      pack_data_ = std::move(other).TakeData();
     }
     return *this;
   }
 
   std::vector<std::uint8_t> PackData(ProtocolContext& protocol_context) &&;
-  std::vector<std::uint8_t> const& PackData() const;
+
+  // received or already packed data
+  std::uint8_t const* data() const;
+  std::size_t size() const;
+  std::uint8_t const* begin() const { return data(); }
+  std::uint8_t const* end() const { return data() + size(); }
+  std::vector<std::uint8_t> CopyData() const;
+
+  // is it a view into the parent packet
+  bool is_view() const;
 
   void clear() { pack_data_ = std::vector<std::uint8_t>{}; }
 
+  /**
+   * \brief Write child data with its size to the message stream.
+   * Pack message is packed in place right into the stream buffer and the
+   * size is placed before it after.
+   */
+  void Write(message_ostream& os) &&;
+
  private:
+  friend message_istream& operator>>(message_istream& is, ChildData& ch_d);
+
+  struct View {
+    std::uint8_t const* data;
+    std::size_t size;
+  };
+  using Data =
+      std::variant<std::unique_ptr<IPackMessage>, std::vector<std::uint8_t>,
+                   View>;
+
   static std::vector<std::uint8_t> DataPackMessage(
       ProtocolContext& protocol_context, IPackMessage&& pack_message);
 
-  std::variant<std::unique_ptr<IPackMessage>, std::vector<std::uint8_t>>
-      pack_data_;
+  // owned data is moved out, the view is copied
+  Data TakeData() &&;
+
+  Data pack_data_;
 };
 
 template <typename Ib>
 imstream<Ib>& operator>>(imstream<Ib>& is, ChildData& ch_d) {
   std::vector<std::uint8_t> data;
   is >> data;
-  ch_d = ChildData{data};
+  ch_d = ChildData{std::move(data)};
+  return is;
+}
+
+// api messages are parsed from memory, so child data refers to it
+inline message_istream& operator>>(message_istream& is, ChildData& ch_d) {
+  PackedSize packed_size{};
+  is >> packed_size;
+  auto size = static_cast<std::size_t>(packed_size);
+  auto& reader = is.ib_;
+  if ((is.result() == ReadResult::kNo) ||
+      (reader.size_ - reader.offset_ < size)) {
+    is.result(ReadResult::kNo);
+    return is;
+  }
+  ch_d.pack_data_ = ChildData::View{reader.data_ + reader.offset_, size};
+  reader.offset_ += size;
   return is;
 }
 
 inline message_ostream& operator<<(message_ostream& os, ChildData const& ch_d) {
-  os << std::move(const_cast<ChildData&>(ch_d))
-            .PackData(os.ob_.packer.Context());
+  std::move(const_cast<ChildData&>(ch_d)).Write(os);
   return os;
 }
 
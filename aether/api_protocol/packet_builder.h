@@ -19,7 +19,6 @@
 
 #include <tuple>
 #include <utility>
-#include <memory>
 #include <cstdint>
 #include <vector>
 
@@ -61,15 +60,28 @@ template <typename TApiClass, typename... TApiMessages>
 PackMessage(TApiClass&& api_class, TApiMessages&&... api_messages)
     -> PackMessage<TApiClass, std::decay_t<TApiMessages>...>;
 
+/**
+ * \brief Builds a packet of api messages.
+ * Messages are packed right away into the packet buffer, so there is no
+ * allocation per message. The buffer may be reused from a previous packet to
+ * keep its capacity.
+ */
 class PacketBuilder {
  public:
   template <typename... TPackMessages>
   explicit PacketBuilder(ProtocolContext& protocol_context,
                          TPackMessages&&... pack_messages)
       : protocol_context_{protocol_context} {
-    (pack_messages_.push_back(std::make_unique<std::decay_t<TPackMessages>>(
-         std::forward<TPackMessages>(pack_messages))),
-     ...);
+    (Push(std::forward<TPackMessages>(pack_messages)), ...);
+  }
+
+  template <typename... TPackMessages>
+  PacketBuilder(ProtocolContext& protocol_context,
+                std::vector<std::uint8_t>&& buffer,
+                TPackMessages&&... pack_messages)
+      : protocol_context_{protocol_context}, data_{std::move(buffer)} {
+    data_.clear();
+    (Push(std::forward<TPackMessages>(pack_messages)), ...);
   }
 
   template <typename TApiClass, typename... TApiMessages>
@@ -78,28 +90,20 @@ class PacketBuilder {
                      std::forward<TApiMessages>(api_messages)...});
   }
 
-  std::vector<std::uint8_t> Pack() && {
-    auto data = std::vector<std::uint8_t>{};
-
-    ApiPacker packer{protocol_context_, data};
-
-    for (auto& pack_message : pack_messages_) {
-      std::move(*pack_message).Pack(packer);
-    }
-    return data;
-  }
+  std::vector<std::uint8_t> Pack() && { return std::move(data_); }
 
   operator std::vector<std::uint8_t>() && { return std::move(*this).Pack(); }
 
  private:
   template <typename TPackMessage>
   void Push(TPackMessage&& pack_message) {
-    pack_messages_.push_back(std::make_unique<std::decay_t<TPackMessage>>(
-        std::forward<TPackMessage>(pack_message)));
+    ApiPacker packer{protocol_context_, data_};
+    std::decay_t<TPackMessage>{std::forward<TPackMessage>(pack_message)}.Pack(
+        packer);
   }
 
   ProtocolContext& protocol_context_;
-  std::vector<std::unique_ptr<IPackMessage>> pack_messages_;
+  std::vector<std::uint8_t> data_;
 };
 
 }  // namespace ae
@@ -23,46 +23,105 @@
 #include "aether/tele/tele.h"
 
 namespace ae {
-ProtocolContext::ProtocolContext() = default;
+bool ApiClassStack::Push(std::uint32_t class_id, void const* api_class) {
+  if (size_ >= entries_.size()) {
+    return false;
+  }
+  entries_[size_++] = Entry{class_id, api_class};
+  return true;
+}
+
+void ApiClassStack::Pop([[maybe_unused]] std::uint32_t class_id) {
+  assert(size_ > 0);
+  assert(entries_[size_ - 1].class_id == class_id);
+  --size_;
+}
+
+void const* ApiClassStack::Find(std::uint32_t class_id) const {
+  // the nearest api class wins
+  for (auto i = size_; i > 0; --i) {
+    if (entries_[i - 1].class_id == class_id) {
+      return entries_[i - 1].api_class;
+    }
+  }
+  return nullptr;
+}
+
+ProtocolContext::ProtocolContext()
+    : ProtocolContext{
+          AE_SEND_RESULT_SLOTS, AE_SEND_RESULT_MAX_IN_FLIGHT,
+          std::chrono::milliseconds{AE_SEND_RESULT_TIMEOUT_MS}} {}
+
+ProtocolContext::ProtocolContext(std::size_t send_result_slots,
+                                 std::size_t max_send_results,
+                                 Duration request_timeout)
+    : send_result_callbacks_{send_result_slots, max_send_results,
+                             request_timeout} {}
+
 ProtocolContext::~ProtocolContext() = default;
 
-void ProtocolContext::PushApiClass(std::uint32_t class_id,
+bool ProtocolContext::PushApiClass(std::uint32_t class_id,
                                    void const* api_class) {
-  api_class_map_[class_id] = api_class;
+  if (!api_class_stack_.Push(class_id, api_class)) {
+    AE_TELED_ERROR("Api nesting depth exceeded for class {}", class_id);
+    return false;
+  }
+  return true;
 }
 
 void ProtocolContext::PopApiClass(std::uint32_t class_id) {
-  api_class_map_.erase(class_id);
+  api_class_stack_.Pop(class_id);
 }
 
-void ProtocolContext::PushUserData(void* data) { user_data_stack_.push(data); }
+void ProtocolContext::PushUserData(void* data) {
+  user_data_stack_.push_back(data);
+}
 void ProtocolContext::PopUserData() {
   assert(!user_data_stack_.empty());
-  user_data_stack_.pop();
+  user_data_stack_.pop_back();
 }
 
 void* ProtocolContext::TopUserData() {
   if (user_data_stack_.empty()) {
     return nullptr;
   }
-  return user_data_stack_.top();
+  return user_data_stack_.back();
 }
 
 void ProtocolContext::AddSendResultCallback(
     std::uint32_t request_id, std::function<void(ApiParser& parser)> callback) {
-  send_result_callbacks_.emplace(request_id, std::move(callback));
+  AddSendResultCallback(request_id, std::move(callback), {});
+}
+
+void ProtocolContext::AddSendResultCallback(
+    std::uint32_t request_id, std::function<void(ApiParser& parser)> callback,
+    std::function<void(std::uint32_t error_code)> error_callback) {
+  send_result_callbacks_.Add(static_cast<std::uint16_t>(request_id),
+                             std::move(callback), std::move(error_callback),
+                             Now());
 }
 
 void ProtocolContext::SetSendResultResponse(std::uint32_t request_id,
                                             ApiParser& parser) {
-  auto it = send_result_callbacks_.find(request_id);
-  if (it != send_result_callbacks_.end()) {
-    it->second(parser);
-    send_result_callbacks_.erase(it);
+  send_result_callbacks_.Expire(Now());
+  auto callback =
+      send_result_callbacks_.TakeResult(static_cast<std::uint16_t>(request_id));
+  if (callback) {
+    callback(parser);
   } else {
     AE_TELED_DEBUG("No callback for request id {} cancel parse", request_id);
     parser.Cancel();
   }
 }
 
+bool ProtocolContext::SetSendResultError(std::uint32_t request_id,
+                                         std::uint32_t error_code) {
+  return send_result_callbacks_.Fail(static_cast<std::uint16_t>(request_id),
+                                     error_code);
+}
+
+TimePoint ProtocolContext::ExpireSendResults(TimePoint current_time) {
+  return send_result_callbacks_.Expire(current_time);
+}
+
 }  // namespace ae
@@ -17,40 +17,70 @@
 #ifndef AETHER_API_PROTOCOL_PROTOCOL_CONTEXT_H_
 #define AETHER_API_PROTOCOL_PROTOCOL_CONTEXT_H_
 
-#include <functional>
-#include <map>
+#include <array>
 #include <memory>
-#include <stack>
+#include <vector>
+#include <cstddef>
 #include <cstdint>
 #include <utility>
+#include <functional>
 
+#include "aether/common.h"
+#include "aether/obj/type_index.h"
 #include "aether/events/events.h"
+#include "aether/api_protocol/send_result_table.h"
 
 namespace ae {
 class ApiParser;
 
+/**
+ * \brief Api classes of the messages being parsed, from the root to the
+ * current one.
+ * Depth of nested api is small, so it's a fixed array with linear search.
+ */
+class ApiClassStack {
+ public:
+  static constexpr std::size_t kMaxDepth = 16;
+
+  /**
+   * \brief Returns false if kMaxDepth is reached, the api class is not pushed.
+   */
+  bool Push(std::uint32_t class_id, void const* api_class);
+  void Pop(std::uint32_t class_id);
+  void const* Find(std::uint32_t class_id) const;
+
+ private:
+  struct Entry {
+    std::uint32_t class_id;
+    void const* api_class;
+  };
+
+  std::array<Entry, kMaxDepth> entries_;
+  std::size_t size_{};
+};
+
+/**
+ * \brief Received message and its api context.
+ * It refers to the message, so it's valid only while the event is emitted.
+ */
 template <typename TMessage>
 class MessageEventData {
   using MessageType = TMessage;
 
  public:
-  MessageEventData(MessageType&& message,
-                   std::map<std::uint32_t, void const*> const* api_class_map,
-                   void* user_data)
-      : message_{std::move(message)},
-        api_class_map_{api_class_map},
+  MessageEventData(MessageType const& message,
+                   ApiClassStack const* api_class_stack, void* user_data)
+      : message_{message},
+        api_class_stack_{api_class_stack},
         user_data_{user_data} {}
 
   template <typename TApiClass>
   TApiClass const* GetApiClass() const {
-    if (!api_class_map_) {
-      return nullptr;
-    }
-    auto it = api_class_map_->find(TApiClass::kClassId);
-    if (it == api_class_map_->end()) {
+    if (!api_class_stack_) {
       return nullptr;
     }
-    return static_cast<TApiClass const*>(it->second);
+    return static_cast<TApiClass const*>(
+        api_class_stack_->Find(TApiClass::kClassId));
   }
 
   void* UserData() const { return user_data_; }
@@ -58,8 +88,8 @@ class MessageEventData {
   MessageType const& message() const { return message_; }
 
  private:
-  MessageType message_;
-  std::map<std::uint32_t, void const*> const* api_class_map_;
+  MessageType const& message_;
+  ApiClassStack const* api_class_stack_;
   void* user_data_;
 };
 
@@ -85,19 +115,24 @@ class MessageEvent : public IMessageEvent {
 class ProtocolContext {
  public:
   ProtocolContext();
+  ProtocolContext(std::size_t send_result_slots,
+                  std::size_t max_send_results, Duration request_timeout);
   ~ProtocolContext();
 
   template <typename TMessage, typename TCallback,
             auto MessageTypeId = std::decay_t<TMessage>::kMessageId>
   [[nodiscard]] auto OnMessage(TCallback&& cb) {
-    auto it = messages_events_.find(MessageTypeId);
-    if (it == messages_events_.end()) {
-      auto [added_it, _] = messages_events_.emplace(
-          MessageTypeId, std::make_unique<MessageEvent<TMessage>>());
-      it = added_it;
+    using MessageType = std::decay_t<TMessage>;
+
+    auto index = static_cast<std::size_t>(TypeIndex<MessageType>::get());
+    if (index >= messages_events_.size()) {
+      messages_events_.resize(index + 1);
     }
-    auto& message_event =
-        *static_cast<MessageEvent<TMessage>*>(it->second.get());
+    auto& event = messages_events_[index];
+    if (!event) {
+      event = std::make_unique<MessageEvent<MessageType>>();
+    }
+    auto& message_event = *static_cast<MessageEvent<MessageType>*>(event.get());
     return message_event.OnMessage(std::forward<TCallback>(cb));
   }
 
@@ -107,18 +142,20 @@ class ProtocolContext {
     using MessageType = std::decay_t<TMessage>;
     using MessageEventType = MessageEventData<std::decay_t<MessageType>>;
 
-    auto event_it = messages_events_.find(MessageTypeId);
-    if (event_it == messages_events_.end()) {
+    auto index = static_cast<std::size_t>(TypeIndex<MessageType>::get());
+    if ((index >= messages_events_.size()) || !messages_events_[index]) {
       return;
     }
     auto& message_event =
-        *static_cast<MessageEvent<MessageType>*>(event_it->second.get());
+        *static_cast<MessageEvent<MessageType>*>(messages_events_[index].get());
 
-    message_event.Emit(MessageEventType{std::forward<TMessage>(message),
-                                        &api_class_map_, TopUserData()});
+    // message is alive while it's handled, so it's not moved into the event
+    message_event.Emit(
+        MessageEventType{message, &api_class_stack_, TopUserData()});
   }
 
-  void PushApiClass(std::uint32_t class_id, void const* api_class);
+  // false if received data is nested too deep and must not be parsed
+  bool PushApiClass(std::uint32_t class_id, void const* api_class);
   void PopApiClass(std::uint32_t class_id);
 
   void PushUserData(void* data);
@@ -127,18 +164,33 @@ class ProtocolContext {
 
   void AddSendResultCallback(std::uint32_t request_id,
                              std::function<void(ApiParser& parser)> callback);
+  /**
+   * \brief error_callback is called with the received SendError code, or with
+   * SendResultTable::kTimeoutError if the request times out.
+   */
+  void AddSendResultCallback(
+      std::uint32_t request_id, std::function<void(ApiParser& parser)> callback,
+      std::function<void(std::uint32_t error_code)> error_callback);
 
   void SetSendResultResponse(std::uint32_t request_id, ApiParser& parser);
+  // false if the error is not handled by the request's error callback
+  bool SetSendResultError(std::uint32_t request_id, std::uint32_t error_code);
+  /**
+   * \brief Fails the requests without response in time.
+   * It's also made on each new request and response, but the owner of the
+   * context should call it from its action update to fail requests in time.
+   * \return the time of the next request expiration.
+   */
+  TimePoint ExpireSendResults(TimePoint current_time);
 
  private:
-  // map global message id to events
-  std::map<std::uint32_t, std::unique_ptr<IMessageEvent>> messages_events_;
+  // events indexed by message TypeIndex, no lookup on each message
+  std::vector<std::unique_ptr<IMessageEvent>> messages_events_;
 
-  std::stack<void*> user_data_stack_;
-  std::map<std::uint32_t, void const*> api_class_map_;
+  std::vector<void*> user_data_stack_;
+  ApiClassStack api_class_stack_;
 
-  std::map<std::uint32_t, std::function<void(ApiParser& parser)>>
-      send_result_callbacks_;
+  SendResultTable send_result_callbacks_;
 };
 }  // namespace ae
 
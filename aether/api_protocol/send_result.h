@@ -58,9 +58,7 @@ struct SendResult : public Message<SendResult> {
   template <typename T>
   SendResult(RequestId request_id, T const& t)
       : request_id{std::move(request_id)} {
-    VectorWriter<PackedSize> mbw{child_data};
-    auto os = omstream{mbw};
-    os << t;
+    AppendSerialized<PackedSize>(child_data, t);
   }
 
   // convert to T data
@@ -79,6 +77,13 @@ struct SendResult : public Message<SendResult> {
     context.AddSendResultCallback(req_id, std::forward<CbFunc>(cb));
   }
 
+  template <typename CbFunc, typename ErrorFunc>
+  static void OnResponse(ProtocolContext& context, RequestId req_id,
+                         CbFunc&& cb, ErrorFunc&& error_cb) {
+    context.AddSendResultCallback(req_id, std::forward<CbFunc>(cb),
+                                  std::forward<ErrorFunc>(error_cb));
+  }
+
   template <typename Ib>
   friend imstream<Ib>& operator>>(imstream<Ib>& is, SendResult& sr) {
     is >> sr.request_id;
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/api_protocol/send_result_table.h"
+
+#include <cassert>
+#include <utility>
+#include <algorithm>
+
+#include "aether/tele/tele.h"
+
+namespace ae {
+SendResultTable::SendResultTable(std::size_t slots, std::size_t max_slots,
+                                 Duration timeout)
+    : slots_(std::clamp(slots, std::size_t{1},
+                        std::max(max_slots, std::size_t{1}))),
+      max_slots_{std::max(max_slots, slots_.size())},
+      timeout_{timeout} {}
+
+void SendResultTable::Add(std::uint16_t request_id,
+                          ResultCallback result_callback,
+                          ErrorCallback error_callback,
+                          TimePoint current_time) {
+  Expire(current_time);
+
+  // the same request registered again replaces the previous one
+  auto* slot = &slots_[request_id % slots_.size()];
+  if (!slot->busy || (slot->request_id != request_id)) {
+    if (size_ == max_slots_) {
+      AE_TELED_ERROR("Too many requests in flight {}, request id {} failed",
+                     size_, request_id);
+      if (error_callback) {
+        error_callback(kTableFullError);
+      }
+      return;
+    }
+    slot = &FreeSlot(request_id);
+    ++size_;
+  }
+
+  auto expiration = current_time + timeout_;
+  *slot = Slot{true, request_id, expiration, std::move(result_callback),
+               std::move(error_callback)};
+  next_expiration_ = std::min(next_expiration_, expiration);
+}
+
+SendResultTable::ResultCallback SendResultTable::TakeResult(
+    std::uint16_t request_id) {
+  auto* slot = Find(request_id);
+  if (slot == nullptr) {
+    return {};
+  }
+  auto callback = std::move(slot->result_callback);
+  Release(*slot);
+  return callback;
+}
+
+bool SendResultTable::Fail(std::uint16_t request_id,
+                           std::uint32_t error_code) {
+  auto* slot = Find(request_id);
+  if (slot == nullptr) {
+    return false;
+  }
+  auto callback = Release(*slot);
+  if (!callback) {
+    return false;
+  }
+  callback(error_code);
+  return true;
+}
+
+TimePoint SendResultTable::Expire(TimePoint current_time) {
+  if (current_time < next_expiration_) {
+    return next_expiration_;
+  }
+
+  std::vector<ErrorCallback> expired;
+  next_expiration_ = TimePoint::max();
+  for (auto& slot : slots_) {
+    if (!slot.busy) {
+      continue;
+    }
+    if (slot.expiration > current_time) {
+      next_expiration_ = std::min(next_expiration_, slot.expiration);
+      continue;
+    }
+    AE_TELED_DEBUG("Request id {} expired", slot.request_id);
+    expired.emplace_back(Release(slot));
+  }
+  // callbacks may add new requests
+  for (auto& callback : expired) {
+    if (callback) {
+      callback(kTimeoutError);
+    }
+  }
+  return next_expiration_;
+}
+
+SendResultTable::Slot* SendResultTable::Find(std::uint16_t request_id) {
+  auto home = request_id % slots_.size();
+  // the request is mostly in its own slot
+  for (std::size_t i = 0; i < slots_.size(); ++i) {
+    auto& slot = slots_[(home + i) % slots_.size()];
+    if (slot.busy && (slot.request_id == request_id)) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+SendResultTable::Slot& SendResultTable::FreeSlot(std::uint16_t request_id) {
+  if (size_ == slots_.size()) {
+    Grow();
+  }
+  auto home = request_id % slots_.size();
+  for (std::size_t i = 0;; ++i) {
+    auto& slot = slots_[(home + i) % slots_.size()];
+    if (!slot.busy) {
+      return slot;
+    }
+  }
+}
+
+void SendResultTable::Grow() {
+  assert(slots_.size() < max_slots_);
+  AE_TELED_WARNING("Too many requests in flight {}, grow the table", size_);
+  auto old_slots = std::move(slots_);
+  slots_ = std::vector<Slot>(std::min(old_slots.size() * 2, max_slots_));
+  // all old slots are busy, place them by the new size
+  for (auto& slot : old_slots) {
+    FreeSlot(slot.request_id) = std::move(slot);
+  }
+}
+
+SendResultTable::ErrorCallback SendResultTable::Release(Slot& slot) {
+  assert(slot.busy);
+  auto callback = std::move(slot.error_callback);
+  slot = Slot{};
+  --size_;
+  return callback;
+}
+}  // namespace ae
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_API_PROTOCOL_SEND_RESULT_TABLE_H_
+#define AETHER_API_PROTOCOL_SEND_RESULT_TABLE_H_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "aether/common.h"
+
+namespace ae {
+class ApiParser;
+
+/**
+ * \brief Requests waiting for SendResult.
+ * A slab of slots, the request is placed to the slot indexed by its id or to
+ * the next free one. Slot keeps the whole 16 bit request id, its high bits
+ * work as the slot generation, so a late response to an expired request does
+ * not match a new one.
+ * Each request fails after timeout. If all slots are busy the slab grows up
+ * to max_slots. A new request over max_slots fails at once, a live request is
+ * never dropped to make room.
+ */
+class SendResultTable {
+ public:
+  using ResultCallback = std::function<void(ApiParser& parser)>;
+  using ErrorCallback = std::function<void(std::uint32_t error_code)>;
+
+  // error code of the request failed without any response
+  static constexpr std::uint32_t kTimeoutError = 0xFFFFFFFF;
+  // error code of the request not added because of max_slots
+  static constexpr std::uint32_t kTableFullError = 0xFFFFFFFE;
+
+  SendResultTable(std::size_t slots, std::size_t max_slots, Duration timeout);
+
+  void Add(std::uint16_t request_id, ResultCallback result_callback,
+           ErrorCallback error_callback, TimePoint current_time);
+  /**
+   * \brief Removes the request and returns its result callback, empty if the
+   * request is not found.
+   */
+  ResultCallback TakeResult(std::uint16_t request_id);
+  /**
+   * \brief Removes the request and calls its error callback.
+   * \return false if there is no such request or it has no error callback.
+   */
+  bool Fail(std::uint16_t request_id, std::uint32_t error_code);
+  /**
+   * \brief Fails all requests expired by current_time.
+   * \return the time of the next expiration.
+   */
+  TimePoint Expire(TimePoint current_time);
+
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return slots_.size(); }
+  std::size_t max_capacity() const { return max_slots_; }
+  Duration timeout() const { return timeout_; }
+
+ private:
+  struct Slot {
+    bool busy;
+    std::uint16_t request_id;
+    TimePoint expiration;
+    ResultCallback result_callback;
+    ErrorCallback error_callback;
+  };
+
+  // look up from the request's own slot
+  Slot* Find(std::uint16_t request_id);
+  Slot& FreeSlot(std::uint16_t request_id);
+  void Grow();
+  ErrorCallback Release(Slot& slot);
+
+  std::vector<Slot> slots_;
+  std::size_t max_slots_;
+  Duration timeout_;
+  std::size_t size_{};
+  TimePoint next_expiration_{TimePoint::max()};
+};
+}  // namespace ae
+
+#endif  // AETHER_API_PROTOCOL_SEND_RESULT_TABLE_H_
@@ -47,14 +47,15 @@ ClientConnectionManager::ptr const& Client::client_connection_manager() const {
 }
 
 void Client::SetConfig(Uid uid, Uid ephemeral_uid, Key master_key,
-                       Cloud::ptr cloud) {
+                       Cloud::ptr cloud, CryptoLibProfile crypto_lib_profile) {
   uid_ = uid;
   ephemeral_uid_ = ephemeral_uid;
   master_key_ = std::move(master_key);
   cloud_ = std::move(cloud);
 
   for (auto& s : cloud_->servers()) {
-    server_keys_.emplace(s->server_id, ServerKeys{s->server_id, master_key_});
+    server_keys_.emplace(s->server_id, ServerKeys{s->server_id, master_key_,
+                                                  crypto_lib_profile});
   }
 
   client_connection_manager_ = domain_->CreateObj<ClientConnectionManager>(
@@ -50,7 +50,9 @@ class Client : public Obj {
 
   Ptr<ClientConnection> client_connection();
 
-  void SetConfig(Uid uid, Uid ephemeral_uid, Key master_key, Cloud::ptr c);
+  void SetConfig(
+      Uid uid, Uid ephemeral_uid, Key master_key, Cloud::ptr c,
+      CryptoLibProfile crypto_lib_profile = kDefaultCryptoLibProfile);
 
   template <typename Dnv>
   void Visit(Dnv& dnv) {
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/client_connections/client_crypto_session.h"
+
+#include <cassert>
+#include <utility>
+
+#include "aether/client.h"
+
+#include "aether/tele/tele.h"
+
+namespace ae {
+// count of nonces reserved in the client's server state by one checkpoint
+static constexpr std::uint32_t kNonceCheckpoint = 256;
+
+ClientCryptoSession::ClientCryptoSession(Ptr<Client> const& client,
+                                         ServerId server_id)
+    : client_{client}, server_id_{server_id}, reserved_count_{} {
+  auto* server_keys = client->server_state(server_id_);
+  assert(server_keys);
+  client_to_server_ = server_keys->client_to_server();
+  server_to_client_ = server_keys->server_to_client();
+  nonce_ = server_keys->nonce();
+  Checkpoint();
+}
+
+CryptoNonce const& ClientCryptoSession::NextNonce() {
+  if (reserved_count_ == 0) {
+    Checkpoint();
+  }
+  --reserved_count_;
+  nonce_.Next();
+  return nonce_;
+}
+
+void ClientCryptoSession::Checkpoint() {
+  reserved_count_ = kNonceCheckpoint;
+
+  auto client_ptr = client_.Lock();
+  if (!client_ptr) {
+    AE_TELED_WARNING("Client is gone, nonce checkpoint is skipped");
+    return;
+  }
+  auto* server_keys = client_ptr->server_state(server_id_);
+  assert(server_keys);
+  auto reserved = nonce_;
+  for (std::uint32_t i = 0; i < kNonceCheckpoint; ++i) {
+    reserved.Next();
+  }
+  server_keys->set_nonce(reserved);
+}
+
+SessionEncryptKeyProvider::SessionEncryptKeyProvider(
+    Ptr<ClientCryptoSession> session)
+    : session_{std::move(session)} {}
+
+Key SessionEncryptKeyProvider::GetKey() const {
+  return session_->client_to_server();
+}
+
+CryptoNonce const& SessionEncryptKeyProvider::Nonce() const {
+  return session_->NextNonce();
+}
+
+SessionDecryptKeyProvider::SessionDecryptKeyProvider(
+    Ptr<ClientCryptoSession> session)
+    : session_{std::move(session)} {}
+
+Key SessionDecryptKeyProvider::GetKey() const {
+  return session_->server_to_client();
+}
+
+CryptoNonce const& SessionDecryptKeyProvider::Nonce() const {
+  return session_->NextNonce();
+}
+}  // namespace ae
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_CLIENT_CONNECTIONS_CLIENT_CRYPTO_SESSION_H_
+#define AETHER_CLIENT_CONNECTIONS_CLIENT_CRYPTO_SESSION_H_
+
+#include <cstdint>
+
+#include "aether/common.h"
+#include "aether/obj/ptr.h"
+#include "aether/obj/ptr_view.h"
+#include "aether/crypto/key.h"
+#include "aether/crypto/crypto_nonce.h"
+#include "aether/crypto/ikey_provider.h"
+
+namespace ae {
+class Client;
+
+/**
+ * \brief Key material of the stream between client and server.
+ * Keys are copied from the client's server state once and the nonce is counted
+ * locally, so encryption of a packet does not touch the client. Each checkpoint
+ * moves the server state nonce ahead of all nonces the session may use before
+ * the next one, so a restored client does not reuse them.
+ */
+class ClientCryptoSession {
+ public:
+  ClientCryptoSession(Ptr<Client> const& client, ServerId server_id);
+
+  Key const& client_to_server() const { return client_to_server_; }
+  Key const& server_to_client() const { return server_to_client_; }
+  CryptoNonce const& NextNonce();
+
+ private:
+  void Checkpoint();
+
+  PtrView<Client> client_;
+  ServerId server_id_;
+  Key client_to_server_;
+  Key server_to_client_;
+  CryptoNonce nonce_;
+  std::uint32_t reserved_count_;  //< nonces left before the next checkpoint
+};
+
+class SessionEncryptKeyProvider : public ISyncKeyProvider {
+ public:
+  explicit SessionEncryptKeyProvider(Ptr<ClientCryptoSession> session);
+
+  Key GetKey() const override;
+  CryptoNonce const& Nonce() const override;
+
+ private:
+  Ptr<ClientCryptoSession> session_;
+};
+
+class SessionDecryptKeyProvider : public ISyncKeyProvider {
+ public:
+  explicit SessionDecryptKeyProvider(Ptr<ClientCryptoSession> session);
+
+  Key GetKey() const override;
+  CryptoNonce const& Nonce() const override;
+
+ private:
+  Ptr<ClientCryptoSession> session_;
+};
+}  // namespace ae
+
+#endif  // AETHER_CLIENT_CONNECTIONS_CLIENT_CRYPTO_SESSION_H_
@@ -20,7 +20,6 @@
 
 #include "aether/client.h"
 
-#include "aether/crypto/ikey_provider.h"
 #include "aether/crypto/sync_crypto_provider.h"
 
 #include "aether/stream_api/debug_gate.h"
@@ -37,55 +36,6 @@
 #include "aether/tele/tele.h"
 
 namespace ae {
-namespace _internal {
-class ClientKeyProvider : public ISyncKeyProvider {
- public:
-  explicit ClientKeyProvider(Ptr<Client> const& client, ServerId server_id)
-      : client_{client}, server_id_{server_id} {}
-
-  CryptoNonce const& Nonce() const override {
-    auto client_ptr = client_.Lock();
-    assert(client_ptr);
-    auto* server_key = client_ptr->server_state(server_id_);
-    assert(server_key);
-    server_key->Next();
-    return server_key->nonce();
-  }
-
- protected:
-  PtrView<Client> client_;
-  ServerId server_id_;
-};
-
-class ClientEncryptKeyProvider : public ClientKeyProvider {
- public:
-  using ClientKeyProvider::ClientKeyProvider;
-
-  Key GetKey() const override {
-    auto client_ptr = client_.Lock();
-    assert(client_ptr);
-    auto const* server_key = client_ptr->server_state(server_id_);
-    assert(server_key);
-
-    return server_key->client_to_server();
-  }
-};
-
-class ClientDecryptKeyProvider : public ClientKeyProvider {
- public:
-  using ClientKeyProvider::ClientKeyProvider;
-
-  Key GetKey() const override {
-    auto client_ptr = client_.Lock();
-    assert(client_ptr);
-    auto const* server_key = client_ptr->server_state(server_id_);
-    assert(server_key);
-
-    return server_key->server_to_client();
-  }
-};
-}  // namespace _internal
-
 ClientToServerStream::ClientToServerStream(ActionContext action_context,
                                            Ptr<Client> client,
                                            ServerId server_id,
@@ -93,7 +43,8 @@ ClientToServerStream::ClientToServerStream(ActionContext action_context,
     : action_context_{action_context},
       client_{std::move(client)},
       server_id_{server_id},
-      server_transport_{std::move(server_transport)} {
+      server_transport_{std::move(server_transport)},
+      crypto_session_{MakePtr<ClientCryptoSession>(client_, server_id_)} {
   AE_TELED_DEBUG("Create ClientToServerStreamGate");
   connection_success_subscription_ =
       server_transport_->ConnectionSuccess().Subscribe(
@@ -152,11 +103,9 @@ void ClientToServerStream::InitStreams() {
               "ClientToServerStreamGate server id {} client_uid {} \nread {}",
               server_id_, client_->uid())},
       CryptoGate{MakePtr<SyncEncryptProvider>(
-                     MakePtr<_internal::ClientEncryptKeyProvider>(client_,
-                                                                  server_id_)),
+                     MakePtr<SessionEncryptKeyProvider>(crypto_session_)),
                  MakePtr<SyncDecryptProvider>(
-                     MakePtr<_internal::ClientDecryptKeyProvider>(client_,
-                                                                  server_id_))},
+                     MakePtr<SessionDecryptKeyProvider>(crypto_session_))},
       StreamApiGate{protocol_context_, stream_id},
       // start streams with login by uid
       ProtocolWriteGate{protocol_context_, LoginApi{},
@@ -35,6 +35,8 @@
 
 #include "aether/methods/client_api/client_safe_api.h"
 
+#include "aether/client_connections/client_crypto_session.h"
+
 namespace ae {
 class Client;
 
@@ -62,6 +64,8 @@ class ClientToServerStream : public ByteStream {
   Ptr<Client> client_;
   ServerId server_id_;
   Ptr<ITransport> server_transport_;
+  // key material and nonce counter shared by the crypto gate
+  Ptr<ClientCryptoSession> crypto_session_;
 
   ProtocolContext protocol_context_;
 
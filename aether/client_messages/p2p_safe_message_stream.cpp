@@ -21,14 +21,35 @@
 namespace ae {
 P2pSafeStream::P2pSafeStream(ActionContext action_context,
                              SafeStreamConfig const& config,
-                             Ptr<P2pStream> base_stream)
-    : sized_packet_gate_{},
+                             Ptr<P2pStream> base_stream,
+                             std::optional<FecConfig> fec_config)
+    : compact_framing_{config.compact_framing},
+      sized_packet_gate_{},
       safe_stream_{action_context, config},
       base_stream_{std::move(base_stream)} {
-  Tie(sized_packet_gate_, safe_stream_, *base_stream_);
+  if (fec_config) {
+    fec_gate_.emplace(action_context, *fec_config);
+    if (compact_framing_) {
+      Tie(safe_stream_, *fec_gate_, *base_stream_);
+    } else {
+      Tie(sized_packet_gate_, safe_stream_, *fec_gate_, *base_stream_);
+    }
+    return;
+  }
+
+  if (compact_framing_) {
+    Tie(safe_stream_, *base_stream_);
+  } else {
+    Tie(sized_packet_gate_, safe_stream_, *base_stream_);
+  }
 }
 
-P2pSafeStream::InGate& P2pSafeStream::in() { return sized_packet_gate_; }
+P2pSafeStream::InGate& P2pSafeStream::in() {
+  if (compact_framing_) {
+    return safe_stream_.in();
+  }
+  return sized_packet_gate_;
+}
 
 void P2pSafeStream::LinkOut(OutGate& /* out */) { assert(false); }
 
@@ -17,11 +17,14 @@
 #ifndef AETHER_CLIENT_MESSAGES_P2P_SAFE_MESSAGE_STREAM_H_
 #define AETHER_CLIENT_MESSAGES_P2P_SAFE_MESSAGE_STREAM_H_
 
+#include <optional>
+
 #include "aether/common.h"
 #include "aether/obj/ptr.h"
 #include "aether/actions/action_context.h"
 
 #include "aether/stream_api/istream.h"
+#include "aether/stream_api/fec_gate.h"
 #include "aether/stream_api/safe_stream.h"
 #include "aether/stream_api/sized_packet_stream.h"
 #include "aether/stream_api/safe_stream/safe_stream_types.h"
@@ -30,10 +33,20 @@
 
 namespace ae {
 
+/**
+ * \brief Reliable message stream to other client.
+ * With compact_framing in config the SafeStream carries message boundaries in
+ * its chunks, so no extra size prefix is added to each message. Both sides
+ * must use the same framing.
+ * With fec_config the SafeStream packets are protected by FecGate, so a lost
+ * packet may be restored without waiting for the repeat. Both sides must use
+ * the same fec config.
+ */
 class P2pSafeStream final : public ByteStream {
  public:
   P2pSafeStream(ActionContext action_context, SafeStreamConfig const& config,
-                Ptr<P2pStream> base_stream);
+                Ptr<P2pStream> base_stream,
+                std::optional<FecConfig> fec_config = {});
 
   AE_CLASS_NO_COPY_MOVE(P2pSafeStream)
 
@@ -41,8 +54,10 @@ class P2pSafeStream final : public ByteStream {
   void LinkOut(OutGate& out) override;
 
  private:
+  bool compact_framing_;
   SizedPacketGate sized_packet_gate_;
   SafeStream safe_stream_;
+  std::optional<FecGate> fec_gate_;
   Ptr<P2pStream> base_stream_;
 };
 
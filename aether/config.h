@@ -127,6 +127,14 @@
 #  define AE_CRYPTO_SYNC AE_CHACHA20_POLY1305
 #endif  // AE_CRYPTO_SYNC
 
+// Offer AES-256-GCM secret key cryptography to the server.
+// Used with AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305 only if the CPU has AES
+// instructions, ChaCha20-Poly1305 is used otherwise. The server must support
+// CryptoLibProfile::kSodiumAesGcmLib.
+#ifndef AE_CRYPTO_SYNC_AES_GCM
+#  define AE_CRYPTO_SYNC_AES_GCM 0
+#endif  // AE_CRYPTO_SYNC_AES_GCM
+
 // Key derivation function
 #ifndef AE_KDF
 #  define AE_KDF AE_SODIUM_KDF
@@ -137,6 +145,38 @@
 #  define AE_CRYPTO_HASH AE_BLAKE2B
 #endif  // AE_CRYPTO_HASH
 
+// SafeStream offset space.
+// AE_SAFE_STREAM_OFFSET_16 limits the sending window to less than 32KB.
+// AE_SAFE_STREAM_OFFSET_32 allows windows of megabytes for links with high
+// bandwidth-delay product. Both sides of the stream must use the same value.
+#ifndef AE_SAFE_STREAM_OFFSET
+#  define AE_SAFE_STREAM_OFFSET AE_SAFE_STREAM_OFFSET_16
+#endif  // AE_SAFE_STREAM_OFFSET
+
+// Bytes of free data buffers kept for reuse by each thread, 0 disables
+// pooling. See DataBufferPool.
+#ifndef AE_DATA_BUFFER_POOL_SIZE
+#  define AE_DATA_BUFFER_POOL_SIZE (64 * 1024)
+#endif  // AE_DATA_BUFFER_POOL_SIZE
+
+// Initial slots for requests waiting for SendResult in a protocol context. If
+// more requests are in flight the table grows up to
+// AE_SEND_RESULT_MAX_IN_FLIGHT.
+#ifndef AE_SEND_RESULT_SLOTS
+#  define AE_SEND_RESULT_SLOTS 32
+#endif  // AE_SEND_RESULT_SLOTS
+
+// Max requests waiting for SendResult in a protocol context. A new request
+// over the limit fails at once, live requests are never dropped.
+#ifndef AE_SEND_RESULT_MAX_IN_FLIGHT
+#  define AE_SEND_RESULT_MAX_IN_FLIGHT 256
+#endif  // AE_SEND_RESULT_MAX_IN_FLIGHT
+
+// Time in milliseconds to wait for SendResult before the request fails.
+#ifndef AE_SEND_RESULT_TIMEOUT_MS
+#  define AE_SEND_RESULT_TIMEOUT_MS 30000
+#endif  // AE_SEND_RESULT_TIMEOUT_MS
+
 #ifndef AE_TARGET_ENDIANNESS
 #  define AE_TARGET_ENDIANNESS AE_LITTLE_ENDIAN
 #endif  // AE_TARGET_ENDIANNESS
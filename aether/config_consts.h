@@ -42,6 +42,10 @@
 #define AE_BLAKE2B 1
 #define AE_HYDRO_HASH 2
 
+// AE_SAFE_STREAM_OFFSET, SafeStream offset space
+#define AE_SAFE_STREAM_OFFSET_16 1
+#define AE_SAFE_STREAM_OFFSET_32 2
+
 #define AE_LITTLE_ENDIAN 1
 #define AE_BIG_ENDIAN 2
 
@@ -86,6 +86,10 @@ AsyncEncryptProvider::AsyncEncryptProvider(
 DataBuffer AsyncEncryptProvider::Encrypt(DataBuffer const& data) {
   return impl_->Encrypt(data);
 }
+
+void AsyncEncryptProvider::EncryptInPlace(DataBuffer& data) {
+  impl_->EncryptInPlace(data);
+}
 std::size_t AsyncEncryptProvider::EncryptOverhead() const {
   return impl_->EncryptOverhead();
 }
@@ -107,4 +111,9 @@ DataBuffer AsyncDecryptProvider::Decrypt(DataBuffer const& data) {
   return impl_->Decrypt(data);
 }
 
+bool AsyncDecryptProvider::DecryptInto(DataBuffer const& data,
+                                       DataBuffer& decrypted) {
+  return impl_->DecryptInto(data, decrypted);
+}
+
 }  // namespace ae
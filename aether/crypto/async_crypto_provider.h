@@ -28,6 +28,7 @@ class AsyncEncryptProvider : public IEncryptProvider {
   explicit AsyncEncryptProvider(Ptr<IAsyncKeyProvider> key_provider);
 
   DataBuffer Encrypt(DataBuffer const& data) override;
+  void EncryptInPlace(DataBuffer& data) override;
   std::size_t EncryptOverhead() const override;
 
  private:
@@ -38,6 +39,7 @@ class AsyncDecryptProvider : public IDecryptProvider {
  public:
   explicit AsyncDecryptProvider(Ptr<IAsyncKeyProvider> key_provider);
   DataBuffer Decrypt(DataBuffer const& data) override;
+  bool DecryptInto(DataBuffer const& data, DataBuffer& decrypted) override;
 
  private:
   Ptr<IDecryptProvider> impl_;
@@ -35,8 +35,9 @@
 namespace ae {
 // Cryptographic profiles
 enum class CryptoLibProfile : std::uint8_t {
-  kSodiumLib = 0,  // use sodium library only
-  kHydrogenLib,    // use hydrogen library only
+  kSodiumLib = 0,    // use sodium library only
+  kHydrogenLib,      // use hydrogen library only
+  kSodiumAesGcmLib,  // use sodium library with AES-256-GCM secret key crypto
   // TODO: add different ASYNC/SYNC combinations
 };
 
@@ -25,7 +25,7 @@ namespace ae {
 void CryptoNonceChacha20Poly1305::Next() {
   static_assert(kNonceSize >= sizeof(std::uint64_t));
   auto& v = *reinterpret_cast<std::uint64_t*>(this->data());
-  v = +1;
+  ++v;
 }
 void CryptoNonceChacha20Poly1305::Init() {
   randombytes_buf(this->data(), this->size());
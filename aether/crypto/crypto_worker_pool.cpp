@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/crypto/crypto_worker_pool.h"
+
+#include <cassert>
+#include <utility>
+
+namespace ae {
+CryptoWorkerPool::CryptoWorkerPool(std::size_t workers_count) {
+  assert(workers_count > 0);
+  workers_.reserve(workers_count);
+  for (std::size_t i = 0; i < workers_count; ++i) {
+    workers_.emplace_back([this]() { Work(); });
+  }
+}
+
+CryptoWorkerPool::~CryptoWorkerPool() {
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void CryptoWorkerPool::Post(Job job) {
+  {
+    std::lock_guard lock(mutex_);
+    jobs_.emplace_back(std::move(job));
+  }
+  condition_.notify_one();
+}
+
+std::size_t CryptoWorkerPool::workers_count() const { return workers_.size(); }
+
+void CryptoWorkerPool::Work() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+      if (stop_) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
+}  // namespace ae
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_CRYPTO_CRYPTO_WORKER_POOL_H_
+#define AETHER_CRYPTO_CRYPTO_WORKER_POOL_H_
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+#include "aether/common.h"
+
+namespace ae {
+/**
+ * \brief Fixed set of threads to run crypto jobs off the action thread.
+ * Jobs are started in the order they are posted, but may finish in any order.
+ * Jobs left in the queue on destruction are dropped.
+ */
+class CryptoWorkerPool {
+ public:
+  using Job = std::function<void()>;
+
+  explicit CryptoWorkerPool(std::size_t workers_count);
+  ~CryptoWorkerPool();
+
+  AE_CLASS_NO_COPY_MOVE(CryptoWorkerPool)
+
+  void Post(Job job);
+
+  std::size_t workers_count() const;
+
+ private:
+  void Work();
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<Job> jobs_;
+  bool stop_{false};
+  std::vector<std::thread> workers_;
+};
+}  // namespace ae
+
+#endif  // AETHER_CRYPTO_CRYPTO_WORKER_POOL_H_
@@ -72,6 +72,15 @@ std::size_t HydroSyncEncryptProvider::EncryptOverhead() const {
   return hydro_secretbox_HEADERBYTES;
 }
 
+IEncryptProvider::DetachedEncrypt HydroSyncEncryptProvider::Detach() {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kHydrogenSecretBox);
+
+  return [secret_key{key.Get<HydrogenSecretBoxKey>()}](DataBuffer& data) {
+    data = _internal::EncryptWithSymmetric(secret_key, data);
+  };
+}
+
 HydroSyncDecryptProvider::HydroSyncDecryptProvider(
     Ptr<ISyncKeyProvider> key_provider)
     : key_provider_{std::move(key_provider)} {}
@@ -83,6 +92,17 @@ DataBuffer HydroSyncDecryptProvider::Decrypt(DataBuffer const& data) {
   return _internal::DecryptWithSymmetric(key.Get<HydrogenSecretBoxKey>(), data);
 }
 
+IDecryptProvider::DetachedDecrypt HydroSyncDecryptProvider::Detach() {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kHydrogenSecretBox);
+
+  return [secret_key{key.Get<HydrogenSecretBoxKey>()}](DataBuffer const& data,
+                                                       DataBuffer& decrypted) {
+    decrypted = _internal::DecryptWithSymmetric(secret_key, data);
+    return true;
+  };
+}
+
 }  // namespace ae
 
 #endif
@@ -33,6 +33,7 @@ class HydroSyncEncryptProvider : public IEncryptProvider {
 
   DataBuffer Encrypt(DataBuffer const& data) override;
   std::size_t EncryptOverhead() const override;
+  DetachedEncrypt Detach() override;
 
  private:
   Ptr<ISyncKeyProvider> key_provider_;
@@ -43,6 +44,7 @@ class HydroSyncDecryptProvider : public IDecryptProvider {
   explicit HydroSyncDecryptProvider(Ptr<ISyncKeyProvider> key_provider);
 
   DataBuffer Decrypt(DataBuffer const& data) override;
+  DetachedDecrypt Detach() override;
 
  private:
   Ptr<ISyncKeyProvider> key_provider_;
@@ -17,28 +17,64 @@
 #ifndef AETHER_CRYPTO_ICRYPTO_PROVIDER_H_
 #define AETHER_CRYPTO_ICRYPTO_PROVIDER_H_
 
+#include <functional>
+
 #include "aether/transport/data_buffer.h"
 
 namespace ae {
 class IEncryptProvider {
  public:
+  using DetachedEncrypt = std::function<void(DataBuffer& data)>;
+
   virtual ~IEncryptProvider() = default;
 
   /**
    * \brief Encrypts the data.
    */
   virtual DataBuffer Encrypt(DataBuffer const& data) = 0;
+  /**
+   * \brief Encrypts the data in place.
+   * The data grows by EncryptOverhead bytes, reserve that capacity to encrypt
+   * without reallocation.
+   */
+  virtual void EncryptInPlace(DataBuffer& data) { data = Encrypt(data); }
   virtual std::size_t EncryptOverhead() const = 0;
+  /**
+   * \brief Takes the key and the nonce for the next packet now.
+   * Returned function encrypts in place as EncryptInPlace and is safe to call
+   * from another thread. Empty if the provider can't be detached.
+   */
+  virtual DetachedEncrypt Detach() { return {}; }
 };
 
 class IDecryptProvider {
  public:
+  using DetachedDecrypt =
+      std::function<bool(DataBuffer const& data, DataBuffer& decrypted)>;
+
   virtual ~IDecryptProvider() = default;
 
   /**
    * \brief Decrypts the data.
+   * Returns an empty buffer if the data is not authenticated.
    */
   virtual DataBuffer Decrypt(DataBuffer const& data) = 0;
+  /**
+   * \brief Decrypts the data into decrypted.
+   * The decrypted buffer is resized to the data size, so a buffer reused
+   * between calls keeps its capacity.
+   * Returns false if the data is not authenticated, the packet must be dropped.
+   */
+  virtual bool DecryptInto(DataBuffer const& data, DataBuffer& decrypted) {
+    decrypted = Decrypt(data);
+    return true;
+  }
+  /**
+   * \brief Takes the key now.
+   * Returned function decrypts as DecryptInto and is safe to call from another
+   * thread. Empty if the provider can't be detached.
+   */
+  virtual DetachedDecrypt Detach() { return {}; }
 };
 }  // namespace ae
 
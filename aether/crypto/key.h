@@ -38,6 +38,8 @@
 #  if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
 #    include "third_party/libsodium/src/libsodium/include/sodium/\
 crypto_aead_chacha20poly1305.h"  //"
+#    include "third_party/libsodium/src/libsodium/include/sodium/\
+crypto_aead_aes256gcm.h"  //"
 #  endif
 
 #  if AE_CRYPTO_SYNC == AE_HYDRO_CRYPTO_SK ||  \
@@ -61,6 +63,7 @@ enum class CryptoKeyType : std::uint8_t {
   kHydrogenCurvePublic,
   kHydrogenCurveSecret,
   kHydrogenSecretBox,
+  kSodiumAesGcm,
 };
 
 #  if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
@@ -90,6 +93,14 @@ struct SodiumChachaKey {
   }
   std::array<std::uint8_t, crypto_aead_chacha20poly1305_KEYBYTES> key;
 };
+
+struct SodiumAesGcmKey {
+  template <typename T>
+  void Serializator(T& s) {
+    s & key;
+  }
+  std::array<std::uint8_t, crypto_aead_aes256gcm_KEYBYTES> key;
+};
 #  endif
 
 #  if AE_SIGNATURE == AE_ED25519
@@ -171,7 +182,7 @@ class Key : public VariantType<CryptoKeyType,
 #  endif
 #  if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
 
-                               SodiumChachaKey,
+                               SodiumChachaKey, SodiumAesGcmKey,
 #  endif
 #  if AE_SIGNATURE == AE_ED25519
 
@@ -194,9 +205,9 @@ class Key : public VariantType<CryptoKeyType,
   static constexpr std::size_t kChachaOffset =
       kSodiumCurveOffset + ((AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL) ? 2 : 0);
   static constexpr std::size_t kSodiumSignOffset =
-      kChachaOffset + ((AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305) ? 1 : 0);
+      kChachaOffset + ((AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305) ? 2 : 0);
   static constexpr std::size_t kHydrogenSignOffset =
-      kChachaOffset + ((AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305) ? 1 : 0);
+      kChachaOffset + ((AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305) ? 2 : 0);
   static constexpr std::size_t kHydrogenCurveOffset =
       kHydrogenSignOffset + ((AE_SIGNATURE != AE_NONE) ? 2 : 0);
   static constexpr std::size_t kHydrogenSecretBoxOffset =
@@ -220,6 +231,8 @@ class Key : public VariantType<CryptoKeyType,
         return kChachaOffset + static_cast<std::size_t>(index) -
                static_cast<std::size_t>(CryptoKeyType::kSodiumChacha);
       }
+      case CryptoKeyType::kSodiumAesGcm:
+        return kChachaOffset + 1;
 #  endif
 #  if AE_SIGNATURE == AE_ED25519
       case CryptoKeyType::kSodiumSignPublic:
@@ -266,6 +279,9 @@ class Key : public VariantType<CryptoKeyType,
     if (order == kChachaOffset) {
       return CryptoKeyType::kSodiumChacha;
     }
+    if (order == kChachaOffset + 1) {
+      return CryptoKeyType::kSodiumAesGcm;
+    }
 #  endif
 #  if AE_SIGNATURE == AE_ED25519
     if (order < kSodiumSignOffset + 2) {
@@ -26,6 +26,7 @@
 #if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
 #  include "third_party/libsodium/src/libsodium/include/sodium/\
 crypto_aead_chacha20poly1305.h"  //"
+#  include "aether/crypto/sodium/sodium_aes_gcm_crypto_provider.h"
 #endif
 
 #if AE_KDF == AE_SODIUM_KDF
@@ -39,11 +40,37 @@ crypto_aead_chacha20poly1305.h"  //"
 
 namespace ae {
 
-bool CryptoSyncKeygen(Key& secret_key) {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+namespace _internal {
+// both ciphers use 32 byte keys, so the same key bytes fit either of them
+inline Key SodiumSyncKey(SodiumChachaKey const& key,
+                         CryptoLibProfile profile) {
+  static_assert(sizeof(SodiumAesGcmKey::key) == sizeof(SodiumChachaKey::key));
+  if (profile == CryptoLibProfile::kSodiumAesGcmLib) {
+    SodiumAesGcmKey aes_key;
+    std::copy(std::begin(key.key), std::end(key.key), std::begin(aes_key.key));
+    return aes_key;
+  }
+  return key;
+}
+}  // namespace _internal
+#endif
+
+CryptoLibProfile SelectCryptoLibProfile() {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305 && AE_CRYPTO_SYNC_AES_GCM
+  if (SodiumAesGcmAvailable()) {
+    return CryptoLibProfile::kSodiumAesGcmLib;
+  }
+#endif
+  return kDefaultCryptoLibProfile;
+}
+
+bool CryptoSyncKeygen(Key& secret_key,
+                      [[maybe_unused]] CryptoLibProfile profile) {
 #if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
   SodiumChachaKey key;
   crypto_aead_chacha20poly1305_keygen(key.key.data());
-  secret_key = std::move(key);
+  secret_key = _internal::SodiumSyncKey(key, profile);
 #elif AE_CRYPTO_SYNC == AE_HYDRO_CRYPTO_SK
   HydrogenSecretBoxKey key;
   hydro_secretbox_keygen(key.key.data());
@@ -54,7 +81,8 @@ bool CryptoSyncKeygen(Key& secret_key) {
 
 bool CryptoSyncKeyDerive(Key const& master_key, std::uint32_t server_id,
                          std::uint32_t key_number, Key& client_to_server_key,
-                         Key& server_to_client_key) {
+                         Key& server_to_client_key,
+                         [[maybe_unused]] CryptoLibProfile profile) {
   std::uint64_t const subkey_id =
       (static_cast<std::uint64_t>(server_id) << 32) | key_number;
 
@@ -79,8 +107,10 @@ bool CryptoSyncKeyDerive(Key const& master_key, std::uint32_t server_id,
   std::copy(std::begin(derived_key) + client_to_server_key_chacha.key.size(),
             std::end(derived_key), std::begin(server_to_client_key_chacha.key));
 
-  client_to_server_key = std::move(client_to_server_key_chacha);
-  server_to_client_key = std::move(server_to_client_key_chacha);
+  client_to_server_key =
+      _internal::SodiumSyncKey(client_to_server_key_chacha, profile);
+  server_to_client_key =
+      _internal::SodiumSyncKey(server_to_client_key_chacha, profile);
 #endif
 #if AE_CRYPTO_SYNC == AE_HYDRO_CRYPTO_SK && AE_KDF == AE_HYDRO_KDF
   static_assert(sizeof(HYDRO_KDF_CONTEXT) - 1 == hydro_kdf_CONTEXTBYTES,
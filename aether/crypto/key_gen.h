@@ -20,14 +20,20 @@
 #include <cstdint>
 
 #include "aether/crypto/key.h"
+#include "aether/crypto/crypto_definitions.h"
 
 namespace ae {
+// Crypto profile to offer to the server, checks CPU support at runtime
+CryptoLibProfile SelectCryptoLibProfile();
+
 // Secret key generation
-bool CryptoSyncKeygen(Key& secret_key);
+bool CryptoSyncKeygen(Key& secret_key,
+                      CryptoLibProfile profile = kDefaultCryptoLibProfile);
 
 bool CryptoSyncKeyDerive(Key const& master_key, std::uint32_t server_id,
                          std::uint32_t key_number, Key& client_to_server_key,
-                         Key& server_to_client_key);
+                         Key& server_to_client_key,
+                         CryptoLibProfile profile = kDefaultCryptoLibProfile);
 }  // namespace ae
 
 #endif  // AETHER_CRYPTO_KEY_GEN_H_
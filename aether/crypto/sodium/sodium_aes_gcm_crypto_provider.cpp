@@ -0,0 +1,169 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/crypto/sodium/sodium_aes_gcm_crypto_provider.h"
+
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+
+#  include <array>
+#  include <cassert>
+#  include <utility>
+#  include <algorithm>
+
+#  include "third_party/libsodium/src/libsodium/include/sodium/core.h"
+#  include "third_party/libsodium/src/libsodium/include/sodium/\
+crypto_aead_aes256gcm.h"  //"
+
+#  include "aether/crypto/key.h"
+#  include "aether/crypto/crypto_nonce.h"
+
+#  include "aether/tele/tele.h"
+
+namespace ae {
+
+namespace _internal {
+using AesGcmNonce = std::array<std::uint8_t, crypto_aead_aes256gcm_NPUBBYTES>;
+static_assert(kNonceSize <= crypto_aead_aes256gcm_NPUBBYTES);
+
+inline AesGcmNonce ExtendNonce(std::uint8_t const* nonce) {
+  auto aes_nonce = AesGcmNonce{};
+  std::copy(nonce, nonce + kNonceSize, std::begin(aes_nonce));
+  return aes_nonce;
+}
+
+// same layout as for ChaCha20-Poly1305: ciphertext, mac and short nonce
+inline void EncryptWithAesGcm(SodiumAesGcmKey const& secret_key,
+                              CryptoNonce const& nonce, DataBuffer& data) {
+  auto data_size = data.size();
+  data.resize(data_size + crypto_aead_aes256gcm_ABYTES + nonce.size());
+  auto* mac = data.data() + data_size;
+
+  auto aes_nonce = ExtendNonce(nonce.data());
+  auto r = crypto_aead_aes256gcm_encrypt_detached(
+      data.data(), mac, nullptr, data.data(), data_size, nullptr, 0, nullptr,
+      aes_nonce.data(), secret_key.key.data());
+  if (r != 0) {
+    // never send not encrypted data
+    AE_TELED_ERROR("AES-256-GCM encryption failed");
+    data.clear();
+    return;
+  }
+
+  std::copy(std::begin(nonce), std::end(nonce),
+            mac + crypto_aead_aes256gcm_ABYTES);
+}
+
+inline bool DecryptWithAesGcm(SodiumAesGcmKey const& secret_key,
+                              DataBuffer const& encrypted_data,
+                              DataBuffer& decrypted_data) {
+  if (encrypted_data.size() < (crypto_aead_aes256gcm_ABYTES + kNonceSize)) {
+    return false;
+  }
+
+  auto data_size =
+      encrypted_data.size() - kNonceSize - crypto_aead_aes256gcm_ABYTES;
+  auto const* mac = encrypted_data.data() + data_size;
+  auto aes_nonce = ExtendNonce(mac + crypto_aead_aes256gcm_ABYTES);
+
+  // decrypted may be the same buffer, it is only shrunk before decrypt
+  decrypted_data.resize(data_size);
+
+  auto r = crypto_aead_aes256gcm_decrypt_detached(
+      decrypted_data.data(), nullptr, encrypted_data.data(), data_size, mac,
+      nullptr, 0, aes_nonce.data(), secret_key.key.data());
+  return r == 0;
+}
+}  // namespace _internal
+
+bool SodiumAesGcmAvailable() {
+  // cpu features are detected by sodium_init, it is safe to call it again
+  static bool const available =
+      (sodium_init() >= 0) && (crypto_aead_aes256gcm_is_available() != 0);
+  return available;
+}
+
+SodiumAesGcmEncryptProvider::SodiumAesGcmEncryptProvider(
+    Ptr<ISyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {
+  assert(SodiumAesGcmAvailable());
+}
+
+DataBuffer SodiumAesGcmEncryptProvider::Encrypt(DataBuffer const& data) {
+  auto ciphertext = DataBuffer{};
+  ciphertext.reserve(data.size() + EncryptOverhead());
+  ciphertext.assign(std::begin(data), std::end(data));
+  EncryptInPlace(ciphertext);
+  return ciphertext;
+}
+
+void SodiumAesGcmEncryptProvider::EncryptInPlace(DataBuffer& data) {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumAesGcm);
+
+  _internal::EncryptWithAesGcm(key.Get<SodiumAesGcmKey>(),
+                               key_provider_->Nonce(), data);
+}
+
+std::size_t SodiumAesGcmEncryptProvider::EncryptOverhead() const {
+  return crypto_aead_aes256gcm_ABYTES + kNonceSize;
+}
+
+IEncryptProvider::DetachedEncrypt SodiumAesGcmEncryptProvider::Detach() {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumAesGcm);
+
+  return [secret_key{key.Get<SodiumAesGcmKey>()},
+          nonce{key_provider_->Nonce()}](DataBuffer& data) {
+    _internal::EncryptWithAesGcm(secret_key, nonce, data);
+  };
+}
+
+SodiumAesGcmDecryptProvider::SodiumAesGcmDecryptProvider(
+    Ptr<ISyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {
+  assert(SodiumAesGcmAvailable());
+}
+
+DataBuffer SodiumAesGcmDecryptProvider::Decrypt(DataBuffer const& data) {
+  auto decrypted = DataBuffer{};
+  if (!DecryptInto(data, decrypted)) {
+    return {};
+  }
+  return decrypted;
+}
+
+bool SodiumAesGcmDecryptProvider::DecryptInto(DataBuffer const& data,
+                                              DataBuffer& decrypted) {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumAesGcm);
+
+  return _internal::DecryptWithAesGcm(key.Get<SodiumAesGcmKey>(), data,
+                                      decrypted);
+}
+
+IDecryptProvider::DetachedDecrypt SodiumAesGcmDecryptProvider::Detach() {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumAesGcm);
+
+  return [secret_key{key.Get<SodiumAesGcmKey>()}](DataBuffer const& data,
+                                                  DataBuffer& decrypted) {
+    return _internal::DecryptWithAesGcm(secret_key, data, decrypted);
+  };
+}
+
+}  // namespace ae
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_CRYPTO_SODIUM_SODIUM_AES_GCM_CRYPTO_PROVIDER_H_
+#define AETHER_CRYPTO_SODIUM_SODIUM_AES_GCM_CRYPTO_PROVIDER_H_
+
+#include "aether/config.h"
+
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+
+#  include "aether/obj/ptr.h"
+
+#  include "aether/crypto/icrypto_provider.h"
+#  include "aether/crypto/ikey_provider.h"
+
+namespace ae {
+/**
+ * \brief Is AES-256-GCM supported by the CPU.
+ * libsodium implements it only with AES-NI or ARM crypto extensions.
+ */
+bool SodiumAesGcmAvailable();
+
+/**
+ * \brief AES-256-GCM with the same packet layout as ChaCha20-Poly1305.
+ * The 8 byte counter nonce is zero extended to the 12 bytes of AES-GCM.
+ */
+class SodiumAesGcmEncryptProvider : public IEncryptProvider {
+ public:
+  explicit SodiumAesGcmEncryptProvider(Ptr<ISyncKeyProvider> key_provider);
+
+  DataBuffer Encrypt(DataBuffer const& data) override;
+  void EncryptInPlace(DataBuffer& data) override;
+  std::size_t EncryptOverhead() const override;
+  DetachedEncrypt Detach() override;
+
+ private:
+  Ptr<ISyncKeyProvider> key_provider_;
+};
+
+class SodiumAesGcmDecryptProvider : public IDecryptProvider {
+ public:
+  explicit SodiumAesGcmDecryptProvider(Ptr<ISyncKeyProvider> key_provider);
+
+  DataBuffer Decrypt(DataBuffer const& data) override;
+  bool DecryptInto(DataBuffer const& data, DataBuffer& decrypted) override;
+  DetachedDecrypt Detach() override;
+
+ private:
+  Ptr<ISyncKeyProvider> key_provider_;
+};
+}  // namespace ae
+
+#endif
+#endif  // AETHER_CRYPTO_SODIUM_SODIUM_AES_GCM_CRYPTO_PROVIDER_H_
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/crypto/sodium/sodium_box_crypto_provider.h"
+
+#if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+
+#  include <cassert>
+#  include <utility>
+
+#  include "third_party/libsodium/src/libsodium/include/sodium/crypto_box.h"
+#  include "third_party/libsodium/src/libsodium/include/sodium/randombytes.h"
+
+#  include "aether/tele/tele.h"
+
+namespace ae {
+namespace _internal {
+static constexpr std::size_t kBoxOverhead =
+    crypto_box_MACBYTES + crypto_box_NONCEBYTES;
+
+inline void EncryptWithBox(SodiumBoxSharedKey::SharedKey const& shared_key,
+                           DataBuffer& data) {
+  auto data_size = data.size();
+  data.resize(data_size + kBoxOverhead);
+  auto* mac = data.data() + data_size;
+  auto* nonce = mac + crypto_box_MACBYTES;
+
+  // random nonce is safe for XSalsa20 and does not require any state
+  randombytes_buf(nonce, crypto_box_NONCEBYTES);
+
+  [[maybe_unused]] auto r = crypto_box_detached_afternm(
+      data.data(), mac, data.data(), data_size, nonce, shared_key.data());
+  assert(r == 0);
+}
+
+inline bool DecryptWithBox(SodiumBoxSharedKey::SharedKey const& shared_key,
+                           DataBuffer const& encrypted_data,
+                           DataBuffer& decrypted_data) {
+  if (encrypted_data.size() < kBoxOverhead) {
+    decrypted_data.clear();
+    return false;
+  }
+
+  auto data_size = encrypted_data.size() - kBoxOverhead;
+  auto const* mac = encrypted_data.data() + data_size;
+  auto const* nonce = mac + crypto_box_MACBYTES;
+
+  // decrypted may be the same buffer, it is only shrunk before decrypt
+  decrypted_data.resize(data_size);
+
+  auto r = crypto_box_open_detached_afternm(
+      decrypted_data.data(), encrypted_data.data(), mac, data_size, nonce,
+      shared_key.data());
+  if (r != 0) {
+    decrypted_data.clear();
+    return false;
+  }
+  return true;
+}
+}  // namespace _internal
+
+SodiumBoxSharedKey::SharedKey const* SodiumBoxSharedKey::Get(
+    SodiumCurveSecretKey const& secret_key,
+    SodiumCurvePublicKey const& peer_key) {
+  if (valid_ && (secret_key_.key == secret_key.key) &&
+      (peer_key_.key == peer_key.key)) {
+    return &shared_key_;
+  }
+
+  secret_key_ = secret_key;
+  peer_key_ = peer_key;
+  // fails for a low order peer key
+  valid_ = crypto_box_beforenm(shared_key_.data(), peer_key_.key.data(),
+                               secret_key_.key.data()) == 0;
+  if (!valid_) {
+    return nullptr;
+  }
+  return &shared_key_;
+}
+
+SodiumBoxEncryptProvider::SodiumBoxEncryptProvider(
+    Ptr<IAsyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {}
+
+DataBuffer SodiumBoxEncryptProvider::Encrypt(DataBuffer const& data) {
+  auto ciphertext = DataBuffer{};
+  ciphertext.reserve(data.size() + EncryptOverhead());
+  ciphertext.assign(std::begin(data), std::end(data));
+  EncryptInPlace(ciphertext);
+  return ciphertext;
+}
+
+void SodiumBoxEncryptProvider::EncryptInPlace(DataBuffer& data) {
+  auto pub_key = key_provider_->PublicKey();
+  assert(pub_key.Index() == CryptoKeyType::kSodiumCurvePublic);
+  auto sec_key = key_provider_->SecretKey();
+  assert(sec_key.Index() == CryptoKeyType::kSodiumCurveSecret);
+
+  auto const* shared_key =
+      shared_key_.Get(sec_key.Get<SodiumCurveSecretKey>(),
+                      pub_key.Get<SodiumCurvePublicKey>());
+  if (shared_key == nullptr) {
+    AE_TELED_ERROR("Invalid peer public key, data is not encrypted");
+    data.clear();
+    return;
+  }
+  _internal::EncryptWithBox(*shared_key, data);
+}
+
+std::size_t SodiumBoxEncryptProvider::EncryptOverhead() const {
+  return _internal::kBoxOverhead;
+}
+
+IEncryptProvider::DetachedEncrypt SodiumBoxEncryptProvider::Detach() {
+  auto pub_key = key_provider_->PublicKey();
+  assert(pub_key.Index() == CryptoKeyType::kSodiumCurvePublic);
+  auto sec_key = key_provider_->SecretKey();
+  assert(sec_key.Index() == CryptoKeyType::kSodiumCurveSecret);
+
+  auto const* shared_key =
+      shared_key_.Get(sec_key.Get<SodiumCurveSecretKey>(),
+                      pub_key.Get<SodiumCurvePublicKey>());
+  if (shared_key == nullptr) {
+    AE_TELED_ERROR("Invalid peer public key, data is not encrypted");
+    return [](DataBuffer& data) { data.clear(); };
+  }
+  return [shared_key{*shared_key}](DataBuffer& data) {
+    _internal::EncryptWithBox(shared_key, data);
+  };
+}
+
+SodiumBoxDecryptProvider::SodiumBoxDecryptProvider(
+    Ptr<IAsyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {}
+
+DataBuffer SodiumBoxDecryptProvider::Decrypt(DataBuffer const& data) {
+  auto decrypted = DataBuffer{};
+  DecryptInto(data, decrypted);
+  return decrypted;
+}
+
+bool SodiumBoxDecryptProvider::DecryptInto(DataBuffer const& data,
+                                           DataBuffer& decrypted) {
+  auto pub_key = key_provider_->PublicKey();
+  assert(pub_key.Index() == CryptoKeyType::kSodiumCurvePublic);
+  auto sec_key = key_provider_->SecretKey();
+  assert(sec_key.Index() == CryptoKeyType::kSodiumCurveSecret);
+
+  // only the configured peer is accepted, the packet does not choose the key
+  auto const* shared_key =
+      shared_key_.Get(sec_key.Get<SodiumCurveSecretKey>(),
+                      pub_key.Get<SodiumCurvePublicKey>());
+  if (shared_key == nullptr) {
+    decrypted.clear();
+    return false;
+  }
+  return _internal::DecryptWithBox(*shared_key, data, decrypted);
+}
+
+}  // namespace ae
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_CRYPTO_SODIUM_SODIUM_BOX_CRYPTO_PROVIDER_H_
+#define AETHER_CRYPTO_SODIUM_SODIUM_BOX_CRYPTO_PROVIDER_H_
+
+#include "aether/config.h"
+
+#if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+
+#  include <array>
+#  include <cstdint>
+
+#  include "aether/obj/ptr.h"
+
+#  include "aether/crypto/key.h"
+#  include "aether/crypto/icrypto_provider.h"
+#  include "aether/crypto/ikey_provider.h"
+
+namespace ae {
+/**
+ * \brief crypto_box shared key precomputed with crypto_box_beforenm.
+ * The key is computed again only if the peer key or own secret key changes.
+ */
+class SodiumBoxSharedKey {
+ public:
+  using SharedKey = std::array<std::uint8_t, crypto_box_BEFORENMBYTES>;
+
+  /**
+   * \brief The shared key or nullptr if peer_key is not a valid key.
+   */
+  SharedKey const* Get(SodiumCurveSecretKey const& secret_key,
+                       SodiumCurvePublicKey const& peer_key);
+
+ private:
+  bool valid_{};
+  SodiumCurveSecretKey secret_key_{};
+  SodiumCurvePublicKey peer_key_{};
+  SharedKey shared_key_{};
+};
+
+/**
+ * \brief Authenticated crypto_box with precomputed shared key.
+ * key_provider's PublicKey is the peer's key and SecretKey is our own, so
+ * only the configured peer is accepted.
+ * Packet is ciphertext | mac | nonce.
+ * It is not compatible with crypto_box_seal used by SodiumAsync providers
+ * and should be used only if both sides agree on it.
+ */
+class SodiumBoxEncryptProvider : public IEncryptProvider {
+ public:
+  explicit SodiumBoxEncryptProvider(Ptr<IAsyncKeyProvider> key_provider);
+
+  DataBuffer Encrypt(DataBuffer const& data) override;
+  void EncryptInPlace(DataBuffer& data) override;
+  std::size_t EncryptOverhead() const override;
+  DetachedEncrypt Detach() override;
+
+ private:
+  Ptr<IAsyncKeyProvider> key_provider_;
+  SodiumBoxSharedKey shared_key_;
+};
+
+class SodiumBoxDecryptProvider : public IDecryptProvider {
+ public:
+  explicit SodiumBoxDecryptProvider(Ptr<IAsyncKeyProvider> key_provider);
+
+  DataBuffer Decrypt(DataBuffer const& data) override;
+  bool DecryptInto(DataBuffer const& data, DataBuffer& decrypted) override;
+
+ private:
+  Ptr<IAsyncKeyProvider> key_provider_;
+  SodiumBoxSharedKey shared_key_;
+};
+}  // namespace ae
+
+#endif
+#endif  // AETHER_CRYPTO_SODIUM_SODIUM_BOX_CRYPTO_PROVIDER_H_
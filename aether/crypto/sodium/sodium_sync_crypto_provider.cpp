@@ -19,63 +19,122 @@
 #if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
 
 #  include <cassert>
+#  include <cstring>
 #  include <utility>
 #  include <algorithm>
-#  include <vector>
 
 #  include "aether/crypto/crypto_nonce.h"
 
 namespace ae {
 
 namespace _internal {
-inline DataBuffer EncryptWithSymmetric(SodiumChachaKey const& secret_key,
-                                       CryptoNonce const& nonce,
-                                       DataBuffer const& raw_data) {
-  std::vector<uint8_t> ciphertext(
-      raw_data.size() + crypto_aead_chacha20poly1305_ABYTES + nonce.size());
+// ciphertext, mac and nonce are placed one after another, so the data only
+// grows at the end and the plain text is encrypted in place
+inline void EncryptWithSymmetric(SodiumChachaKey const& secret_key,
+                                 CryptoNonce const& nonce, DataBuffer& data) {
+  auto data_size = data.size();
+  data.resize(data_size + crypto_aead_chacha20poly1305_ABYTES + nonce.size());
+  auto* mac = data.data() + data_size;
 
-  unsigned long long ciphertext_len;
-
-  [[maybe_unused]] auto r = crypto_aead_chacha20poly1305_encrypt(
-      ciphertext.data(), &ciphertext_len, raw_data.data(), raw_data.size(),
-      nullptr, 0, nullptr, nonce.data(), secret_key.key.data());
+  [[maybe_unused]] auto r = crypto_aead_chacha20poly1305_encrypt_detached(
+      data.data(), mac, nullptr, data.data(), data_size, nullptr, 0, nullptr,
+      nonce.data(), secret_key.key.data());
 
   assert(r == 0);
 
-  ciphertext.resize(static_cast<std::size_t>
-                   (ciphertext_len + nonce.size()));
-
   // add nonce to the end of ciphertext
-  std::copy(
-      std::begin(nonce), std::end(nonce),
-      std::begin(ciphertext) + static_cast<std::ptrdiff_t>(ciphertext_len));
+  std::copy(std::begin(nonce), std::end(nonce),
+            mac + crypto_aead_chacha20poly1305_ABYTES);
+}
 
-  return ciphertext;
+inline bool DecryptWithSymmetric(SodiumChachaKey const& secret_key,
+                                 DataBuffer const& encrypted_data,
+                                 DataBuffer& decrypted_data) {
+  if (encrypted_data.size() <
+      (crypto_aead_chacha20poly1305_ABYTES + kNonceSize)) {
+    return false;
+  }
+
+  auto data_size = encrypted_data.size() - kNonceSize -
+                   crypto_aead_chacha20poly1305_ABYTES;
+  // get mac and nonce from the end of encrypted data
+  auto const* mac = encrypted_data.data() + data_size;
+  auto const* nonce = mac + crypto_aead_chacha20poly1305_ABYTES;
+
+  // decrypted may be the same buffer, it is only shrunk before decrypt
+  decrypted_data.resize(data_size);
+
+  auto r = crypto_aead_chacha20poly1305_decrypt_detached(
+      decrypted_data.data(), nullptr, encrypted_data.data(), data_size, mac,
+      nullptr, 0, nonce, secret_key.key.data());
+  return r == 0;
 }
 
-inline DataBuffer DecryptWithSymmetric(SodiumChachaKey const& secret_key,
-                                       DataBuffer const& encrypted_data) {
-  assert(encrypted_data.size() > kNonceSize);
+static_assert(kNonceSize == sizeof(std::uint64_t));
+
+// the same byte order as CryptoNonce::Next uses
+inline std::uint64_t NonceToCounter(CryptoNonce const& nonce) {
+  std::uint64_t counter;
+  std::memcpy(&counter, nonce.data(), sizeof(counter));
+  return counter;
+}
 
+inline CryptoNonce CounterToNonce(std::uint64_t counter) {
   auto nonce = CryptoNonce{};
-  auto encrypted_data_size = encrypted_data.size() - nonce.size();
+  std::memcpy(nonce.data(), &counter, sizeof(counter));
+  return nonce;
+}
 
-  // get nonce from the end of child_data_
-  std::copy(
-      encrypted_data.begin() + static_cast<std::ptrdiff_t>(encrypted_data_size),
-      encrypted_data.end(), nonce.begin());
+inline std::uint64_t EpochBase(CryptoNonce const& nonce) {
+  return NonceToCounter(nonce) &
+         ((std::uint64_t{1} << (ImplicitNonceEpoch::kBaseSize * 8)) - 1);
+}
 
-  auto decrypted_data = std::vector<uint8_t>(
-      encrypted_data_size - crypto_aead_chacha20poly1305_ABYTES);
-  unsigned long long decrypted_len;
+inline CryptoNonce EpochNonce(std::uint64_t base, std::uint16_t index) {
+  return CounterToNonce((base << ImplicitNonceEpoch::kIndexBits) | index);
+}
 
-  [[maybe_unused]] auto r = crypto_aead_chacha20poly1305_decrypt(
-      decrypted_data.data(), &decrypted_len, nullptr, encrypted_data.data(),
-      encrypted_data_size, nullptr, 0, nonce.data(), secret_key.key.data());
+inline void PutLittleEndian(std::uint64_t value, std::size_t size,
+                            std::uint8_t* out) {
+  for (std::size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<std::uint8_t>(value >> (i * 8));
+  }
+}
 
+inline std::uint64_t GetLittleEndian(std::uint8_t const* in,
+                                     std::size_t size) {
+  auto value = std::uint64_t{};
+  for (std::size_t i = 0; i < size; ++i) {
+    value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+  }
+  return value;
+}
+
+// ciphertext, mac, epoch base if it is sent and the header with the index
+inline void EncryptWithImplicitNonce(SodiumChachaKey const& secret_key,
+                                     ImplicitNonceEpoch::Packet const& packet,
+                                     DataBuffer& data) {
+  auto data_size = data.size();
+  auto trailer_size = crypto_aead_chacha20poly1305_ABYTES +
+                      (packet.send_base ? ImplicitNonceEpoch::kBaseSize : 0) +
+                      ImplicitNonceEpoch::kHeaderSize;
+  data.resize(data_size + trailer_size);
+  auto* mac = data.data() + data_size;
+  auto nonce = EpochNonce(packet.base, packet.index);
+
+  [[maybe_unused]] auto r = crypto_aead_chacha20poly1305_encrypt_detached(
+      data.data(), mac, nullptr, data.data(), data_size, nullptr, 0, nullptr,
+      nonce.data(), secret_key.key.data());
   assert(r == 0);
 
-  return decrypted_data;
+  auto* tail = mac + crypto_aead_chacha20poly1305_ABYTES;
+  auto header = static_cast<std::uint16_t>(packet.index);
+  if (packet.send_base) {
+    PutLittleEndian(packet.base, ImplicitNonceEpoch::kBaseSize, tail);
+    tail += ImplicitNonceEpoch::kBaseSize;
+    header |= ImplicitNonceEpoch::kBaseFlag;
+  }
+  PutLittleEndian(header, ImplicitNonceEpoch::kHeaderSize, tail);
 }
 }  // namespace _internal
 
@@ -87,14 +146,36 @@ DataBuffer SodiumSyncEncryptProvider::Encrypt(DataBuffer const& data) {
   auto key = key_provider_->GetKey();
   assert(key.Index() == CryptoKeyType::kSodiumChacha);
 
-  return _internal::EncryptWithSymmetric(key.Get<SodiumChachaKey>(),
-                                         key_provider_->Nonce(), data);
+  auto ciphertext = DataBuffer{};
+  ciphertext.reserve(data.size() + EncryptOverhead());
+  ciphertext.assign(std::begin(data), std::end(data));
+  _internal::EncryptWithSymmetric(key.Get<SodiumChachaKey>(),
+                                  key_provider_->Nonce(), ciphertext);
+  return ciphertext;
+}
+
+void SodiumSyncEncryptProvider::EncryptInPlace(DataBuffer& data) {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumChacha);
+
+  _internal::EncryptWithSymmetric(key.Get<SodiumChachaKey>(),
+                                  key_provider_->Nonce(), data);
 }
 
 std::size_t SodiumSyncEncryptProvider::EncryptOverhead() const {
   return crypto_aead_chacha20poly1305_ABYTES + kNonceSize;
 }
 
+IEncryptProvider::DetachedEncrypt SodiumSyncEncryptProvider::Detach() {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumChacha);
+
+  return [secret_key{key.Get<SodiumChachaKey>()},
+          nonce{key_provider_->Nonce()}](DataBuffer& data) {
+    _internal::EncryptWithSymmetric(secret_key, nonce, data);
+  };
+}
+
 SodiumSyncDecryptProvider::SodiumSyncDecryptProvider(
     Ptr<ISyncKeyProvider> key_provider)
     : key_provider_{std::move(key_provider)} {}
@@ -103,7 +184,151 @@ DataBuffer SodiumSyncDecryptProvider::Decrypt(DataBuffer const& data) {
   auto key = key_provider_->GetKey();
   assert(key.Index() == CryptoKeyType::kSodiumChacha);
 
-  return _internal::DecryptWithSymmetric(key.Get<SodiumChachaKey>(), data);
+  auto decrypted = DataBuffer{};
+  if (!_internal::DecryptWithSymmetric(key.Get<SodiumChachaKey>(), data,
+                                       decrypted)) {
+    return {};
+  }
+  return decrypted;
+}
+
+bool SodiumSyncDecryptProvider::DecryptInto(DataBuffer const& data,
+                                            DataBuffer& decrypted) {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumChacha);
+
+  return _internal::DecryptWithSymmetric(key.Get<SodiumChachaKey>(), data,
+                                         decrypted);
+}
+
+IDecryptProvider::DetachedDecrypt SodiumSyncDecryptProvider::Detach() {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumChacha);
+
+  return [secret_key{key.Get<SodiumChachaKey>()}](DataBuffer const& data,
+                                                  DataBuffer& decrypted) {
+    return _internal::DecryptWithSymmetric(secret_key, data, decrypted);
+  };
+}
+
+ImplicitNonceEpoch::Packet ImplicitNonceEpoch::Next(
+    ISyncKeyProvider const& key_provider, SodiumChachaKey const& key) {
+  if (!started_ || (key_.key != key.key) ||
+      (index_ == ImplicitNonceEpoch::kEpochSize)) {
+    // each epoch takes a new nonce from the key provider
+    started_ = true;
+    key_ = key;
+    base_ = _internal::EpochBase(key_provider.Nonce());
+    index_ = 0;
+  }
+  auto index = static_cast<std::uint16_t>(index_++);
+  return Packet{base_, index,
+                (index % ImplicitNonceEpoch::kBaseSyncInterval) == 0};
+}
+
+SodiumImplicitNonceEncryptProvider::SodiumImplicitNonceEncryptProvider(
+    Ptr<ISyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {}
+
+DataBuffer SodiumImplicitNonceEncryptProvider::Encrypt(DataBuffer const& data) {
+  auto ciphertext = DataBuffer{};
+  ciphertext.reserve(data.size() + EncryptOverhead());
+  ciphertext.assign(std::begin(data), std::end(data));
+  EncryptInPlace(ciphertext);
+  return ciphertext;
+}
+
+void SodiumImplicitNonceEncryptProvider::EncryptInPlace(DataBuffer& data) {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumChacha);
+
+  auto const& secret_key = key.Get<SodiumChachaKey>();
+  _internal::EncryptWithImplicitNonce(
+      secret_key, epoch_.Next(*key_provider_, secret_key), data);
+}
+
+std::size_t SodiumImplicitNonceEncryptProvider::EncryptOverhead() const {
+  return crypto_aead_chacha20poly1305_ABYTES + ImplicitNonceEpoch::kBaseSize +
+         ImplicitNonceEpoch::kHeaderSize;
+}
+
+IEncryptProvider::DetachedEncrypt SodiumImplicitNonceEncryptProvider::Detach() {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumChacha);
+
+  // nonce is taken in the order of detaching
+  auto const& secret_key = key.Get<SodiumChachaKey>();
+  return [secret_key, packet{epoch_.Next(*key_provider_, secret_key)}](
+             DataBuffer& data) {
+    _internal::EncryptWithImplicitNonce(secret_key, packet, data);
+  };
+}
+
+SodiumImplicitNonceDecryptProvider::SodiumImplicitNonceDecryptProvider(
+    Ptr<ISyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {}
+
+DataBuffer SodiumImplicitNonceDecryptProvider::Decrypt(DataBuffer const& data) {
+  auto decrypted = DataBuffer{};
+  if (!DecryptInto(data, decrypted)) {
+    return {};
+  }
+  return decrypted;
+}
+
+bool SodiumImplicitNonceDecryptProvider::DecryptInto(DataBuffer const& data,
+                                                     DataBuffer& decrypted) {
+  auto key = key_provider_->GetKey();
+  assert(key.Index() == CryptoKeyType::kSodiumChacha);
+  auto const& secret_key = key.Get<SodiumChachaKey>();
+  if (has_base_ && (key_.key != secret_key.key)) {
+    // the sender starts a new epoch with the new key
+    has_base_ = false;
+  }
+
+  auto trailer_size =
+      crypto_aead_chacha20poly1305_ABYTES + ImplicitNonceEpoch::kHeaderSize;
+  if (data.size() < trailer_size) {
+    return false;
+  }
+  auto header = static_cast<std::uint16_t>(_internal::GetLittleEndian(
+      data.data() + data.size() - ImplicitNonceEpoch::kHeaderSize,
+      ImplicitNonceEpoch::kHeaderSize));
+  auto index =
+      static_cast<std::uint16_t>(header & ~ImplicitNonceEpoch::kBaseFlag);
+
+  auto base = base_;
+  if ((header & ImplicitNonceEpoch::kBaseFlag) != 0) {
+    trailer_size += ImplicitNonceEpoch::kBaseSize;
+    if (data.size() < trailer_size) {
+      return false;
+    }
+    base = _internal::GetLittleEndian(
+        data.data() + data.size() - ImplicitNonceEpoch::kHeaderSize -
+            ImplicitNonceEpoch::kBaseSize,
+        ImplicitNonceEpoch::kBaseSize);
+  } else if (!has_base_) {
+    // epoch is unknown until the sender sends its base again
+    return false;
+  }
+
+  auto data_size = data.size() - trailer_size;
+  auto const* mac = data.data() + data_size;
+  auto nonce = _internal::EpochNonce(base, index);
+
+  // decrypted may be the same buffer, it is only shrunk before decrypt
+  decrypted.resize(data_size);
+  auto r = crypto_aead_chacha20poly1305_decrypt_detached(
+      decrypted.data(), nullptr, data.data(), data_size, mac, nullptr, 0,
+      nonce.data(), secret_key.key.data());
+  if (r != 0) {
+    return false;
+  }
+  // only authenticated packets move the receiver to the new epoch
+  has_base_ = true;
+  key_ = secret_key;
+  base_ = base;
+  return true;
 }
 
 }  // namespace ae
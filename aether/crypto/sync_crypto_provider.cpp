@@ -21,8 +21,11 @@
 #include "aether/crypto/key.h"
 
 #include "aether/crypto/sodium/sodium_sync_crypto_provider.h"
+#include "aether/crypto/sodium/sodium_aes_gcm_crypto_provider.h"
 #include "aether/crypto/hydrogen/hydro_sync_crypto_provider.h"
 
+#include "aether/tele/tele.h"
+
 namespace ae {
 
 namespace _sync_internal {
@@ -53,6 +56,27 @@ Ptr<IDecryptProvider> CreateDecryptImpl(SodiumChachaKey const&,
                                         Ptr<ISyncKeyProvider> key_provider) {
   return MakePtr<SodiumSyncDecryptProvider>(std::move(key_provider));
 }
+
+// keys may be saved on other hardware, so AES-GCM is checked before use
+template <>
+Ptr<IEncryptProvider> CreateEncryptImpl(SodiumAesGcmKey const&,
+                                        Ptr<ISyncKeyProvider> key_provider) {
+  if (!SodiumAesGcmAvailable()) {
+    AE_TELED_ERROR("AES-256-GCM key is not supported by this cpu");
+    return {};
+  }
+  return MakePtr<SodiumAesGcmEncryptProvider>(std::move(key_provider));
+}
+
+template <>
+Ptr<IDecryptProvider> CreateDecryptImpl(SodiumAesGcmKey const&,
+                                        Ptr<ISyncKeyProvider> key_provider) {
+  if (!SodiumAesGcmAvailable()) {
+    AE_TELED_ERROR("AES-256-GCM key is not supported by this cpu");
+    return {};
+  }
+  return MakePtr<SodiumAesGcmDecryptProvider>(std::move(key_provider));
+}
 #endif
 
 #if AE_CRYPTO_SYNC == AE_HYDRO_CRYPTO_SK
@@ -78,17 +102,40 @@ SyncEncryptProvider::SyncEncryptProvider(Ptr<ISyncKeyProvider> key_provider) {
         return _sync_internal::CreateEncryptImpl(key_type, key_provider);
       },
       key);
-  assert(impl_);
 }
 
 DataBuffer SyncEncryptProvider::Encrypt(DataBuffer const& data) {
+  if (!impl_) {
+    AE_TELED_ERROR("No crypto provider for the key, data is not encrypted");
+    return {};
+  }
   return impl_->Encrypt(data);
 }
 
+void SyncEncryptProvider::EncryptInPlace(DataBuffer& data) {
+  if (!impl_) {
+    AE_TELED_ERROR("No crypto provider for the key, data is not encrypted");
+    data.clear();
+    return;
+  }
+  impl_->EncryptInPlace(data);
+}
+
 std::size_t SyncEncryptProvider::EncryptOverhead() const {
+  if (!impl_) {
+    return 0;
+  }
   return impl_->EncryptOverhead();
 }
 
+IEncryptProvider::DetachedEncrypt SyncEncryptProvider::Detach() {
+  if (!impl_) {
+    AE_TELED_ERROR("No crypto provider for the key, data is not encrypted");
+    return [](DataBuffer& data) { data.clear(); };
+  }
+  return impl_->Detach();
+}
+
 SyncDecryptProvider::SyncDecryptProvider(Ptr<ISyncKeyProvider> key_provider) {
   auto key = key_provider->GetKey();
   impl_ = std::visit(
@@ -96,11 +143,31 @@ SyncDecryptProvider::SyncDecryptProvider(Ptr<ISyncKeyProvider> key_provider) {
         return _sync_internal::CreateDecryptImpl(key_type, key_provider);
       },
       key);
-  assert(impl_);
 }
 
 DataBuffer SyncDecryptProvider::Decrypt(DataBuffer const& data) {
+  if (!impl_) {
+    AE_TELED_ERROR("No crypto provider for the key, data is not decrypted");
+    return {};
+  }
   return impl_->Decrypt(data);
 }
 
+bool SyncDecryptProvider::DecryptInto(DataBuffer const& data,
+                                      DataBuffer& decrypted) {
+  if (!impl_) {
+    AE_TELED_ERROR("No crypto provider for the key, data is not decrypted");
+    return false;
+  }
+  return impl_->DecryptInto(data, decrypted);
+}
+
+IDecryptProvider::DetachedDecrypt SyncDecryptProvider::Detach() {
+  if (!impl_) {
+    AE_TELED_ERROR("No crypto provider for the key, data is not decrypted");
+    return [](DataBuffer const&, DataBuffer&) { return false; };
+  }
+  return impl_->Detach();
+}
+
 }  // namespace ae
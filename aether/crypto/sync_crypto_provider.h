@@ -28,7 +28,9 @@ class SyncEncryptProvider : public IEncryptProvider {
   explicit SyncEncryptProvider(Ptr<ISyncKeyProvider> key_provider);
 
   DataBuffer Encrypt(DataBuffer const& data) override;
+  void EncryptInPlace(DataBuffer& data) override;
   std::size_t EncryptOverhead() const override;
+  DetachedEncrypt Detach() override;
 
  private:
   Ptr<IEncryptProvider> impl_;
@@ -38,6 +40,8 @@ class SyncDecryptProvider : public IDecryptProvider {
  public:
   explicit SyncDecryptProvider(Ptr<ISyncKeyProvider> key_provider);
   DataBuffer Decrypt(DataBuffer const& data) override;
+  bool DecryptInto(DataBuffer const& data, DataBuffer& decrypted) override;
+  DetachedDecrypt Detach() override;
 
  private:
   Ptr<IDecryptProvider> impl_;
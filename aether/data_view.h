@@ -0,0 +1,135 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_DATA_VIEW_H_
+#define AETHER_DATA_VIEW_H_
+
+#include <cstdint>
+#include <utility>
+#include <variant>
+
+#include "aether/mstream.h"
+#include "aether/transport/data_buffer.h"
+
+namespace ae {
+/**
+ * \brief Byte payload field which is read in place.
+ * Reading it from a buffer over contiguous memory makes a view into that
+ * memory, e.g. into the received packet, so payloads only inspected or
+ * forwarded are not copied during parse. Other buffers read an owned copy.
+ * The view is valid only while the packet is alive. Copying or moving the
+ * DataView makes an owned copy of the viewed data, so a moved out view never
+ * dangles.
+ * It's serialized the same way as DataBuffer.
+ */
+class DataView {
+ public:
+  DataView() = default;
+  DataView(std::uint8_t const* data, std::size_t size)
+      : data_{View{data, size}} {}
+  DataView(DataBuffer data) : data_{std::move(data)} {}
+
+  DataView(DataView&& other) : data_{std::move(other).ToBuffer()} {}
+  DataView(DataView const& other) : data_{other.CopyData()} {}
+
+  DataView& operator=(DataView&& other) {
+    if (this != &other) {
+      data_ = std::move(other).ToBuffer();
+    }
+    return *this;
+  }
+  DataView& operator=(DataView const& other) {
+    if (this != &other) {
+      data_ = other.CopyData();
+    }
+    return *this;
+  }
+
+  std::uint8_t const* data() const {
+    if (auto const* view = std::get_if<View>(&data_); view != nullptr) {
+      return view->data;
+    }
+    return std::get<DataBuffer>(data_).data();
+  }
+  std::size_t size() const {
+    if (auto const* view = std::get_if<View>(&data_); view != nullptr) {
+      return view->size;
+    }
+    return std::get<DataBuffer>(data_).size();
+  }
+  bool empty() const { return size() == 0; }
+  std::uint8_t const* begin() const { return data(); }
+  std::uint8_t const* end() const { return data() + size(); }
+
+  // is it a view into someone else's memory
+  bool is_view() const { return std::holds_alternative<View>(data_); }
+
+  DataBuffer CopyData() const { return DataBuffer{begin(), end()}; }
+  // owned data is moved out without copy
+  DataBuffer ToBuffer() && {
+    if (auto* buffer = std::get_if<DataBuffer>(&data_); buffer != nullptr) {
+      return std::move(*buffer);
+    }
+    return CopyData();
+  }
+
+ private:
+  template <typename Ib>
+  friend imstream<Ib>& operator>>(imstream<Ib>& s, DataView& t);
+
+  struct View {
+    std::uint8_t const* data;
+    std::size_t size;
+  };
+
+  std::variant<DataBuffer, View> data_;
+};
+
+template <typename Ob>
+omstream<Ob>& operator<<(omstream<Ob>& s, DataView const& t) {
+  s << static_cast<typename Ob::size_type>(t.size());
+  s.write(t.data(), t.size());
+  return s;
+}
+
+template <typename Ib>
+imstream<Ib>& operator>>(imstream<Ib>& s, DataView& t) {
+  if constexpr (HasContiguousRead<Ib>::value) {
+    typename Ib::size_type size{};
+    s >> size;
+    if (!data_was_read(s)) {
+      return s;
+    }
+    auto data_size = static_cast<std::size_t>(size);
+    if (s.ib_.available() < data_size) {
+      s.result(ReadResult::kNo);
+      return s;
+    }
+    // set in place, assignment of a view makes a copy
+    t.data_ = DataView::View{s.ib_.current(), data_size};
+    s.ib_.skip(data_size);
+  } else {
+    DataBuffer data;
+    s >> data;
+    if (data_was_read(s)) {
+      t = DataView{std::move(data)};
+    }
+  }
+  return s;
+}
+}  // namespace ae
+
+#endif  // AETHER_DATA_VIEW_H_
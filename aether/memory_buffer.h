@@ -24,6 +24,12 @@
 #include <streambuf>
 
 namespace ae {
+/**
+ * \brief Stream buffer over a growing memory block.
+ * Capacity grows geometrically, rounded up to the block size, so appending
+ * many small parts is amortized to a few reallocations. Use Reserve if the
+ * final size is known and Reset to reuse the memory for the next data.
+ */
 template <typename CharT = char, typename Traits = std::char_traits<CharT>,
           std::streamsize BLOCK_SIZE = 1024>
 class MemStreamBuf : public std::basic_streambuf<CharT, Traits> {
@@ -90,6 +96,24 @@ class MemStreamBuf : public std::basic_streambuf<CharT, Traits> {
     return membuf_;
   }
 
+  /**
+   * \brief Makes capacity at least new_capacity, never shrinks.
+   */
+  char_type* Reserve(std::streamsize new_capacity) noexcept {
+    if (new_capacity <= Capacity()) {
+      return membuf_;
+    }
+    return SetCapacity(new_capacity);
+  }
+
+  /**
+   * \brief Drops the data but keeps allocated memory.
+   */
+  void Reset() noexcept {
+    streambuf::setp(membuf_, membuf_ + Capacity());
+    streambuf::setg(membuf_, membuf_, membuf_);
+  }
+
   constexpr char_type* ShrinkToFit() { return SetExactCapacity(Size()); }
 
   constexpr char_type* Data() const { return membuf_; }
@@ -117,7 +141,7 @@ class MemStreamBuf : public std::basic_streambuf<CharT, Traits> {
    */
   std::streamsize xsputn(const char_type* s, std::streamsize count) override {
     if (count > AvailableCapacity()) {
-      SetCapacity(Size() + count);
+      Grow(Size() + count);
     }
 
     auto written = streambuf::xsputn(s, count);
@@ -130,9 +154,8 @@ class MemStreamBuf : public std::basic_streambuf<CharT, Traits> {
    * \brief Implements std::basic_streambuf::overflow
    */
   int_type overflow(int_type ch) override {
-    // try to increase the size by one block
-    if (!SetCapacity(Size() +
-                     static_cast<std::streamsize>(sizeof(char_type)))) {
+    // try to increase the size
+    if (!Grow(Size() + 1)) {
       // size increase did not work, return eof
       return traits_type::eof();
     }
@@ -168,12 +191,18 @@ class MemStreamBuf : public std::basic_streambuf<CharT, Traits> {
     if (mode == std::ios_base::in) {
       streambuf::setg(membuf_, membuf_ + sp, membuf_ + Size());
     } else if (mode == std::ios_base::out) {
-      streambuf::setp(membuf_, membuf_ + sp);
+      // keep the capacity, only move the put position
+      auto pos = std::min(static_cast<std::streamsize>(sp), Capacity());
+      streambuf::setp(membuf_, membuf_ + Capacity());
+      streambuf::pbump(static_cast<int>(pos));
     }
     return sp;
   }
 
  private:
+  char_type* Grow(std::streamsize min_capacity) noexcept {
+    return SetCapacity(std::max(min_capacity, Capacity() * 2));
+  }
 };
 }  // namespace ae
 #endif  // AETHER_MEMORY_BUFFER_H_ */
@@ -20,22 +20,14 @@
 #include <utility>
 
 #include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/api_dispatch.h"
 
 namespace ae {
 
 void ClientSafeApi::LoadFactory(MessageId message_id, ApiParser& parser) {
-  switch (message_id) {
-    case StreamToClient::kMessageCode:
-      parser.Load<StreamToClient>(*this);
-      break;
-    case SendMessage::kMessageCode:
-      parser.Load<SendMessage>(*this);
-      break;
-    default:
-      if (!ExtendsApi::LoadExtend(message_id, parser)) {
-        assert(false);
-      }
-  }
+  [[maybe_unused]] auto res = DispatchLoad(*this, message_id, parser) ||
+                              ExtendsApi::LoadExtend(message_id, parser);
+  assert(res);
 }
 
 void ClientSafeApi::Execute(StreamToClient&& message, ApiParser& api_parser) {
@@ -18,8 +18,8 @@
 #define AETHER_METHODS_CLIENT_API_CLIENT_SAFE_API_H_
 
 #include "aether/crc.h"
-#include "aether/transport/data_buffer.h"
 #include "aether/uid.h"
+#include "aether/data_view.h"
 
 #include "aether/api_protocol/api_protocol.h"
 #include "aether/stream_api/stream_api.h"
@@ -58,9 +58,15 @@ class ClientSafeApi : public ApiClass,
     }
 
     Uid uid;
-    DataBuffer data;
+    // view into the received packet, valid only while the message is handled
+    // moved or copied message owns a copy of the data
+    DataView data;
   };
 
+  using Messages = ApiMessageList<
+      ApiMessageCode<StreamToClient::kMessageCode, StreamToClient>,
+      ApiMessageCode<SendMessage::kMessageCode, SendMessage>>;
+
   void LoadFactory(MessageId message_id, ApiParser& parser) override;
 
   void Execute(StreamToClient&& message, ApiParser& api_parser);
@@ -33,6 +33,10 @@ void GlobalRegServerApi::Pack(Finish&& message, ApiPacker& packer) {
       [req_id{message.request_id}](ApiParser& parser) {
         parser.Context().MessageNotify(ClientGlobalRegApi::ConfirmRegistration{
             req_id, parser.Extract<RegistrationResponse>()});
+      },
+      [req_id{message.request_id},
+       context{&packer.Context()}](std::uint32_t error_code) {
+        context->MessageNotify(SendError{{}, req_id, error_code});
       });
 
   packer.Pack(4, std::move(message));
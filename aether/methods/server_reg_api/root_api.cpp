@@ -30,6 +30,10 @@ void RootApi::Pack(GetAsymmetricPublicKey message, ApiPacker& packer) {
        context{&packer.Context()}](ApiParser& parser) {
         context->MessageNotify(ClientApiRegSafe::GetKeysResponse{
             req_id, parser.Extract<SignedKey>()});
+      },
+      [req_id{message.request_id},
+       context{&packer.Context()}](std::uint32_t error_code) {
+        context->MessageNotify(SendError{{}, req_id, error_code});
       });
 
   packer.Pack(GetAsymmetricPublicKey::kMessageCode, message);
@@ -32,6 +32,10 @@ void ServerRegistrationApi::Pack(RequestProofOfWorkData&& message,
       [req_id{message.request_id}](ApiParser& parser) {
         parser.Context().MessageNotify(ClientApiRegSafe::ResponseWorkProofData{
             req_id, parser.Extract<PowParams>()});
+      },
+      [req_id{message.request_id},
+       context{&packer.Context()}](std::uint32_t error_code) {
+        context->MessageNotify(SendError{{}, req_id, error_code});
       });
 
   packer.Pack(RequestProofOfWorkData::kMessageCode, std::move(message));
@@ -42,6 +46,10 @@ void ServerRegistrationApi::Pack(ResolveServers&& message, ApiPacker& packer) {
       [req_id{message.request_id}](ApiParser& parser) {
         parser.Context().MessageNotify(ClientApiRegSafe::ResolveServersResponse{
             req_id, parser.Extract<std::vector<ServerDescriptor>>()});
+      },
+      [req_id{message.request_id},
+       context{&packer.Context()}](std::uint32_t error_code) {
+        context->MessageNotify(SendError{{}, req_id, error_code});
       });
 
   packer.Pack(ResolveServers::kMessageCode, std::move(message));
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <list>
+#include <array>
 #include <deque>
 #include <string>
 #include <vector>
@@ -77,6 +78,10 @@ enum class ReadResult {
  * size_t read(void* data, size_t size, size_t minimum_size);
  * ReadResult result() const;
  * void result(ReadResult);
+ * // optional, for buffers over contiguous memory
+ * std::uint8_t const* current() const;
+ * std::size_t available() const;
+ * void skip(std::size_t size);
  };
  */
 
@@ -95,6 +100,19 @@ class imstream : public istream {
   void result(ReadResult result) { ib_.result(result); }
 };
 
+/**
+ * \brief IBuffer gives direct access to unread contiguous memory.
+ */
+template <typename Ib, typename = void>
+struct HasContiguousRead : std::false_type {};
+
+template <typename Ib>
+struct HasContiguousRead<
+    Ib, std::void_t<decltype(std::declval<Ib const&>().current()),
+                    decltype(std::declval<Ib const&>().available()),
+                    decltype(std::declval<Ib&>().skip(std::size_t{}))>>
+    : std::true_type {};
+
 template <typename TStream>
 inline bool data_was_read(TStream& /* is */) {
   return true;
@@ -110,6 +128,27 @@ inline bool data_was_written(TStream& /* s */) {
   return true;
 }
 
+/**
+ * \brief Types serialized as their memory representation.
+ * Arrays and vectors of them are written and read with a single call instead
+ * of element by element. Specialize it for a struct only if it is trivially
+ * copyable, has no padding and its Serializator writes all its memory in
+ * order, e.g. a struct with one std::array<std::uint8_t, N>.
+ * Arithmetic values are written in host byte order by the element path too,
+ * so the bulk path gives the same bytes on any host.
+ */
+template <typename T>
+struct IsTriviallySerializable : std::is_scalar<T> {};
+
+template <typename T, std::size_t N>
+struct IsTriviallySerializable<std::array<T, N>> : IsTriviallySerializable<T> {
+  static_assert(sizeof(std::array<T, N>) == sizeof(T) * N);
+};
+
+template <typename T>
+inline constexpr bool IsTriviallySerializableV =
+    IsTriviallySerializable<T>::value;
+
 template <bool condition, typename T>
 struct omstream_enable_if : std::enable_if<condition, omstream<T>&> {};
 
@@ -188,7 +227,7 @@ imstream<Ib>& operator>>(imstream<Ib>& s, std::string& t) {
 }
 
 template <typename T, typename Ob>
-omstream_enable_if_t<std::is_scalar_v<T>, Ob> operator<<(
+omstream_enable_if_t<IsTriviallySerializableV<T>, Ob> operator<<(
     omstream<Ob>& s, const std::vector<T>& t) {
   s << static_cast<typename Ob::size_type>(t.size());
   s.write(reinterpret_cast<uint8_t const*>(t.data()), t.size() * sizeof(T));
@@ -196,8 +235,8 @@ omstream_enable_if_t<std::is_scalar_v<T>, Ob> operator<<(
 }
 
 template <typename T, typename Ib>
-imstream_enable_if_t<std::is_scalar_v<T>, Ib> operator>>(imstream<Ib>& s,
-                                                         std::vector<T>& t) {
+imstream_enable_if_t<IsTriviallySerializableV<T>, Ib> operator>>(
+    imstream<Ib>& s, std::vector<T>& t) {
   typename Ib::size_type size;
   s >> size;
   if (data_was_read(s)) {
@@ -208,7 +247,7 @@ imstream_enable_if_t<std::is_scalar_v<T>, Ib> operator>>(imstream<Ib>& s,
 }
 
 template <typename T, typename Ob>
-omstream_enable_if_t<!std::is_scalar_v<T>, Ob> operator<<(
+omstream_enable_if_t<!IsTriviallySerializableV<T>, Ob> operator<<(
     omstream<Ob>& s, const std::vector<T>& t) {
   s << static_cast<typename Ob::size_type>(t.size());
   for (const T& v : t) {
@@ -218,8 +257,8 @@ omstream_enable_if_t<!std::is_scalar_v<T>, Ob> operator<<(
 }
 
 template <typename T, typename Ib>
-imstream_enable_if_t<!std::is_scalar_v<T>, Ib> operator>>(imstream<Ib>& s,
-                                                          std::vector<T>& t) {
+imstream_enable_if_t<!IsTriviallySerializableV<T>, Ib> operator>>(
+    imstream<Ib>& s, std::vector<T>& t) {
   typename Ib::size_type size;
   s >> size;
   if (!data_was_read(s)) {
@@ -236,35 +275,35 @@ imstream_enable_if_t<!std::is_scalar_v<T>, Ib> operator>>(imstream<Ib>& s,
 }
 
 template <size_t N, typename T, typename Ob>
-omstream_enable_if_t<std::is_scalar_v<T>, Ob> operator<<(omstream<Ob>& s,
-                                                         T const (&t)[N]) {
+omstream_enable_if_t<IsTriviallySerializableV<T>, Ob> operator<<(
+    omstream<Ob>& s, T const (&t)[N]) {
   s.write(reinterpret_cast<uint8_t const*>(t), N * sizeof(T));
   return s;
 }
 
 template <size_t N, typename T, typename Ib>
-imstream_enable_if_t<std::is_scalar_v<T>, Ib> operator>>(imstream<Ib>& s,
-                                                         T (&t)[N]) {
+imstream_enable_if_t<IsTriviallySerializableV<T>, Ib> operator>>(
+    imstream<Ib>& s, T (&t)[N]) {
   s.read(reinterpret_cast<uint8_t*>(t), N * sizeof(T));
   return s;
 }
 
 template <size_t N, typename T, typename Ob>
-omstream_enable_if_t<std::is_scalar_v<T>, Ob> operator<<(
+omstream_enable_if_t<IsTriviallySerializableV<T>, Ob> operator<<(
     omstream<Ob>& s, const std::array<T, N>& t) {
   s.write(reinterpret_cast<uint8_t const*>(t.data()), t.size() * sizeof(T));
   return s;
 }
 
 template <size_t N, typename T, typename Ib>
-imstream_enable_if_t<std::is_scalar_v<T>, Ib> operator>>(imstream<Ib>& s,
-                                                         std::array<T, N>& t) {
+imstream_enable_if_t<IsTriviallySerializableV<T>, Ib> operator>>(
+    imstream<Ib>& s, std::array<T, N>& t) {
   s.read(reinterpret_cast<uint8_t*>(t.data()), t.size() * sizeof(T));
   return s;
 }
 
 template <size_t N, typename T, typename Ob>
-omstream_enable_if_t<!std::is_scalar_v<T>, Ob> operator<<(
+omstream_enable_if_t<!IsTriviallySerializableV<T>, Ob> operator<<(
     omstream<Ob>& s, const std::array<T, N>& t) {
   for (const T& v : t) {
     s << v;
@@ -273,8 +312,8 @@ omstream_enable_if_t<!std::is_scalar_v<T>, Ob> operator<<(
 }
 
 template <size_t N, typename T, typename Ib>
-imstream_enable_if_t<!std::is_scalar_v<T>, Ib> operator>>(imstream<Ib>& s,
-                                                          std::array<T, N>& t) {
+imstream_enable_if_t<!IsTriviallySerializableV<T>, Ib> operator>>(
+    imstream<Ib>& s, std::array<T, N>& t) {
   for (auto& v : t) {
     s >> v;
     if (!data_was_read(s)) {
@@ -18,7 +18,9 @@
 #define AETHER_MSTREAM_BUFFERS_H_
 
 #include <vector>
+#include <cassert>
 #include <cstdint>
+#include <cstring>
 
 #include "aether/mstream.h"
 #include "aether/memory_buffer.h"
@@ -42,6 +44,222 @@ struct VectorWriter {
   }
 };
 
+/**
+ * \brief OBuffer counting the bytes written, without writing them.
+ * The first pass of two-pass serialization, it reuses the same operator<<
+ * overloads to get the exact encoded size. Sizes of SizedField values are
+ * recorded on the way to be reused by the write pass.
+ */
+template <typename SizeType = std::uint32_t>
+struct SizeCounter {
+  using size_type = SizeType;
+
+  std::size_t size_ = 0;
+  // SizedField value sizes in the write order
+  std::vector<std::size_t> field_sizes_;
+
+  size_t write(void const* /* data */, size_t size) {
+    size_ += size;
+    return size;
+  }
+
+  std::size_t size() const { return size_; }
+};
+
+/**
+ * \brief OBuffer writing into preallocated memory.
+ * The memory must be large enough, use SizeCounter to get the size. Pass the
+ * counter's field sizes to not compute SizedField sizes again.
+ */
+template <typename SizeType = std::uint32_t>
+struct FixedBufferWriter {
+  using size_type = SizeType;
+
+  std::uint8_t* data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+  std::vector<std::size_t> const* field_sizes_ = nullptr;
+  std::size_t next_field_ = 0;
+
+  FixedBufferWriter(std::uint8_t* data, std::size_t size,
+                    std::vector<std::size_t> const* field_sizes = nullptr)
+      : data_{data}, size_{size}, field_sizes_{field_sizes} {}
+
+  size_t write(void const* data, size_t size) {
+    assert((offset_ + size) <= size_);
+    std::memcpy(data_ + offset_, data, size);
+    offset_ += size;
+    return size;
+  }
+};
+
+/**
+ * \brief Exact size of values serialized with SizeType.
+ */
+template <typename SizeType = std::uint32_t, typename... TArgs>
+std::size_t SerializedSize(TArgs const&... args) {
+  auto counter = SizeCounter<SizeType>{};
+  auto os = omstream{counter};
+  (os << ... << args);
+  return counter.size();
+}
+
+/**
+ * \brief Serialize values to the end of data with one allocation.
+ * The size is computed first, then values are written into resized data.
+ */
+template <typename SizeType = std::uint32_t, typename... TArgs>
+void AppendSerialized(std::vector<std::uint8_t>& data, TArgs const&... args) {
+  auto counter = SizeCounter<SizeType>{};
+  {
+    auto os = omstream{counter};
+    (os << ... << args);
+  }
+  auto size = counter.size();
+  auto offset = data.size();
+  data.resize(offset + size);
+  auto writer = FixedBufferWriter<SizeType>{data.data() + offset, size,
+                                            &counter.field_sizes_};
+  auto os = omstream{writer};
+  (os << ... << args);
+  assert(writer.offset_ == size);
+  assert(writer.next_field_ == counter.field_sizes_.size());
+}
+
+/**
+ * \brief Nested field serialized with its size in front.
+ * The size is precomputed, so the field is written directly to the stream
+ * without a temporary buffer. It's the same layout as a std::vector<uint8_t>
+ * with the field's serialized data.
+ * AppendSerialized counts each field once, even nested ones. Other OBuffers
+ * count the field's size on each write, so nested fields cost a counting pass
+ * per level.
+ */
+template <typename T>
+struct SizedField {
+  T& value;
+};
+
+template <typename T>
+SizedField<T const> WithSize(T const& value) {
+  return SizedField<T const>{value};
+}
+
+template <typename T>
+SizedField<T> WithSize(T& value) {
+  return SizedField<T>{value};
+}
+
+template <typename T, typename Ob>
+omstream<Ob>& operator<<(omstream<Ob>& s, SizedField<T> const& field) {
+  using size_type = typename Ob::size_type;
+  s << static_cast<size_type>(SerializedSize<size_type>(field.value));
+  s << field.value;
+  return s;
+}
+
+// the field is counted in place and its size is recorded for the write pass
+template <typename T, typename SizeType>
+omstream<SizeCounter<SizeType>>& operator<<(
+    omstream<SizeCounter<SizeType>>& s, SizedField<T> const& field) {
+  auto& field_sizes = s.ob_.field_sizes_;
+  auto index = field_sizes.size();
+  field_sizes.push_back(0);
+  auto start = s.ob_.size();
+  s << field.value;
+  field_sizes[index] = s.ob_.size() - start;
+  s << static_cast<SizeType>(field_sizes[index]);
+  return s;
+}
+
+template <typename T, typename SizeType>
+omstream<FixedBufferWriter<SizeType>>& operator<<(
+    omstream<FixedBufferWriter<SizeType>>& s, SizedField<T> const& field) {
+  auto& writer = s.ob_;
+  if (writer.field_sizes_ == nullptr) {
+    s << static_cast<SizeType>(SerializedSize<SizeType>(field.value));
+  } else {
+    assert(writer.next_field_ < writer.field_sizes_->size());
+    s << static_cast<SizeType>((*writer.field_sizes_)[writer.next_field_++]);
+  }
+  s << field.value;
+  return s;
+}
+
+/**
+ * \brief IBuffer over a memory span, it never reads past the span's end.
+ */
+template <typename SizeType = std::uint32_t>
+struct SpanReader {
+  using size_type = SizeType;
+
+  std::uint8_t const* data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+  ReadResult result_ = ReadResult::kYes;
+
+  SpanReader(std::uint8_t const* data, std::size_t size)
+      : data_{data}, size_{size} {}
+
+  size_t read(void* data, size_t size, size_t /* min_size */) {
+    if (offset_ + size > size_) {
+      result_ = ReadResult::kNo;
+      return 0;
+    }
+    std::memcpy(data, data_ + offset_, size);
+    offset_ += size;
+    result_ = ReadResult::kYes;
+    return size;
+  }
+
+  ReadResult result() const { return result_; }
+  void result(ReadResult result) { result_ = result; }
+
+  std::uint8_t const* current() const { return data_ + offset_; }
+  std::size_t available() const { return size_ - offset_; }
+  void skip(std::size_t size) { offset_ += size; }
+};
+
+/**
+ * \brief Reads the field within its size.
+ * The field can't read past its size, and the unread rest of it is skipped,
+ * e.g. fields added by a newer version. The read fails if the size is more
+ * than the data or the field needs more data than its size.
+ */
+template <typename T, typename Ib>
+imstream<Ib>& operator>>(imstream<Ib>& s, SizedField<T> const& field) {
+  typename Ib::size_type size_value{};
+  s >> size_value;
+  if (!data_was_read(s)) {
+    return s;
+  }
+  auto size = static_cast<std::size_t>(size_value);
+
+  if constexpr (HasContiguousRead<Ib>::value) {
+    if (size > s.ib_.available()) {
+      s.result(ReadResult::kNo);
+      return s;
+    }
+    auto reader = SpanReader<typename Ib::size_type>{s.ib_.current(), size};
+    auto is = imstream{reader};
+    is >> field.value;
+    s.ib_.skip(size);
+    s.result(is.result());
+  } else {
+    // a stream is copied to know where the field ends
+    auto data = std::vector<std::uint8_t>(size);
+    s.read(data.data(), size);
+    if (!data_was_read(s)) {
+      return s;
+    }
+    auto reader = SpanReader<typename Ib::size_type>{data.data(), size};
+    auto is = imstream{reader};
+    is >> field.value;
+    s.result(is.result());
+  }
+  return s;
+}
+
 template <typename SizeType = std::uint32_t>
 struct VectorReader {
   using size_type = SizeType;
@@ -65,6 +283,10 @@ struct VectorReader {
 
   ReadResult result() const { return result_; }
   void result(ReadResult result) { result_ = result; }
+
+  std::uint8_t const* current() const { return data_.data() + offset_; }
+  std::size_t available() const { return data_.size() - offset_; }
+  void skip(std::size_t size) { offset_ += size; }
 };
 
 template <typename SizeType = std::uint32_t>
@@ -17,9 +17,12 @@
 #ifndef AETHER_OBJ_TYPE_INDEX_H_
 #define AETHER_OBJ_TYPE_INDEX_H_
 
+#include <atomic>
+
 namespace ae {
 struct TypeIndexBase {
-  inline static int index{};
+  // types may be indexed first from different threads
+  inline static std::atomic<int> index{};
 };
 
 template <typename T>
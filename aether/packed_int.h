@@ -21,6 +21,7 @@
 #include <array>
 #include <limits>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 #include "aether/mstream.h"
@@ -192,6 +193,9 @@ struct Packed {
   using PrevPacked = Packed<PrevType, MinStoredType, MinMaxStoredValue>;
 
   static constexpr ValueType kUpper = LimitType::kUpper;
+  // max encoded size
+  static constexpr std::size_t kMaxSize =
+      PrevPacked::kMaxSize + sizeof(PrevType);
 
 #pragma pack(push, 1)
   union Storage {
@@ -257,6 +261,95 @@ struct Packed {
     PrevPacked{value.st.low}.Serialize(os);
   }
 
+  /**
+   * \brief Encoded size of the value.
+   */
+  std::size_t Size() const {
+    constexpr auto prev_upper = PrevPacked::kUpper;
+
+    // high part is always above previous ranges, so all of them are used
+    if (value.value >= prev_upper) {
+      return kMaxSize;
+    }
+    return PrevPacked{value.st.low}.Size();
+  }
+
+  /**
+   * \brief Encode the same way as Serialize into contiguous memory.
+   * data must have at least kMaxSize bytes.
+   * \return count of bytes written.
+   */
+  std::size_t Encode(std::uint8_t* data) const {
+    constexpr auto prev_upper = PrevPacked::kUpper;
+
+    if (value.value >= prev_upper) {
+      auto modified = value;
+      modified.value -= prev_upper;
+      auto size = PrevPacked{modified.st.high + prev_upper}.Encode(data);
+      std::memcpy(data + size, &modified.st.low, sizeof(PrevType));
+      return size + sizeof(PrevType);
+    }
+    return PrevPacked{value.st.low}.Encode(data);
+  }
+
+  /**
+   * \brief Decode the same way as Deserialize from contiguous memory.
+   * If there are at least kMaxSize bytes, any value fits and decoding goes
+   * without size checks.
+   * \return count of bytes read or 0 if there is not enough data.
+   */
+  std::size_t Decode(std::uint8_t const* data, std::size_t size) {
+    bool next{};
+    if (size >= kMaxSize) {
+      return DecodeImpl<false>(data, size, next);
+    }
+    return DecodeImpl<true>(data, size, next);
+  }
+
+  // decode step for this range, next is set if the value continues in the
+  // next range
+  template <bool kCheckSize>
+  std::size_t DecodeImpl(std::uint8_t const* data, std::size_t size,
+                         bool& next) {
+    constexpr auto prev_upper = PrevPacked::kUpper;
+
+    auto high = PrevPacked{};
+    auto read = high.template DecodeImpl<kCheckSize>(data, size, next);
+    if constexpr (kCheckSize) {
+      if (read == 0) {
+        return 0;
+      }
+    }
+    if (!next) {
+      value.value = static_cast<ValueType>(
+          static_cast<typename PrevPacked::ValueType>(high));
+      return read;
+    }
+    // the value continues only if all previous ranges are used, so the low
+    // part is always at the same offset
+    if constexpr (kCheckSize) {
+      if (size < kMaxSize) {
+        return 0;
+      }
+    }
+    PrevType low;
+    std::memcpy(&low, data + PrevPacked::kMaxSize, sizeof(PrevType));
+    auto v = static_cast<ValueType>(Join(high, low) + prev_upper);
+    next = v >= kUpper;
+    value.value = next ? static_cast<ValueType>(v - kUpper) : v;
+    return kMaxSize;
+  }
+
+  // the same as Storage with high and low parts on little endian hosts, but
+  // kept in a register instead of partial writes to memory
+  static ValueType Join(PrevPacked const& high, PrevType low) {
+    return static_cast<ValueType>(
+        (static_cast<ValueType>(
+             static_cast<typename PrevPacked::ValueType>(high))
+         << std::numeric_limits<PrevType>::digits) |
+        low);
+  }
+
   Storage value;
 };
 
@@ -269,6 +362,7 @@ struct Packed<StoredType, StoredType, MaxValue> {
   using ValueType = typename LimitType::StoredType;
 
   static constexpr ValueType kUpper = LimitType::kUpper;
+  static constexpr std::size_t kMaxSize = sizeof(ValueType);
 
   struct Storage {
     ValueType value;
@@ -303,6 +397,33 @@ struct Packed<StoredType, StoredType, MaxValue> {
     os << value.value;
   }
 
+  std::size_t Size() const { return sizeof(ValueType); }
+
+  std::size_t Encode(std::uint8_t* data) const {
+    std::memcpy(data, &value.value, sizeof(ValueType));
+    return sizeof(ValueType);
+  }
+
+  std::size_t Decode(std::uint8_t const* data, std::size_t size) {
+    bool next{};
+    return DecodeImpl<true>(data, size, next);
+  }
+
+  template <bool kCheckSize>
+  std::size_t DecodeImpl(std::uint8_t const* data, std::size_t size,
+                         bool& next) {
+    if constexpr (kCheckSize) {
+      if (size < sizeof(ValueType)) {
+        return 0;
+      }
+    }
+    ValueType v;
+    std::memcpy(&v, data, sizeof(ValueType));
+    next = v >= kUpper;
+    value.value = next ? static_cast<ValueType>(v - kUpper) : v;
+    return sizeof(ValueType);
+  }
+
   Storage value;
 };
 
@@ -318,6 +439,29 @@ TStream& operator>>(TStream& is, Packed<T, Min, MinMaxVal>& v) {
   return is;
 }
 
+// encoded at once and written with a single write
+template <typename Ob, typename T, typename Min, Min MinMaxVal>
+omstream<Ob>& operator<<(omstream<Ob>& os,
+                         Packed<T, Min, MinMaxVal> const& v) {
+  std::uint8_t data[Packed<T, Min, MinMaxVal>::kMaxSize];
+  os.write(data, v.Encode(data));
+  return os;
+}
+
+// decoded in place from buffers with contiguous memory
+template <typename Ib, typename T, typename Min, Min MinMaxVal>
+std::enable_if_t<HasContiguousRead<Ib>::value, imstream<Ib>&> operator>>(
+    imstream<Ib>& is, Packed<T, Min, MinMaxVal>& v) {
+  auto read = v.Decode(is.ib_.current(), is.ib_.available());
+  if (read == 0) {
+    is.result(ReadResult::kNo);
+    return is;
+  }
+  is.ib_.skip(read);
+  is.result(ReadResult::kYes);
+  return is;
+}
+
 template <typename T1, typename Min1, Min1 MinMaxVal1, typename T2,
           typename Min2, Min2 MinMaxVal2>
 int PackedCompare(Packed<T1, Min1, MinMaxVal1> const& left,
@@ -29,44 +29,65 @@ namespace ae {
  * \brief Struct to apply addition and subtraction operations to ring buffer
  * index.
  * Value is always in range [0, Max) and value overflow leads to
- * start from zero
+ * start from zero.
+ * If Max is a power of two all the arithmetic is done by masking, without any
+ * branches.
  */
 template <typename T, T Max = std::numeric_limits<T>::max()>
 struct RingIndex {
   using type = T;
   static constexpr T max = Max;
+  static constexpr bool kPowerOfTwo = (Max & (Max - 1)) == 0;
+  static constexpr T kMask = static_cast<T>(Max - 1);
 
-  explicit constexpr RingIndex(T val = 0) : value_(val % Max) {}
+  explicit constexpr RingIndex(T val = 0) : value_(Wrap(val)) {}
 
   constexpr void Clockwise(T val) {
-    val = val % Max;
-    if ((Max - val) < value_) {
-      // -1 for zero value
-      value_ = static_cast<T>(val - (Max - value_) - 1);
+    if constexpr (kPowerOfTwo) {
+      value_ = static_cast<T>((value_ + val) & kMask);
     } else {
-      value_ += val;
+      val = val % Max;
+      if ((Max - val) < value_) {
+        // -1 for zero value
+        value_ = static_cast<T>(val - (Max - value_) - 1);
+      } else {
+        value_ += val;
+      }
     }
   }
   constexpr void CounterClockwise(T val) {
-    val = val % Max;
-    if (value_ < val) {
-      value_ = static_cast<T>(Max - (val - value_));
+    if constexpr (kPowerOfTwo) {
+      value_ = static_cast<T>((value_ - val) & kMask);
     } else {
-      value_ -= val;
+      val = val % Max;
+      if (value_ < val) {
+        value_ = static_cast<T>(Max - (val - value_));
+      } else {
+        value_ -= val;
+      }
     }
   }
 
   constexpr T Distance(RingIndex other) const {
-    auto a = Max - value_;
-    auto b = Max - other.value_;
-    if (a >= b) {
-      return static_cast<T>(a - b);
+    if constexpr (kPowerOfTwo) {
+      return static_cast<T>((other.value_ - value_) & kMask);
     } else {
-      return static_cast<T>(a + other.value_);
+      auto a = Max - value_;
+      auto b = Max - other.value_;
+      if (a >= b) {
+        return static_cast<T>(a - b);
+      } else {
+        return static_cast<T>(a + other.value_);
+      }
     }
   }
 
   constexpr RingIndex& operator+=(T val) {
+    if constexpr (kPowerOfTwo) {
+      // negative values are wrapped by the mask as well
+      Clockwise(val);
+      return *this;
+    }
     if constexpr (std::is_signed_v<T>) {
       if (val < 0) {
         CounterClockwise(std::abs(val));
@@ -79,6 +100,10 @@ struct RingIndex {
     return *this;
   }
   constexpr RingIndex& operator-=(T val) {
+    if constexpr (kPowerOfTwo) {
+      CounterClockwise(val);
+      return *this;
+    }
     if constexpr (std::is_signed_v<T>) {
       if (val < 0) {
         Clockwise(std::abs(val));
@@ -92,6 +117,10 @@ struct RingIndex {
   }
 
   friend constexpr RingIndex operator+(RingIndex index, T val) {
+    if constexpr (kPowerOfTwo) {
+      index.Clockwise(val);
+      return index;
+    }
     if constexpr (std::is_signed_v<T>) {
       if (val < 0) {
         index.CounterClockwise(std::abs(val));
@@ -105,6 +134,10 @@ struct RingIndex {
   }
 
   friend constexpr RingIndex operator-(RingIndex index, T val) {
+    if constexpr (kPowerOfTwo) {
+      index.CounterClockwise(val);
+      return index;
+    }
     if constexpr (std::is_signed_v<T>) {
       if (val < 0) {
         index.Clockwise(std::abs(val));
@@ -145,6 +178,14 @@ struct RingIndex {
   explicit constexpr operator T() const { return value_; }
 
  private:
+  static constexpr T Wrap(T val) {
+    if constexpr (kPowerOfTwo) {
+      return static_cast<T>(val & kMask);
+    } else {
+      return static_cast<T>(val % Max);
+    }
+  }
+
   T value_;
 };
 
@@ -19,10 +19,11 @@
 #include "aether/crypto/key_gen.h"
 
 namespace ae {
-ServerKeys::ServerKeys(ServerId server_id, const Key& master_key)
+ServerKeys::ServerKeys(ServerId server_id, const Key& master_key,
+                       CryptoLibProfile crypto_lib_profile)
     : server_id_{server_id}, master_key_{master_key} {
   nonce_.Next();
-  Derive(server_id, master_key, key_number_);
+  Derive(server_id, master_key, key_number_, crypto_lib_profile);
 }
 
 CryptoNonce const& ServerKeys::nonce() const { return nonce_; }
@@ -35,13 +36,15 @@ Key const& ServerKeys::server_to_client() const {
   return server_to_client_key_;
 }
 
-void ServerKeys::Next() { nonce_.Next(); }
+void ServerKeys::set_nonce(CryptoNonce const& nonce) { nonce_ = nonce; }
 
 void ServerKeys::Derive(ServerId server_id, const Key& master_key,
-                        std::uint32_t key_number) {
+                        std::uint32_t key_number,
+                        CryptoLibProfile crypto_lib_profile) {
   [[maybe_unused]] auto res =
       CryptoSyncKeyDerive(master_key, server_id, key_number,
-                          client_to_server_key_, server_to_client_key_);
+                          client_to_server_key_, server_to_client_key_,
+                          crypto_lib_profile);
   assert(res);
 }
 }  // namespace ae
@@ -24,19 +24,22 @@
 #include "aether/packed_int.h"
 #include "aether/crypto/key.h"
 #include "aether/crypto/crypto_nonce.h"
+#include "aether/crypto/crypto_definitions.h"
 
 namespace ae {
 class ServerKeys {
  public:
   ServerKeys() = default;
-  ServerKeys(ServerId server_id, const Key& master_key);
+  ServerKeys(ServerId server_id, const Key& master_key,
+             CryptoLibProfile crypto_lib_profile = kDefaultCryptoLibProfile);
 
   CryptoNonce const& nonce() const;
   Key const& client_to_server() const;
   Key const& server_to_client() const;
 
-  void Next();
+  void set_nonce(CryptoNonce const& nonce);
 
+  // the crypto lib profile is not stored, it's known by the derived keys type
   template <typename T>
   void Serializator(T& s) {
     s & server_id_ & master_key_ & key_number_ & nonce_ &
@@ -45,7 +48,7 @@ class ServerKeys {
 
  private:
   void Derive(ServerId server_id, const Key& master_key,
-              std::uint32_t key_number);
+              std::uint32_t key_number, CryptoLibProfile crypto_lib_profile);
 
   ServerId server_id_{};
   Key master_key_;
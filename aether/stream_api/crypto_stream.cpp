@@ -19,6 +19,10 @@
 #include <cstddef>
 #include <utility>
 
+#include "aether/transport/data_buffer_pool.h"
+
+#include "aether/tele/tele.h"
+
 namespace ae {
 
 CryptoGate::CryptoGate(Ptr<IEncryptProvider> crypto_encrypt,
@@ -27,15 +31,29 @@ CryptoGate::CryptoGate(Ptr<IEncryptProvider> crypto_encrypt,
       crypto_decrypt_{std::move(crypto_decrypt)} {}
 
 void CryptoGate::OnOutData(DataBuffer const& buffer) {
-  auto decrypted = crypto_decrypt_->Decrypt(std::move(buffer));
-  out_data_event_.Emit(std::move(decrypted));
+  // take the buffer out, data may be received again during emit
+  auto decrypted = std::move(decrypted_);
+  if (crypto_decrypt_->DecryptInto(buffer, decrypted)) {
+    out_data_event_.Emit(decrypted);
+  } else {
+    AE_TELED_WARNING("Packet is not authenticated, dropped");
+  }
+  decrypted_ = std::move(decrypted);
 }
 
 ActionView<StreamWriteAction> CryptoGate::Write(DataBuffer&& buffer,
                                                 TimePoint current_time) {
   assert(out_);
-  auto encrypted = crypto_encrypt_->Encrypt(std::move(buffer));
-  return out_->Write(std::move(encrypted), current_time);
+  auto encrypted_size = buffer.size() + crypto_encrypt_->EncryptOverhead();
+  if (buffer.capacity() < encrypted_size) {
+    // move to a pooled buffer instead of reallocation
+    auto encrypt_buffer = GetDataBuffer(encrypted_size);
+    encrypt_buffer.assign(std::begin(buffer), std::end(buffer));
+    RecycleDataBuffer(std::move(buffer));
+    buffer = std::move(encrypt_buffer);
+  }
+  crypto_encrypt_->EncryptInPlace(buffer);
+  return out_->Write(std::move(buffer), current_time);
 }
 
 void CryptoGate::LinkOut(OutGate& out) {
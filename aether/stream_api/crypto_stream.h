@@ -24,6 +24,12 @@
 #include "aether/crypto/icrypto_provider.h"
 
 namespace ae {
+/**
+ * \brief Encrypts written data and decrypts received one.
+ * Written buffers are encrypted in place, a buffer without EncryptOverhead
+ * bytes of spare capacity is copied to a pooled one first. Received data is
+ * decrypted into the buffer reused between packets.
+ */
 class CryptoGate final : public ByteGate {
   friend class CryptoStream;
 
@@ -43,6 +49,7 @@ class CryptoGate final : public ByteGate {
 
   Ptr<IEncryptProvider> crypto_encrypt_;
   Ptr<IDecryptProvider> crypto_decrypt_;
+  DataBuffer decrypted_;
 };
 }  // namespace ae
 
@@ -0,0 +1,278 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/stream_api/fec_gate.h"
+
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "aether/mstream.h"
+#include "aether/mstream_buffers.h"
+
+#include "aether/tele/tele.h"
+
+namespace ae {
+// group id and packet index
+static constexpr std::size_t kFecHeaderSize = 3;
+// header, data count of the group and xor of packet sizes in parity
+static constexpr std::size_t kFecOverhead = kFecHeaderSize + 1 + 2;
+// count of groups waiting for lost packets
+static constexpr std::size_t kFecReceivedGroups = 4;
+
+FecGate::FlushAction::FlushAction(ActionContext action_context, FecGate& gate)
+    : Action{action_context}, gate_{&gate} {}
+
+TimePoint FecGate::FlushAction::Update(TimePoint current_time) {
+  return gate_->FlushIdle(current_time);
+}
+
+void FecGate::FlushAction::Wake() { Action::Trigger(); }
+
+FecGate::FecGate(ActionContext action_context, FecConfig config)
+    : config_{config},
+      group_id_{},
+      index_{},
+      parities_(config_.parity_count),
+      parity_sizes_(config_.parity_count),
+      flush_action_{action_context, *this},
+      restored_count_{} {
+  assert((config_.data_count > 0) && (config_.parity_count > 0));
+}
+
+ActionView<StreamWriteAction> FecGate::Write(DataBuffer&& buffer,
+                                             TimePoint current_time) {
+  assert(out_);
+
+  AddToParity(buffer);
+
+  DataBuffer packet;
+  packet.reserve(kFecHeaderSize + buffer.size());
+  auto writer = VectorWriter<>{packet};
+  auto os = omstream{writer};
+  os << group_id_ << index_;
+  os.write(buffer.data(), buffer.size());
+
+  auto write_action = out_->Write(std::move(packet), current_time);
+
+  last_write_time_ = current_time;
+  if (++index_ == config_.data_count) {
+    WriteParity(current_time);
+  } else {
+    // wait for the rest of the group or flush it
+    flush_action_.Wake();
+  }
+  return write_action;
+}
+
+void FecGate::LinkOut(OutGate& out) {
+  out_ = &out;
+  out_data_subscription_ = out.out_data_event().Subscribe(
+      [this](DataBuffer const& buffer) { OnPacketReceived(buffer); });
+
+  gate_update_subscription_ = out.gate_update_event().Subscribe(
+      [this]() { gate_update_event_.Emit(); });
+
+  gate_update_event_.Emit();
+}
+
+StreamInfo FecGate::stream_info() const {
+  assert(out_);
+  auto s_info = out_->stream_info();
+  s_info.max_element_size = s_info.max_element_size > kFecOverhead
+                                ? s_info.max_element_size - kFecOverhead
+                                : 0;
+  return s_info;
+}
+
+void FecGate::AddToParity(DataBuffer const& buffer) {
+  auto parity_index = index_ % config_.parity_count;
+  auto& parity = parities_[parity_index];
+  if (parity.size() < buffer.size()) {
+    parity.resize(buffer.size(), 0);
+  }
+  for (std::size_t i = 0; i < buffer.size(); ++i) {
+    parity[i] ^= buffer[i];
+  }
+  parity_sizes_[parity_index] ^= static_cast<std::uint16_t>(buffer.size());
+}
+
+void FecGate::WriteParity(TimePoint current_time) {
+  for (std::uint8_t i = 0; i < config_.parity_count; ++i) {
+    auto& parity = parities_[i];
+    // a partial group may have no packets for this parity
+    if (i < index_) {
+      DataBuffer packet;
+      packet.reserve(kFecOverhead + parity.size());
+      auto writer = VectorWriter<>{packet};
+      auto os = omstream{writer};
+      os << group_id_ << static_cast<std::uint8_t>(config_.data_count + i)
+         << index_ << parity_sizes_[i];
+      os.write(parity.data(), parity.size());
+      // parity is not controlled, the lost data is repeated anyway
+      out_->Write(std::move(packet), current_time);
+    }
+
+    parity.clear();
+    parity_sizes_[i] = 0;
+  }
+  index_ = 0;
+  ++group_id_;
+}
+
+TimePoint FecGate::FlushIdle(TimePoint current_time) {
+  if (index_ == 0) {
+    return current_time;
+  }
+  auto flush_time = last_write_time_ + config_.flush_timeout;
+  if (current_time < flush_time) {
+    return flush_time;
+  }
+  AE_TELED_DEBUG("Fec flush partial group {} of {} packets", group_id_,
+                 index_);
+  WriteParity(current_time);
+  return current_time;
+}
+
+void FecGate::OnPacketReceived(DataBuffer const& buffer) {
+  if (buffer.size() < kFecHeaderSize) {
+    AE_TELED_ERROR("Fec packet is too small {}", buffer.size());
+    return;
+  }
+
+  auto reader = VectorReader<>{buffer};
+  auto is = imstream{reader};
+  std::uint16_t group_id{};
+  std::uint8_t index{};
+  is >> group_id >> index;
+
+  if (index >= (config_.data_count + config_.parity_count)) {
+    AE_TELED_ERROR("Fec packet index {} is out of group", index);
+    return;
+  }
+
+  auto& group = GetGroup(group_id);
+  if (group.received[index]) {
+    return;
+  }
+  group.received[index] = true;
+  group.packets[index] = DataBuffer{
+      std::next(std::begin(buffer), kFecHeaderSize), std::end(buffer)};
+
+  std::vector<DataBuffer> restored;
+  Restore(group, restored);
+
+  if (restored.empty()) {
+    // the only emit, the group is not used after it
+    if (index < config_.data_count) {
+      out_data_event_.Emit(group.packets[index]);
+    }
+    return;
+  }
+
+  // group may be changed during emit, receiver writes back synchronously
+  if (index < config_.data_count) {
+    auto payload = group.packets[index];
+    out_data_event_.Emit(payload);
+  }
+  for (auto const& packet : restored) {
+    out_data_event_.Emit(packet);
+  }
+}
+
+FecGate::Group& FecGate::GetGroup(std::uint16_t id) {
+  auto it = std::find_if(std::begin(received_groups_),
+                         std::end(received_groups_),
+                         [id](auto const& group) { return group.id == id; });
+  if (it != std::end(received_groups_)) {
+    return *it;
+  }
+
+  if (received_groups_.size() == kFecReceivedGroups) {
+    received_groups_.pop_front();
+  }
+  auto packets_count =
+      static_cast<std::size_t>(config_.data_count + config_.parity_count);
+  return received_groups_.emplace_back(
+      Group{id, config_.data_count, std::vector<DataBuffer>(packets_count),
+            std::vector<bool>(packets_count, false)});
+}
+
+void FecGate::Restore(Group& group, std::vector<DataBuffer>& restored) {
+  for (std::uint8_t p = 0; p < config_.parity_count; ++p) {
+    auto parity_index = static_cast<std::size_t>(config_.data_count + p);
+    if (!group.received[parity_index]) {
+      continue;
+    }
+
+    auto const& parity_packet = group.packets[parity_index];
+    if (parity_packet.size() < 3) {
+      continue;
+    }
+    auto reader = VectorReader<>{parity_packet};
+    auto is = imstream{reader};
+    std::uint8_t data_count{};
+    std::uint16_t size{};
+    is >> data_count >> size;
+    if ((data_count == 0) || (data_count > config_.data_count)) {
+      AE_TELED_ERROR("Fec parity data count {} is broken", data_count);
+      continue;
+    }
+    // the group may be closed before it's full
+    group.data_count = data_count;
+
+    std::size_t missed_count = 0;
+    std::size_t missed_index = 0;
+    for (std::size_t i = p; i < group.data_count; i += config_.parity_count) {
+      if (!group.received[i]) {
+        ++missed_count;
+        missed_index = i;
+      }
+    }
+    if (missed_count != 1) {
+      continue;
+    }
+
+    auto data = DataBuffer{std::next(std::begin(parity_packet), 3),
+                           std::end(parity_packet)};
+
+    for (std::size_t i = p; i < group.data_count; i += config_.parity_count) {
+      if (i == missed_index) {
+        continue;
+      }
+      auto const& packet = group.packets[i];
+      for (std::size_t j = 0; (j < packet.size()) && (j < data.size()); ++j) {
+        data[j] ^= packet[j];
+      }
+      size ^= static_cast<std::uint16_t>(packet.size());
+    }
+    if (size > data.size()) {
+      AE_TELED_ERROR("Fec restored packet size {} is broken", size);
+      continue;
+    }
+    data.resize(size);
+
+    AE_TELED_DEBUG("Fec restored packet {} in group {}", missed_index,
+                   group.id);
+    ++restored_count_;
+    group.received[missed_index] = true;
+    group.packets[missed_index] = data;
+    restored.emplace_back(std::move(data));
+  }
+}
+
+}  // namespace ae
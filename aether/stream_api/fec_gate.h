@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_STREAM_API_FEC_GATE_H_
+#define AETHER_STREAM_API_FEC_GATE_H_
+
+#include <deque>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+#include "aether/common.h"
+#include "aether/actions/action.h"
+#include "aether/actions/action_context.h"
+
+#include "aether/stream_api/istream.h"
+
+#include "aether/transport/data_buffer.h"
+
+namespace ae {
+struct FecConfig {
+  std::uint8_t data_count;    //< count of data packets in group
+  std::uint8_t parity_count;  //< count of parity packets for each group
+  // time without writes after which parity of a partial group is sent
+  Duration flush_timeout = std::chrono::milliseconds{20};
+};
+
+/**
+ * \brief Forward error correction for packets.
+ * Packets are written in groups of data_count, each group is followed by
+ * parity_count XOR parity packets. Parity packet j covers data packets with
+ * index % parity_count == j, so one lost packet in each of that subsets is
+ * restored on the receiving side without waiting for the repeat.
+ * If the writer goes idle for flush_timeout the partial group is closed with
+ * its parity, so the tail of a burst is protected too.
+ * Redundancy ratio is parity_count / data_count.
+ * Both sides must use the same config.
+ */
+class FecGate final : public ByteGate {
+  struct Group {
+    std::uint16_t id;
+    std::uint8_t data_count;
+    std::vector<DataBuffer> packets;
+    std::vector<bool> received;
+  };
+
+  class FlushAction final : public Action<FlushAction> {
+   public:
+    FlushAction(ActionContext action_context, FecGate& gate);
+
+    TimePoint Update(TimePoint current_time) override;
+    void Wake();
+
+   private:
+    FecGate* gate_;
+  };
+
+ public:
+  FecGate(ActionContext action_context, FecConfig config);
+
+  AE_CLASS_NO_COPY_MOVE(FecGate)
+
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint current_time) override;
+
+  void LinkOut(OutGate& out) override;
+
+  StreamInfo stream_info() const override;
+
+  std::size_t restored_count() const { return restored_count_; }
+
+ private:
+  void AddToParity(DataBuffer const& buffer);
+  void WriteParity(TimePoint current_time);
+  TimePoint FlushIdle(TimePoint current_time);
+
+  void OnPacketReceived(DataBuffer const& buffer);
+  Group& GetGroup(std::uint16_t id);
+  void Restore(Group& group, std::vector<DataBuffer>& restored);
+
+  FecConfig config_;
+
+  std::uint16_t group_id_;
+  std::uint8_t index_;
+  std::vector<DataBuffer> parities_;
+  std::vector<std::uint16_t> parity_sizes_;
+  TimePoint last_write_time_;
+  FlushAction flush_action_;
+
+  std::deque<Group> received_groups_;
+  std::size_t restored_count_;
+};
+}  // namespace ae
+
+#endif  // AETHER_STREAM_API_FEC_GATE_H_
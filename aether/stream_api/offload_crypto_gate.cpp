@@ -0,0 +1,247 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/stream_api/offload_crypto_gate.h"
+
+#include <utility>
+
+#include "aether/tele/tele.h"
+
+namespace ae {
+namespace _internal {
+inline bool IsDone(std::atomic_bool const& done) {
+  return done.load(std::memory_order_acquire);
+}
+
+inline void SetDone(std::atomic_bool& done) {
+  done.store(true, std::memory_order_release);
+}
+}  // namespace _internal
+
+OffloadCryptoGate::OffloadWriteAction::OffloadWriteAction(
+    ActionContext action_context, std::shared_ptr<Job> job,
+    TimePoint current_time)
+    : StreamWriteAction(action_context),
+      job_{std::move(job)},
+      current_time_{current_time} {
+  state_ = State::kQueued;
+}
+
+TimePoint OffloadCryptoGate::OffloadWriteAction::Update(
+    TimePoint current_time) {
+  if (state_.changed()) {
+    switch (state_.Acquire()) {
+      case State::kDone:
+        Action::Result(*this);
+        break;
+      case State::kStopped:
+        Action::Stop(*this);
+        break;
+      default:
+        break;
+    }
+  }
+
+  return current_time;
+}
+
+void OffloadCryptoGate::OffloadWriteAction::Stop() {
+  if (write_action_) {
+    write_action_->Stop();
+  } else {
+    // the job may still run on the worker, its result is dropped
+    is_sent_ = true;
+    state_ = State::kStopped;
+  }
+  Action::Trigger();
+}
+
+void OffloadCryptoGate::OffloadWriteAction::Send(ByteIGate& out_gate) {
+  is_sent_ = true;
+  write_action_ = out_gate.Write(std::move(job_->data), current_time_);
+  job_.reset();
+  if (!write_action_) {
+    state_ = State::kDone;
+    Action::Trigger();
+    return;
+  }
+
+  state_changed_subscription_ =
+      write_action_->state().changed_event().Subscribe(
+          [this](auto state) { state_ = state; });
+
+  write_action_subscription_.Push(
+      write_action_->SubscribeOnResult([this](auto const&) {
+        state_.Acquire();
+        Action::Result(*this);
+      }),
+      write_action_->SubscribeOnError([this](auto const&) {
+        state_.Acquire();
+        Action::Error(*this);
+      }),
+      write_action_->SubscribeOnStop([this](auto const&) {
+        state_.Acquire();
+        Action::Stop(*this);
+      }));
+}
+
+bool OffloadCryptoGate::OffloadWriteAction::is_ready() const {
+  return _internal::IsDone(job_->done);
+}
+
+bool OffloadCryptoGate::OffloadWriteAction::is_sent() const {
+  return is_sent_;
+}
+
+OffloadCryptoGate::DrainAction::DrainAction(ActionContext action_context,
+                                            OffloadCryptoGate& gate)
+    : Action{action_context}, gate_{&gate} {}
+
+TimePoint OffloadCryptoGate::DrainAction::Update(TimePoint current_time) {
+  gate_->Drain();
+  return current_time;
+}
+
+OffloadCryptoGate::OffloadCryptoGate(ActionContext action_context,
+                                     Ptr<CryptoWorkerPool> worker_pool,
+                                     Ptr<IEncryptProvider> crypto_encrypt,
+                                     Ptr<IDecryptProvider> crypto_decrypt,
+                                     std::size_t offload_threshold)
+    : action_context_{action_context},
+      worker_pool_{std::move(worker_pool)},
+      crypto_encrypt_{std::move(crypto_encrypt)},
+      crypto_decrypt_{std::move(crypto_decrypt)},
+      offload_threshold_{offload_threshold},
+      drain_action_{action_context_, *this} {}
+
+ActionView<StreamWriteAction> OffloadCryptoGate::Write(DataBuffer&& buffer,
+                                                       TimePoint current_time) {
+  assert(out_);
+  auto detached = IEncryptProvider::DetachedEncrypt{};
+  if (buffer.size() >= offload_threshold_) {
+    detached = crypto_encrypt_->Detach();
+  }
+  // all queued packets are passed already
+  auto in_order = write_jobs_.empty() || write_jobs_.back().is_sent();
+  if (!detached && in_order) {
+    crypto_encrypt_->EncryptInPlace(buffer);
+    return out_->Write(std::move(buffer), current_time);
+  }
+
+  auto job = std::make_shared<Job>();
+  job->data = std::move(buffer);
+  if (detached) {
+    worker_pool_->Post([job, detached{std::move(detached)},
+                        trigger{action_context_.get_trigger()}]() mutable {
+      detached(job->data);
+      _internal::SetDone(job->done);
+      trigger.Trigger();
+    });
+  } else {
+    // wait in the queue behind offloaded packets
+    crypto_encrypt_->EncryptInPlace(job->data);
+    _internal::SetDone(job->done);
+  }
+
+  auto action_it = write_jobs_.emplace(std::end(write_jobs_), action_context_,
+                                       std::move(job), current_time);
+  write_jobs_subscription_.Push(action_it->FinishedEvent().Subscribe(
+      [this, action_it]() { write_jobs_.erase(action_it); }));
+
+  Drain();
+  return *action_it;
+}
+
+void OffloadCryptoGate::LinkOut(OutGate& out) {
+  out_ = &out;
+  out_data_subscription_ = out.out_data_event().Subscribe(
+      [this](DataBuffer const& buffer) { OnOutData(buffer); });
+
+  gate_update_subscription_ = out.gate_update_event().Subscribe(
+      [this]() { gate_update_event_.Emit(); });
+  gate_update_event_.Emit();
+}
+
+StreamInfo OffloadCryptoGate::stream_info() const {
+  assert(out_);
+  auto s_info = out_->stream_info();
+  s_info.max_element_size =
+      s_info.max_element_size > crypto_encrypt_->EncryptOverhead()
+          ? s_info.max_element_size - crypto_encrypt_->EncryptOverhead()
+          : 0;
+  return s_info;
+}
+
+void OffloadCryptoGate::OnOutData(DataBuffer const& buffer) {
+  auto detached = IDecryptProvider::DetachedDecrypt{};
+  if (buffer.size() >= offload_threshold_) {
+    detached = crypto_decrypt_->Detach();
+  }
+  if (!detached && read_jobs_.empty()) {
+    // take the buffer out, data may be received again during emit
+    auto decrypted = std::move(decrypted_);
+    if (crypto_decrypt_->DecryptInto(buffer, decrypted)) {
+      out_data_event_.Emit(decrypted);
+    } else {
+      AE_TELED_WARNING("Packet is not authenticated, dropped");
+    }
+    decrypted_ = std::move(decrypted);
+    return;
+  }
+
+  auto job = std::make_shared<Job>();
+  job->data = buffer;
+  if (detached) {
+    worker_pool_->Post([job, detached{std::move(detached)},
+                        trigger{action_context_.get_trigger()}]() mutable {
+      job->authenticated = detached(job->data, job->decrypted);
+      _internal::SetDone(job->done);
+      trigger.Trigger();
+    });
+  } else {
+    job->authenticated =
+        crypto_decrypt_->DecryptInto(job->data, job->decrypted);
+    _internal::SetDone(job->done);
+  }
+  read_jobs_.emplace_back(std::move(job));
+
+  Drain();
+}
+
+void OffloadCryptoGate::Drain() {
+  if (out_ != nullptr) {
+    for (auto& action : write_jobs_) {
+      if (action.is_sent()) {
+        continue;
+      }
+      if (!action.is_ready()) {
+        break;
+      }
+      action.Send(*out_);
+    }
+  }
+
+  while (!read_jobs_.empty() && _internal::IsDone(read_jobs_.front()->done)) {
+    auto job = std::move(read_jobs_.front());
+    read_jobs_.pop_front();
+    if (!job->authenticated) {
+      AE_TELED_WARNING("Packet is not authenticated, dropped");
+      continue;
+    }
+    out_data_event_.Emit(job->decrypted);
+  }
+}
+}  // namespace ae
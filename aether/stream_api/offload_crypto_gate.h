@@ -0,0 +1,128 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_STREAM_API_OFFLOAD_CRYPTO_GATE_H_
+#define AETHER_STREAM_API_OFFLOAD_CRYPTO_GATE_H_
+
+#include <list>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+#include "aether/common.h"
+#include "aether/obj/ptr.h"
+
+#include "aether/actions/action.h"
+#include "aether/actions/action_view.h"
+#include "aether/actions/action_context.h"
+#include "aether/events/multi_subscription.h"
+
+#include "aether/crypto/icrypto_provider.h"
+#include "aether/crypto/crypto_worker_pool.h"
+
+#include "aether/stream_api/istream.h"
+
+namespace ae {
+/**
+ * \brief CryptoGate which encrypts and decrypts large packets on a worker
+ * pool. Key and nonce are taken on the action thread in the write order.
+ * Packets are passed on in the order they were written or received, the
+ * completed jobs are picked up on the action thread. Packets smaller than the
+ * threshold and packets of providers without Detach are processed in place.
+ */
+class OffloadCryptoGate final : public ByteGate {
+  // packet shared with the worker
+  struct Job {
+    DataBuffer data;
+    DataBuffer decrypted;
+    bool authenticated{};
+    std::atomic_bool done{false};
+  };
+
+  class OffloadWriteAction final : public StreamWriteAction {
+   public:
+    OffloadWriteAction(ActionContext action_context, std::shared_ptr<Job> job,
+                       TimePoint current_time);
+
+    AE_CLASS_MOVE_ONLY(OffloadWriteAction)
+
+    TimePoint Update(TimePoint current_time) override;
+    void Stop() override;
+    void Send(ByteIGate& out_gate);
+    bool is_ready() const;
+    // sent or stopped before send
+    bool is_sent() const;
+
+   private:
+    std::shared_ptr<Job> job_;
+    TimePoint current_time_;
+    bool is_sent_{false};
+
+    ActionView<StreamWriteAction> write_action_;
+
+    Subscription state_changed_subscription_;
+    MultiSubscription write_action_subscription_;
+  };
+
+  // picks up completed jobs on the action thread
+  class DrainAction final : public Action<DrainAction> {
+   public:
+    DrainAction(ActionContext action_context, OffloadCryptoGate& gate);
+
+    TimePoint Update(TimePoint current_time) override;
+
+   private:
+    OffloadCryptoGate* gate_;
+  };
+
+ public:
+  static constexpr std::size_t kDefaultOffloadThreshold = 4 * 1024;
+
+  OffloadCryptoGate(ActionContext action_context,
+                    Ptr<CryptoWorkerPool> worker_pool,
+                    Ptr<IEncryptProvider> crypto_encrypt,
+                    Ptr<IDecryptProvider> crypto_decrypt,
+                    std::size_t offload_threshold = kDefaultOffloadThreshold);
+
+  AE_CLASS_NO_COPY_MOVE(OffloadCryptoGate)
+
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint current_time) override;
+
+  void LinkOut(OutGate& out) override;
+
+  StreamInfo stream_info() const override;
+
+ private:
+  void OnOutData(DataBuffer const& buffer);
+  void Drain();
+
+  ActionContext action_context_;
+  Ptr<CryptoWorkerPool> worker_pool_;
+  Ptr<IEncryptProvider> crypto_encrypt_;
+  Ptr<IDecryptProvider> crypto_decrypt_;
+  std::size_t offload_threshold_;
+
+  DataBuffer decrypted_;
+  std::list<OffloadWriteAction> write_jobs_;
+  MultiSubscription write_jobs_subscription_;
+  std::deque<std::shared_ptr<Job>> read_jobs_;
+  DrainAction drain_action_;
+};
+}  // namespace ae
+
+#endif  // AETHER_STREAM_API_OFFLOAD_CRYPTO_GATE_H_
@@ -17,6 +17,7 @@
 #include "aether/stream_api/safe_stream.h"
 
 #include <cstddef>
+#include <iterator>
 #include <utility>
 
 #include "aether/stream_api/safe_stream/sending_data_action.h"
@@ -122,6 +123,7 @@ void SafeStream::SafeStreamOutGate::LinkOut(OutGate& gate) {
 
 SafeStream::SafeStream(ActionContext action_context, SafeStreamConfig config)
     : action_context_{action_context},
+      piggyback_confirms_{config.confirm_chunk_count > 1},
       safe_stream_sending_{action_context_, protocol_context_, config},
       safe_stream_receiving_{action_context_, protocol_context_, config},
       in_{action_context_, safe_stream_sending_, config.max_data_size},
@@ -140,6 +142,20 @@ SafeStream::SafeStream(ActionContext action_context, SafeStreamConfig config)
           [this](auto&& data, auto current_time) {
             OnDataReaderSend(std::forward<decltype(data)>(data), current_time);
           }),
+      safe_stream_sending_.send_data_event().Subscribe(
+          [this](auto&& data, auto current_time) {
+            OnDataReaderSend(std::forward<decltype(data)>(data), current_time);
+          }),
+      out_.gate_update_event().Subscribe([this]() { OnLinkUpdate(); }),
+      protocol_context_.OnMessage<SafeStreamApi::RequestReport>(
+          [this](auto const& /* message */) {
+            safe_stream_receiving_.RequestReport();
+          }),
+      protocol_context_.OnMessage<SafeStreamApi::PutReport>(
+          [this](auto const& message) {
+            safe_stream_sending_.PutReport(
+                SafeStreamRingIndex{message.message().offset});
+          }),
       protocol_context_.OnMessage<SafeStreamApi::Confirm>(
           [this](auto const& message) {
             safe_stream_sending_.Confirm(
@@ -164,6 +180,25 @@ SafeStream::SafeStream(ActionContext action_context, SafeStreamConfig config)
                 message.message().repeat_count,
                 std::move(const_cast<SafeStreamApi::Repeat&>(message.message())
                               .data));
+          }),
+      protocol_context_.OnMessage<SafeStreamApi::SendPart>(
+          [this](auto const& message) {
+            safe_stream_receiving_.ReceiveSend(
+                SafeStreamRingIndex{message.message().offset},
+                std::move(const_cast<SafeStreamApi::SendPart&>(
+                              message.message())
+                              .data),
+                false);
+          }),
+      protocol_context_.OnMessage<SafeStreamApi::RepeatPart>(
+          [this](auto const& message) {
+            safe_stream_receiving_.ReceiveRepeat(
+                SafeStreamRingIndex{message.message().offset},
+                message.message().repeat_count,
+                std::move(const_cast<SafeStreamApi::RepeatPart&>(
+                              message.message())
+                              .data),
+                false);
           }));
 
   Tie(in_, out_);
@@ -175,6 +210,19 @@ void SafeStream::LinkOut(OutGate& gate) { out_.LinkOut(gate); }
 
 void SafeStream::OnDataWrite(SafeStreamRingIndex offset, DataBuffer&& data,
                              TimePoint current_time) {
+  if (piggyback_confirms_) {
+    // packet is a sequence of api messages, so confirms for the opposite
+    // direction are appended to data packet instead of sending them separately
+    auto confirms = safe_stream_receiving_.TakeConfirms(current_time);
+    if ((data.size() + confirms.size()) <=
+        out_.stream_info().max_element_size) {
+      data.insert(std::end(data), std::begin(confirms), std::end(confirms));
+    } else if (!confirms.empty()) {
+      // data packet is already of max size
+      OnDataReaderSend(std::move(confirms), current_time);
+    }
+  }
+
   auto write_action = out_.Write(std::move(data), current_time);
 
   subscriptions_.Push(
@@ -195,4 +243,11 @@ void SafeStream::OnDataReaderSend(DataBuffer&& data, TimePoint current_time) {
   out_.Write(std::move(data), current_time);
 }
 
+void SafeStream::OnLinkUpdate() {
+  // transport under the stream may be changed, but the session continues
+  auto is_linked = out_.stream_info().is_linked;
+  safe_stream_sending_.set_linked(is_linked);
+  safe_stream_receiving_.set_linked(is_linked);
+}
+
 }  // namespace ae
@@ -95,8 +95,10 @@ class SafeStream final : public ByteStream {
                    TimePoint current_time);
 
   void OnDataReaderSend(DataBuffer &&data, TimePoint current_time);
+  void OnLinkUpdate();
 
   ActionContext action_context_;
+  bool piggyback_confirms_;
 
   ProtocolContext protocol_context_;
   SafeStreamSendingAction safe_stream_sending_;
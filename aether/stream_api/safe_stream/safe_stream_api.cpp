@@ -16,34 +16,14 @@
 
 #include "aether/stream_api/safe_stream/safe_stream_api.h"
 
+#include <cassert>
+
+#include "aether/api_protocol/api_dispatch.h"
+
 namespace ae {
 void SafeStreamApi::LoadFactory(MessageId message_id, ApiParser& parser) {
-  switch (message_id) {
-    case Close::kMessageCode:
-      parser.Load<Close>(*this);
-      break;
-    case RequestReport::kMessageCode:
-      parser.Load<RequestReport>(*this);
-      break;
-    case PutReport::kMessageCode:
-      parser.Load<PutReport>(*this);
-      break;
-    case Confirm::kMessageCode:
-      parser.Load<Confirm>(*this);
-      break;
-    case RequestRepeat::kMessageCode:
-      parser.Load<RequestRepeat>(*this);
-      break;
-    case Send::kMessageCode:
-      parser.Load<Send>(*this);
-      break;
-    case Repeat::kMessageCode:
-      parser.Load<Repeat>(*this);
-      break;
-    default:
-      assert(false);
-      break;
-  }
+  [[maybe_unused]] auto res = DispatchLoad(*this, message_id, parser);
+  assert(res);
 }
 
 template <typename TMessage>
@@ -25,6 +25,8 @@
 #include "aether/api_protocol/api_message.h"
 #include "aether/api_protocol/api_protocol.h"
 
+#include "aether/stream_api/safe_stream/safe_stream_types.h"
+
 namespace ae {
 class SafeStreamApi : public ApiClass {
  public:
@@ -57,7 +59,7 @@ class SafeStreamApi : public ApiClass {
       s & offset;
     }
 
-    std::uint16_t offset;
+    SafeStreamRingIndex::type offset;
   };
   struct Confirm : public Message<Confirm> {
     static constexpr auto kMessageCode = 5;
@@ -69,7 +71,7 @@ class SafeStreamApi : public ApiClass {
       s & offset;
     }
 
-    std::uint16_t offset;
+    SafeStreamRingIndex::type offset;
   };
   struct RequestRepeat : public Message<RequestRepeat> {
     static constexpr auto kMessageCode = 6;
@@ -80,7 +82,7 @@ class SafeStreamApi : public ApiClass {
     void Serializator(T& s) {
       s & offset;
     }
-    std::uint16_t offset;
+    SafeStreamRingIndex::type offset;
   };
   struct Send : public Message<Send> {
     static constexpr auto kMessageCode = 7;
@@ -92,7 +94,7 @@ class SafeStreamApi : public ApiClass {
       s & offset & data;
     }
 
-    std::uint16_t offset;
+    SafeStreamRingIndex::type offset;
     DataBuffer data;
   };
   struct Repeat : public Message<Repeat> {
@@ -105,9 +107,48 @@ class SafeStreamApi : public ApiClass {
       s & repeat_count & offset & data;
     }
     std::uint16_t repeat_count;
-    std::uint16_t offset;
+    SafeStreamRingIndex::type offset;
+    DataBuffer data;
+  };
+
+  // parts of the message in compact framing, Send and Repeat end the message
+  struct SendPart : public Message<SendPart> {
+    static constexpr auto kMessageCode = 9;
+    static constexpr auto kMessageId =
+        crc32::checksum_from_literal("SafeStreamApi::SendPart");
+
+    template <typename T>
+    void Serializator(T& s) {
+      s & offset & data;
+    }
+
+    SafeStreamRingIndex::type offset;
     DataBuffer data;
   };
+  struct RepeatPart : public Message<RepeatPart> {
+    static constexpr auto kMessageCode = 10;
+    static constexpr auto kMessageId =
+        crc32::checksum_from_literal("SafeStreamApi::RepeatPart");
+
+    template <typename T>
+    void Serializator(T& s) {
+      s & repeat_count & offset & data;
+    }
+    std::uint16_t repeat_count;
+    SafeStreamRingIndex::type offset;
+    DataBuffer data;
+  };
+
+  using Messages = ApiMessageList<
+      ApiMessageCode<Close::kMessageCode, Close>,
+      ApiMessageCode<RequestReport::kMessageCode, RequestReport>,
+      ApiMessageCode<PutReport::kMessageCode, PutReport>,
+      ApiMessageCode<Confirm::kMessageCode, Confirm>,
+      ApiMessageCode<RequestRepeat::kMessageCode, RequestRepeat>,
+      ApiMessageCode<Send::kMessageCode, Send>,
+      ApiMessageCode<Repeat::kMessageCode, Repeat>,
+      ApiMessageCode<SendPart::kMessageCode, SendPart>,
+      ApiMessageCode<RepeatPart::kMessageCode, RepeatPart>>;
 
   void LoadFactory(MessageId message_id, ApiParser& parser) override;
 
@@ -32,9 +32,16 @@ SafeStreamReceivingAction ::SafeStreamReceivingAction(
       max_window_size_{config.window_size},
       max_repeat_count_{config.max_repeat_count},
       send_confirm_timeout_{config.send_confirm_timeout},
-      send_repeat_timeout_{config.send_repeat_timeout} {}
+      send_repeat_timeout_{config.send_repeat_timeout},
+      confirm_chunk_count_{config.confirm_chunk_count},
+      compact_framing_{config.compact_framing} {}
 
 TimePoint SafeStreamReceivingAction::Update(TimePoint current_time) {
+  if (link_lost_) {
+    // wait for relink, keep the received chunks
+    return current_time;
+  }
+
   auto new_time = CheckChunkChains(current_time);
 
   if (repeat_count_exceeded_) {
@@ -60,7 +67,7 @@ SafeStreamReceivingAction::send_data_event() {
 }
 
 void SafeStreamReceivingAction::ReceiveSend(SafeStreamRingIndex offset,
-                                            DataBuffer data) {
+                                            DataBuffer data, bool message_end) {
   AE_TELED_DEBUG("Data received offset {}", offset);
   if (last_confirmed_offset_.Distance(offset) >= max_window_size_) {
     // confirmed offset
@@ -68,14 +75,18 @@ void SafeStreamReceivingAction::ReceiveSend(SafeStreamRingIndex offset,
     return;
   }
 
-  AddDataChunk(ReceivingChunk{offset, std::move(data)});
+  if (IsAfterGap(offset)) {
+    after_gap_count_ += 1;
+  }
+  AddDataChunk(ReceivingChunk{offset, std::move(data), message_end});
 
   this->Trigger();
 }
 
 void SafeStreamReceivingAction::ReceiveRepeat(SafeStreamRingIndex offset,
                                               std::uint16_t repeat,
-                                              DataBuffer data) {
+                                              DataBuffer data,
+                                              bool message_end) {
   AE_TELED_DEBUG("Repeat data received offset: {}, repeat {}", offset, repeat);
   if (last_confirmed_offset_.Distance(offset) >= max_window_size_) {
     // confirmed offset
@@ -85,8 +96,46 @@ void SafeStreamReceivingAction::ReceiveRepeat(SafeStreamRingIndex offset,
     return;
   }
 
-  AddDataChunk(ReceivingChunk{offset, std::move(data)});
+  AddDataChunk(ReceivingChunk{offset, std::move(data), message_end});
+
+  this->Trigger();
+}
+
+DataBuffer SafeStreamReceivingAction::TakeConfirms(TimePoint current_time) {
+  // chunks received since the last update are confirmed too
+  JoinCompletedChains(current_time);
+  FlushDelayedConfirm();
+  if (confirmation_queue_.empty()) {
+    return {};
+  }
+  auto packet = PacketBuilder{protocol_context_};
+  PushConfirms(packet);
+  return std::move(packet).Pack();
+}
 
+void SafeStreamReceivingAction::RequestReport() {
+  AE_TELED_DEBUG("Report requested");
+  put_report_ = true;
+  this->Trigger();
+}
+
+void SafeStreamReceivingAction::set_linked(bool linked) {
+  if (linked_ == linked) {
+    return;
+  }
+  linked_ = linked;
+  if (!linked_) {
+    link_lost_ = true;
+    return;
+  }
+  if (!link_lost_) {
+    // the first link
+    return;
+  }
+  link_lost_ = false;
+  // repeat requests made before were lost, start counting again
+  expected_chunks_.clear();
+  put_report_ = true;
   this->Trigger();
 }
 
@@ -116,7 +165,8 @@ void SafeStreamReceivingAction::AddDataChunk(ReceivingChunk chunk) {
         it, ReceivingChunk{
                 chunk.offset,
                 {std::begin(chunk.data),
-                 std::begin(chunk.data) + chunk.offset.Distance(it->offset)}});
+                 std::begin(chunk.data) + chunk.offset.Distance(it->offset)},
+                false});
   } else {
     received_data_chunks_.insert(it, std::move(chunk));
   }
@@ -131,6 +181,18 @@ void SafeStreamReceivingAction::AddDataChunk(ReceivingChunk chunk) {
   }
 }
 
+bool SafeStreamReceivingAction::IsAfterGap(SafeStreamRingIndex offset) const {
+  auto next_chunk_offset = last_confirmed_offset_;
+  for (auto const& chunk : received_data_chunks_) {
+    if (next_chunk_offset != chunk.offset) {
+      break;
+    }
+    next_chunk_offset = chunk.offset + static_cast<SafeStreamRingIndex::type>(
+                                           chunk.data.size());
+  }
+  return next_chunk_offset != offset;
+}
+
 TimePoint SafeStreamReceivingAction::CheckChunkChains(TimePoint current_time) {
   auto conf_time = CheckCompletedChains(current_time);
   auto rep_time = CheckMissedOffset(current_time);
@@ -139,38 +201,59 @@ TimePoint SafeStreamReceivingAction::CheckChunkChains(TimePoint current_time) {
 
 TimePoint SafeStreamReceivingAction::CheckCompletedChains(
     TimePoint current_time) {
-  if ((last_send_confirm_time_ + send_confirm_timeout_) > current_time) {
-    return (last_send_confirm_time_ + send_confirm_timeout_);
-  }
+  JoinCompletedChains(current_time);
+  return CheckDelayedConfirm(current_time);
+}
 
+void SafeStreamReceivingAction::JoinCompletedChains(TimePoint current_time) {
   auto next_chunk_offset = last_confirmed_offset_;
+  std::uint16_t chunk_count = 0;
   auto it = std::begin(received_data_chunks_);
   for (; it != std::end(received_data_chunks_); it++) {
     auto& chunk = *it;
     if (next_chunk_offset == chunk.offset) {
       next_chunk_offset = chunk.offset + static_cast<SafeStreamRingIndex::type>(
                                              chunk.data.size());
+      ++chunk_count;
     } else {
       break;
     }
   }
 
-  auto data = JoinChunks(std::begin(received_data_chunks_), it);
-  if (!data.empty()) {
-    AE_TELED_DEBUG("Data chunk chain received length: {} to offset: {}",
-                   data.size(), next_chunk_offset);
-    receive_event_.Emit(std::move(data));
+  if (compact_framing_) {
+    EmitMessages(std::begin(received_data_chunks_), it);
+  } else {
+    auto data = JoinChunks(std::begin(received_data_chunks_), it);
+    if (!data.empty()) {
+      AE_TELED_DEBUG("Data chunk chain received length: {} to offset: {}",
+                     data.size(), next_chunk_offset);
+      receive_event_.Emit(std::move(data));
+    }
   }
 
   received_data_chunks_.erase(std::begin(received_data_chunks_), it);
 
   if (next_chunk_offset != last_confirmed_offset_) {
-    // confirm range [last_confirmed_offset_, next_chunk_offset)
-    AddToConfirmationQueue(next_chunk_offset - 1);
+    // confirm range [last_confirmed_offset_, next_chunk_offset) with delay to
+    // coalesce confirms or send it with outgoing data
+    if (!delayed_confirm_) {
+      delayed_confirm_time_ = current_time;
+    }
+    delayed_confirm_ = next_chunk_offset - 1;
+    delayed_chunk_count_ =
+        static_cast<std::uint16_t>(delayed_chunk_count_ + chunk_count);
     last_confirmed_offset_ = next_chunk_offset;
-    last_send_confirm_time_ = current_time;
   }
-  return current_time;
+
+  if (!received_data_chunks_.empty() && (after_gap_count_ > 0)) {
+    // there is still a gap, duplicate the last confirm for each chunk received
+    // after it, to let the sender repeat the missed one
+    FlushDelayedConfirm();
+    for (; after_gap_count_ > 0; --after_gap_count_) {
+      AddToConfirmationQueue(last_confirmed_offset_ - 1);
+    }
+  }
+  after_gap_count_ = 0;
 }
 
 TimePoint SafeStreamReceivingAction::CheckMissedOffset(TimePoint current_time) {
@@ -193,26 +276,69 @@ TimePoint SafeStreamReceivingAction::CheckMissedOffset(TimePoint current_time) {
   return current_time;
 }
 
+TimePoint SafeStreamReceivingAction::CheckDelayedConfirm(
+    TimePoint current_time) {
+  if (!delayed_confirm_) {
+    return current_time;
+  }
+  if ((delayed_chunk_count_ >= confirm_chunk_count_) ||
+      ((delayed_confirm_time_ + send_confirm_timeout_) <= current_time)) {
+    FlushDelayedConfirm();
+    return current_time;
+  }
+  return delayed_confirm_time_ + send_confirm_timeout_;
+}
+
+void SafeStreamReceivingAction::FlushDelayedConfirm() {
+  if (!delayed_confirm_) {
+    return;
+  }
+  AddToConfirmationQueue(*delayed_confirm_);
+  delayed_confirm_.reset();
+  delayed_chunk_count_ = 0;
+}
+
 void SafeStreamReceivingAction::MakeResponse(TimePoint current_time) {
-  if (confirmation_queue_.empty() && repeat_queue_.empty()) {
+  if (confirmation_queue_.empty() && repeat_queue_.empty() && !put_report_) {
     return;
   }
 
   auto packet = PacketBuilder{protocol_context_};
-  for (auto const& confirm : confirmation_queue_) {
-    packet.Push(safe_stream_api_, SafeStreamApi::Confirm{
-                                      {}, static_cast<std::uint16_t>(confirm)});
+  if (put_report_) {
+    // report covers all the confirms
+    put_report_ = false;
+    delayed_confirm_.reset();
+    delayed_chunk_count_ = 0;
+    confirmation_queue_.clear();
+    AE_TELED_DEBUG("Put report offset {}", last_confirmed_offset_);
+    packet.Push(safe_stream_api_,
+                SafeStreamApi::PutReport{{},
+                                         static_cast<SafeStreamRingIndex::type>(
+                                             last_confirmed_offset_)});
+  } else {
+    // packet is sent anyway, so do not wait with the delayed confirm
+    FlushDelayedConfirm();
+    PushConfirms(packet);
   }
-  confirmation_queue_.clear();
   for (auto const& repeat : repeat_queue_) {
-    packet.Push(safe_stream_api_, SafeStreamApi::RequestRepeat{
-                                      {}, static_cast<std::uint16_t>(repeat)});
+    packet.Push(safe_stream_api_,
+                SafeStreamApi::RequestRepeat{
+                    {}, static_cast<SafeStreamRingIndex::type>(repeat)});
   }
   repeat_queue_.clear();
 
   send_data_event_.Emit(std::move(packet), current_time);
 }
 
+void SafeStreamReceivingAction::PushConfirms(PacketBuilder& packet) {
+  for (auto const& confirm : confirmation_queue_) {
+    packet.Push(safe_stream_api_,
+                SafeStreamApi::Confirm{
+                    {}, static_cast<SafeStreamRingIndex::type>(confirm)});
+  }
+  confirmation_queue_.clear();
+}
+
 void SafeStreamReceivingAction::AddExpectedChunk(SafeStreamRingIndex offset) {
   auto ex_it =
       std::find_if(std::begin(expected_chunks_), std::end(expected_chunks_),
@@ -257,4 +383,26 @@ DataBuffer SafeStreamReceivingAction::JoinChunks(
   return data;
 }
 
+void SafeStreamReceivingAction::EmitMessages(
+    std::vector<ReceivingChunk>::iterator begin,
+    std::vector<ReceivingChunk>::iterator end) {
+  for (auto it = begin; it != end; it++) {
+    if (!it->message_end) {
+      message_part_.insert(std::end(message_part_), std::begin(it->data),
+                           std::end(it->data));
+      continue;
+    }
+    if (message_part_.empty()) {
+      // whole message in one chunk
+      receive_event_.Emit(std::move(it->data));
+      continue;
+    }
+    message_part_.insert(std::end(message_part_), std::begin(it->data),
+                         std::end(it->data));
+    auto message = std::move(message_part_);
+    message_part_.clear();
+    receive_event_.Emit(std::move(message));
+  }
+}
+
 }  // namespace ae
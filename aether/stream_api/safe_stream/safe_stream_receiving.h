@@ -20,10 +20,12 @@
 #include <cstdint>
 #include <vector>
 #include <deque>
+#include <optional>
 
 #include "aether/events/events.h"
 #include "aether/actions/action.h"
 #include "aether/actions/action_context.h"
+#include "aether/api_protocol/packet_builder.h"
 #include "aether/api_protocol/protocol_context.h"
 
 #include "aether/transport/data_buffer.h"
@@ -35,6 +37,7 @@ namespace ae {
 struct ReceivingChunk {
   SafeStreamRingIndex offset;
   DataBuffer data;
+  bool message_end = true;  //< chunk ends the message in compact framing
 };
 
 struct ExpectedChunk {
@@ -56,18 +59,42 @@ class SafeStreamReceivingAction : public Action<SafeStreamReceivingAction> {
   ReceiveEvent::Subscriber receive_event();
   SenDataEvent::Subscriber send_data_event();
 
-  void ReceiveSend(SafeStreamRingIndex offset, DataBuffer data);
+  void ReceiveSend(SafeStreamRingIndex offset, DataBuffer data,
+                   bool message_end = true);
   void ReceiveRepeat(SafeStreamRingIndex offset, std::uint16_t repeat,
-                     DataBuffer data);
+                     DataBuffer data, bool message_end = true);
+
+  /**
+   * \brief Take pending confirms to send them with outgoing data packet.
+   * Returns packed confirm messages or empty buffer if nothing to confirm.
+   */
+  DataBuffer TakeConfirms(TimePoint current_time);
+
+  /**
+   * \brief Sender asks for the next expected offset, it is sent by PutReport.
+   */
+  void RequestReport();
+
+  /**
+   * \brief Update link state of the out gate.
+   * Repeat requests are paused while the link is lost, on relink the report is
+   * sent to the sender to continue from the next expected offset.
+   */
+  void set_linked(bool linked);
 
  private:
   void AddDataChunk(ReceivingChunk chunk);
+  bool IsAfterGap(SafeStreamRingIndex offset) const;
 
   TimePoint CheckChunkChains(TimePoint current_time);
   TimePoint CheckCompletedChains(TimePoint current_time);
+  void JoinCompletedChains(TimePoint current_time);
   TimePoint CheckMissedOffset(TimePoint current_time);
+  TimePoint CheckDelayedConfirm(TimePoint current_time);
+  void FlushDelayedConfirm();
 
   void MakeResponse(TimePoint current_time);
+  void PushConfirms(PacketBuilder& packet);
 
   void AddExpectedChunk(SafeStreamRingIndex offset);
   void AddToConfirmationQueue(SafeStreamRingIndex offset);
@@ -75,16 +102,20 @@ class SafeStreamReceivingAction : public Action<SafeStreamReceivingAction> {
 
   DataBuffer JoinChunks(std::vector<ReceivingChunk>::iterator begin,
                         std::vector<ReceivingChunk>::iterator end);
+  void EmitMessages(std::vector<ReceivingChunk>::iterator begin,
+                    std::vector<ReceivingChunk>::iterator end);
 
   ProtocolContext& protocol_context_;
   SafeStreamApi safe_stream_api_;
 
-  std::uint16_t max_window_size_;
+  SafeStreamRingIndex::type max_window_size_;
   std::uint16_t max_repeat_count_;
   Duration send_confirm_timeout_;
   Duration send_repeat_timeout_;
+  std::uint16_t confirm_chunk_count_;
+  bool compact_framing_;
 
-  TimePoint last_send_confirm_time_;
+  TimePoint delayed_confirm_time_;
   TimePoint oldest_repeat_time_;
   SafeStreamRingIndex last_confirmed_offset_;
 
@@ -95,8 +126,20 @@ class SafeStreamReceivingAction : public Action<SafeStreamReceivingAction> {
   std::vector<ExpectedChunk> expected_chunks_;
   std::deque<SafeStreamRingIndex> repeat_queue_;
   std::deque<SafeStreamRingIndex> confirmation_queue_;
+  // received parts of not completed message in compact framing
+  DataBuffer message_part_;
 
+  // confirm waiting for more chunks, timeout or outgoing data packet
+  std::optional<SafeStreamRingIndex> delayed_confirm_;
+  std::uint16_t delayed_chunk_count_ = 0;
+
+  // count of chunks received after missed one, each is confirmed by duplicate
+  std::uint16_t after_gap_count_ = 0;
   bool repeat_count_exceeded_ = false;
+
+  bool linked_ = false;
+  bool link_lost_ = false;
+  bool put_report_ = false;
 };
 }  // namespace ae
 
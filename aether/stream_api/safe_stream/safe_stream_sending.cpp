@@ -16,13 +16,21 @@
 
 #include "aether/stream_api/safe_stream/safe_stream_sending.h"
 
+#include <chrono>
 #include <utility>
+#include <algorithm>
 
 #include "aether/api_protocol/packet_builder.h"
 
 #include "aether/tele/tele.h"
 
 namespace ae {
+// count of duplicated confirms to repeat the next chunk without waiting for
+// confirm timeout, same as TCP fast retransmit
+static constexpr std::uint16_t kFastRepeatDuplicates = 3;
+// count of max size chunks allowed to send at once with pacing
+static constexpr std::size_t kPacingBurstChunks = 2;
+
 SafeStreamSendingAction::SafeStreamSendingAction(
     ActionContext action_context, ProtocolContext& protocol_context,
     SafeStreamConfig const& config)
@@ -33,19 +41,48 @@ SafeStreamSendingAction::SafeStreamSendingAction(
       max_repeat_count_{config.max_repeat_count},
       wait_confirm_timeout_{config.wait_confirm_timeout},
       max_data_size_{},
+      pacing_{config.pacing},
+      compact_framing_{config.compact_framing},
       send_data_buffer_{action_context, window_size_},
+      send_pacer_{window_size_, wait_confirm_timeout_},
       sending_chunks_{window_size_},
       last_confirmed_{},
       next_to_add_{},
-      last_sent_offset_{} {}
+      last_sent_offset_{},
+      duplicate_confirm_count_{},
+      fast_repeat_{} {}
 
 SafeStreamSendingAction::~SafeStreamSendingAction() = default;
 
 TimePoint SafeStreamSendingAction::Update(TimePoint current_time) {
+  if (link_lost_) {
+    // wait for relink, nothing could be sent or confirmed
+    return HandleLinkLost(current_time);
+  }
+
+  if (confirmed_send_time_) {
+    send_pacer_.AddRttSample(std::chrono::duration_cast<Duration>(
+        current_time - *confirmed_send_time_));
+    confirmed_send_time_.reset();
+  }
+
+  auto report_time = HandleReport(current_time);
+  if (report_time > current_time) {
+    return report_time;
+  }
+
   auto new_time = HandleTimeouts(current_time);
 
   if (max_data_size_ != 0) {
-    SendData(current_time);
+    if (fast_repeat_) {
+      FastRepeat(current_time);
+    }
+    auto send_time = SendData(current_time);
+    if (send_time > current_time) {
+      // wait for pacing
+      new_time = (new_time > current_time) ? std::min(new_time, send_time)
+                                           : send_time;
+    }
   }
   return new_time;
 }
@@ -55,6 +92,11 @@ SafeStreamSendingAction::write_data_event() {
   return write_data_event_;
 }
 
+SafeStreamSendingAction::SendDataEvent::Subscriber
+SafeStreamSendingAction::send_data_event() {
+  return send_data_event_;
+}
+
 ActionView<SendingDataAction> SafeStreamSendingAction::SendData(
     DataBuffer data) {
   if ((send_data_buffer_.size() + data.size()) > buffer_capacity_) {
@@ -78,10 +120,18 @@ ActionView<SendingDataAction> SafeStreamSendingAction::SendData(
 }
 
 void SafeStreamSendingAction::Confirm(SafeStreamRingIndex offset) {
+  if ((offset + 1) == last_confirmed_) {
+    DuplicateConfirm();
+    return;
+  }
   auto distance = last_confirmed_.Distance(offset);
   if (distance <= window_size_) {
+    if (pacing_) {
+      confirmed_send_time_ = sending_chunks_.FirstSendTime(offset);
+    }
     ConfirmDataChunks(offset);
     last_confirmed_ = offset + 1;
+    duplicate_confirm_count_ = 0;
   }
   AE_TELED_DEBUG("Receive confirmed offset {}", offset);
   Action::Trigger();
@@ -96,6 +146,33 @@ void SafeStreamSendingAction::RequestRepeatSend(SafeStreamRingIndex offset) {
   Action::Trigger();
 }
 
+void SafeStreamSendingAction::PutReport(SafeStreamRingIndex offset) {
+  if (last_confirmed_.Distance(offset) >
+      last_confirmed_.Distance(next_to_add_)) {
+    AE_TELED_WARNING("Report with unknown offset {}", offset);
+    return;
+  }
+  AE_TELED_DEBUG("Receive report offset {}", offset);
+  if (offset != last_confirmed_) {
+    ConfirmDataChunks(offset - 1);
+    last_confirmed_ = offset;
+  }
+  if (!report_wait_time_) {
+    // not requested report works as confirm only, sending is going on
+    Action::Trigger();
+    return;
+  }
+  // chunks sent before the report are lost or already received, so they are
+  // not counted as repeats
+  sending_chunks_.clear();
+  last_sent_offset_ = offset;
+  duplicate_confirm_count_ = 0;
+  fast_repeat_ = false;
+  confirmed_send_time_.reset();
+  report_wait_time_.reset();
+  Action::Trigger();
+}
+
 void SafeStreamSendingAction::ReportWriteSuccess(
     SafeStreamRingIndex /* offset */) {}
 
@@ -107,18 +184,85 @@ void SafeStreamSendingAction::ReportWriteStopped(SafeStreamRingIndex offset) {
 }
 
 void SafeStreamSendingAction::ReportWriteError(SafeStreamRingIndex offset) {
+  // data is kept and repeated by timeout or after relink, it is rejected only
+  // if repeat count exceeded
   AE_TELED_ERROR("Send error for offset:{}", offset);
-
-  sending_chunks_.RemoveUpTo(offset);
-  send_data_buffer_.Reject(offset);
 }
 
 void SafeStreamSendingAction::set_max_data_size(std::size_t max_data_size) {
   max_data_size_ = static_cast<SafeStreamRingIndex::type>(max_data_size);
+  send_pacer_.set_burst_size(max_data_size * kPacingBurstChunks);
   AE_TELED_DEBUG("Set max data size to {}", max_data_size_);
   Action::Trigger();
 }
 
+void SafeStreamSendingAction::set_linked(bool linked) {
+  if (linked_ == linked) {
+    return;
+  }
+  linked_ = linked;
+  if (!linked_) {
+    AE_TELED_DEBUG("Link lost, pause sending");
+    link_lost_ = true;
+    // start waiting for relink
+    Action::Trigger();
+    return;
+  }
+  if (!link_lost_) {
+    // the first link
+    return;
+  }
+  AE_TELED_DEBUG("Relinked, resume sending");
+  link_lost_ = false;
+  link_lost_time_.reset();
+  // chunks sent before may be lost with the old link or received already
+  request_report_ = !sending_chunks_.empty();
+  Action::Trigger();
+}
+
+TimePoint SafeStreamSendingAction::HandleLinkLost(TimePoint current_time) {
+  if (!link_lost_time_) {
+    link_lost_time_ = current_time;
+  }
+  // the same time as data would be repeated until repeat count exceeded
+  auto deadline =
+      *link_lost_time_ + (wait_confirm_timeout_ * max_repeat_count_);
+  if (deadline > current_time) {
+    return deadline;
+  }
+  if (send_data_buffer_.size() != 0) {
+    AE_TELED_ERROR("Link is lost for too long, reject data");
+    auto last_offset = next_to_add_ - 1;
+    sending_chunks_.RemoveUpTo(last_offset);
+    send_data_buffer_.Reject(last_offset);
+  }
+  return current_time;
+}
+
+TimePoint SafeStreamSendingAction::HandleReport(TimePoint current_time) {
+  if (request_report_) {
+    request_report_ = false;
+    AE_TELED_DEBUG("Request report from offset {}", last_confirmed_);
+    auto packet = PacketBuilder{
+        protocol_context_,
+        PackMessage{safe_stream_api_, SafeStreamApi::RequestReport{}}};
+    send_data_event_.Emit(std::move(packet), current_time);
+    report_wait_time_ = current_time + wait_confirm_timeout_;
+  }
+
+  if (!report_wait_time_) {
+    return current_time;
+  }
+  if (*report_wait_time_ > current_time) {
+    return *report_wait_time_;
+  }
+  AE_TELED_WARNING("Wait report timeout, repeat from offset {}",
+                   last_confirmed_);
+  report_wait_time_.reset();
+  last_sent_offset_ = last_confirmed_;
+  return current_time;
+}
+
 TimePoint SafeStreamSendingAction::HandleTimeouts(TimePoint current_time) {
   if (sending_chunks_.empty()) {
     return current_time;
@@ -136,31 +280,75 @@ TimePoint SafeStreamSendingAction::HandleTimeouts(TimePoint current_time) {
   return selected_sch.send_time + wait_confirm_timeout_;
 }
 
-void SafeStreamSendingAction::SendData(TimePoint current_time) {
+TimePoint SafeStreamSendingAction::SendData(TimePoint current_time) {
   if (last_confirmed_.Distance(last_sent_offset_ + max_data_size_) >
       window_size_) {
     AE_TELED_WARNING("Window size exceeded");
-    return;
+    return current_time;
+  }
+
+  if (pacing_) {
+    auto size = std::min(max_data_size_,
+                         last_sent_offset_.Distance(next_to_add_));
+    auto send_time = send_pacer_.SendTime(size, current_time);
+    if (send_time > current_time) {
+      return send_time;
+    }
   }
 
-  auto data_chunk =
-      send_data_buffer_.GetSlice(last_sent_offset_, max_data_size_);
+  auto data_chunk = GetSlice(last_sent_offset_);
   if (data_chunk.data.empty()) {
     // no data to send
-    return;
+    return current_time;
   }
 
   last_sent_offset_.Clockwise(
       static_cast<SafeStreamRingIndex::type>(data_chunk.data.size()));
 
+  SendChunk(std::move(data_chunk), current_time);
+  return current_time;
+}
+
+DataChunk SafeStreamSendingAction::GetSlice(SafeStreamRingIndex offset) {
+  if (compact_framing_) {
+    // chunk is a whole message or its part
+    return send_data_buffer_.GetMessageSlice(offset, max_data_size_);
+  }
+  return send_data_buffer_.GetSlice(offset, max_data_size_);
+}
+
+void SafeStreamSendingAction::DuplicateConfirm() {
+  duplicate_confirm_count_ += 1;
+  if (duplicate_confirm_count_ != kFastRepeatDuplicates) {
+    return;
+  }
+  AE_TELED_DEBUG("Duplicated confirms for offset {}, fast repeat",
+                 last_confirmed_);
+  fast_repeat_ = true;
+  Action::Trigger();
+}
+
+void SafeStreamSendingAction::FastRepeat(TimePoint current_time) {
+  fast_repeat_ = false;
+  // repeat only the first not confirmed chunk, the rest is received
+  auto data_chunk = GetSlice(last_confirmed_);
+  if (data_chunk.data.empty()) {
+    return;
+  }
+  SendChunk(std::move(data_chunk), current_time);
+}
+
+void SafeStreamSendingAction::SendChunk(DataChunk&& chunk,
+                                        TimePoint current_time) {
+  send_pacer_.Consume(chunk.data.size());
   auto& send_chunk = sending_chunks_.Register(
-      data_chunk.offset,
-      data_chunk.offset +
-          static_cast<SafeStreamRingIndex::type>(data_chunk.data.size() - 1),
+      chunk.offset,
+      chunk.offset +
+          static_cast<SafeStreamRingIndex::type>(chunk.data.size() - 1),
       current_time);
 
   if (send_chunk.repeat_count == 0) {
-    SendFirst(std::move(data_chunk), current_time);
+    SendFirst(std::move(chunk), current_time);
   } else {
     if ((send_chunk.repeat_count) > max_repeat_count_) {
       AE_TELED_ERROR("Repeat count exceeded");
@@ -168,7 +356,7 @@ void SafeStreamSendingAction::SendData(TimePoint current_time) {
       send_data_buffer_.Reject(send_chunk.end_offset);
       return;
     }
-    SendRepeat(std::move(data_chunk), send_chunk.repeat_count, current_time);
+    SendRepeat(std::move(chunk), send_chunk.repeat_count, current_time);
   }
   send_chunk.repeat_count += 1;
 }
@@ -177,17 +365,22 @@ void SafeStreamSendingAction::SendFirst(DataChunk&& chunk,
                                         TimePoint current_time) {
   AE_TELED_DEBUG("SendFirst chunk offset:{}", chunk.offset);
 
-  auto packet = PacketBuilder{
-      protocol_context_,
-      PackMessage{
-          safe_stream_api_,
-          SafeStreamApi::Send{
-              {},
-              static_cast<SafeStreamRingIndex::type>(chunk.offset),
-              std::move(chunk.data),
-          },
-      },
-  };
+  auto packet = PacketBuilder{protocol_context_};
+  if (compact_framing_ && !chunk.message_end) {
+    packet.Push(safe_stream_api_,
+                SafeStreamApi::SendPart{
+                    {},
+                    static_cast<SafeStreamRingIndex::type>(chunk.offset),
+                    std::move(chunk.data),
+                });
+  } else {
+    packet.Push(safe_stream_api_,
+                SafeStreamApi::Send{
+                    {},
+                    static_cast<SafeStreamRingIndex::type>(chunk.offset),
+                    std::move(chunk.data),
+                });
+  }
 
   WriteDataBuffer(chunk.offset, std::move(packet), current_time);
 }
@@ -198,18 +391,24 @@ void SafeStreamSendingAction::SendRepeat(DataChunk&& chunk,
   AE_TELED_DEBUG("SendRepeat chunk offset:{} count:{}", chunk.offset,
                  repeat_count);
 
-  auto packet = PacketBuilder{
-      protocol_context_,
-      PackMessage{
-          safe_stream_api_,
-          SafeStreamApi::Repeat{
-              {},
-              repeat_count,
-              static_cast<SafeStreamRingIndex::type>(chunk.offset),
-              std::move(chunk.data),
-          },
-      },
-  };
+  auto packet = PacketBuilder{protocol_context_};
+  if (compact_framing_ && !chunk.message_end) {
+    packet.Push(safe_stream_api_,
+                SafeStreamApi::RepeatPart{
+                    {},
+                    repeat_count,
+                    static_cast<SafeStreamRingIndex::type>(chunk.offset),
+                    std::move(chunk.data),
+                });
+  } else {
+    packet.Push(safe_stream_api_,
+                SafeStreamApi::Repeat{
+                    {},
+                    repeat_count,
+                    static_cast<SafeStreamRingIndex::type>(chunk.offset),
+                    std::move(chunk.data),
+                });
+  }
 
   WriteDataBuffer(chunk.offset, std::move(packet), current_time);
 }
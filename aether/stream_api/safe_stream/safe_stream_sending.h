@@ -17,6 +17,8 @@
 #ifndef AETHER_STREAM_API_SAFE_STREAM_SAFE_STREAM_SENDING_H_
 #define AETHER_STREAM_API_SAFE_STREAM_SAFE_STREAM_SENDING_H_
 
+#include <optional>
+
 #include "aether/common.h"
 #include "aether/events/events.h"
 #include "aether/actions/action.h"
@@ -27,6 +29,7 @@
 #include "aether/transport/data_buffer.h"
 
 #include "aether/stream_api/safe_stream/safe_stream_api.h"
+#include "aether/stream_api/safe_stream/send_pacer.h"
 #include "aether/stream_api/safe_stream/send_data_buffer.h"
 #include "aether/stream_api/safe_stream/sending_chunk_list.h"
 #include "aether/stream_api/safe_stream/safe_stream_types.h"
@@ -38,6 +41,7 @@ class SafeStreamSendingAction : public Action<SafeStreamSendingAction> {
  public:
   using WriteDataEvent = Event<void(SafeStreamRingIndex offset,
                                     DataBuffer&& data, TimePoint current_time)>;
+  using SendDataEvent = Event<void(DataBuffer&& data, TimePoint current_time)>;
 
   SafeStreamSendingAction(ActionContext action_context,
                           ProtocolContext& protocol_context,
@@ -48,6 +52,7 @@ class SafeStreamSendingAction : public Action<SafeStreamSendingAction> {
   TimePoint Update(TimePoint current_time) override;
 
   WriteDataEvent::Subscriber write_data_event();
+  SendDataEvent::Subscriber send_data_event();
 
   /**
    * \brief Put new data to send
@@ -56,16 +61,35 @@ class SafeStreamSendingAction : public Action<SafeStreamSendingAction> {
 
   void Confirm(SafeStreamRingIndex offset);
   void RequestRepeatSend(SafeStreamRingIndex offset);
+  /**
+   * \brief Receiver reported the next offset it expects.
+   * Data before it is confirmed and sending continues from it.
+   */
+  void PutReport(SafeStreamRingIndex offset);
 
   void ReportWriteSuccess(SafeStreamRingIndex offset);
   void ReportWriteStopped(SafeStreamRingIndex offset);
   void ReportWriteError(SafeStreamRingIndex offset);
 
   void set_max_data_size(std::size_t max_data_size);
+  /**
+   * \brief Update link state of the out gate.
+   * Sending is paused while the link is lost, the buffer and offsets are kept.
+   * On relink the receiver is asked for report to continue from the offset it
+   * really got. If the link is not back in max_repeat_count *
+   * wait_confirm_timeout, buffered data is rejected.
+   */
+  void set_linked(bool linked);
 
  private:
+  TimePoint HandleLinkLost(TimePoint current_time);
+  TimePoint HandleReport(TimePoint current_time);
   TimePoint HandleTimeouts(TimePoint current_time);
-  void SendData(TimePoint current_time);
+  TimePoint SendData(TimePoint current_time);
+  DataChunk GetSlice(SafeStreamRingIndex offset);
+  void DuplicateConfirm();
+  void FastRepeat(TimePoint current_time);
+  void SendChunk(DataChunk&& chunk, TimePoint current_time);
   void SendFirst(DataChunk&& chunk, TimePoint current_time);
   void SendRepeat(DataChunk&& chunk, std::uint16_t repeat_count,
                   TimePoint current_time);
@@ -84,14 +108,30 @@ class SafeStreamSendingAction : public Action<SafeStreamSendingAction> {
   Duration wait_confirm_timeout_;
   SafeStreamApi safe_stream_api_;
   SafeStreamRingIndex::type max_data_size_;
+  bool pacing_;
+  bool compact_framing_;
 
   SendDataBuffer send_data_buffer_;
+  SendPacer send_pacer_;
   SendingChunkList sending_chunks_;
   WriteDataEvent write_data_event_;
+  SendDataEvent send_data_event_;
 
   SafeStreamRingIndex last_confirmed_;
   SafeStreamRingIndex next_to_add_;
   SafeStreamRingIndex last_sent_offset_;
+  std::uint16_t duplicate_confirm_count_;
+  bool fast_repeat_;
+  // send time of the last confirmed chunk to measure round trip time
+  std::optional<TimePoint> confirmed_send_time_;
+
+  bool linked_ = false;
+  bool link_lost_ = false;
+  // time the link was lost, to reject data if it's not back for too long
+  std::optional<TimePoint> link_lost_time_;
+  bool request_report_ = false;
+  // sending waits for report from receiver until this time
+  std::optional<TimePoint> report_wait_time_;
 
   MultiSubscription send_data_subscriptions_;
 };
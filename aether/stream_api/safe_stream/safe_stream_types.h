@@ -19,12 +19,19 @@
 
 #include <cstdint>
 
+#include "aether/config.h"
 #include "aether/common.h"
 #include "aether/ring_buffer.h"
 
 namespace ae {
 
+#if AE_SAFE_STREAM_OFFSET == AE_SAFE_STREAM_OFFSET_32
+// power of two offset space makes ring index arithmetic branch-free
+using SafeStreamRingIndex =
+    RingIndex<std::uint32_t, (std::uint32_t{1} << 31)>;
+#else
 using SafeStreamRingIndex = RingIndex<std::uint16_t>;
+#endif
 
 struct OffsetRange {
   SafeStreamRingIndex begin;
@@ -68,6 +75,11 @@ struct SafeStreamConfig {
   Duration send_confirm_timeout;  //< max time to wait before send confirmation
   Duration send_repeat_timeout;  //< max time to wait before send repeat request
   std::uint16_t max_repeat_count;  //< max repeat count for sending packet
+  // chunks to confirm without wait, with more than 1 confirms are coalesced
+  // and sent with outgoing data
+  std::uint16_t confirm_chunk_count = 1;
+  bool pacing = false;  //< spread sending of the window over round trip time
+  bool compact_framing = false;  //< each write is delivered as one message
 };
 
 }  // namespace ae
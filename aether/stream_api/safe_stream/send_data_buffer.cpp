@@ -51,12 +51,7 @@ DataChunk SendDataBuffer::GetSlice(SafeStreamRingIndex offset,
   std::size_t remaining = max_size;
   auto current_offset = offset;
 
-  auto it = std::find_if(
-      std::begin(send_action_views_), std::end(send_action_views_),
-      [offset, window_size{window_size_}](auto& action) {
-        auto& sending_data = action->sending_data();
-        return sending_data.get_offset_range(window_size).InRange(offset);
-      });
+  auto it = FindData(offset);
 
   // TODO: what if there is no data with such offset in range but some data more
   // than offset?
@@ -88,6 +83,31 @@ DataChunk SendDataBuffer::GetSlice(SafeStreamRingIndex offset,
   return chunk;
 }
 
+DataChunk SendDataBuffer::GetMessageSlice(SafeStreamRingIndex offset,
+                                          std::size_t max_size) {
+  using data_diff_type = DataBuffer::difference_type;
+
+  DataChunk chunk{{}, offset};
+
+  auto it = FindData(offset);
+  if (it == std::end(send_action_views_)) {
+    return chunk;
+  }
+
+  (*it)->Sending();
+  auto& sending_data = (*it)->sending_data();
+  auto begin_index =
+      static_cast<std::size_t>(sending_data.offset.Distance(offset));
+  auto data_size = std::min(sending_data.data.size() - begin_index, max_size);
+  auto data_begin = std::next(std::begin(sending_data.data),
+                              static_cast<data_diff_type>(begin_index));
+  auto data_end =
+      std::next(data_begin, static_cast<data_diff_type>(data_size));
+  chunk.data.assign(data_begin, data_end);
+  chunk.message_end = (begin_index + data_size) == sending_data.data.size();
+  return chunk;
+}
+
 void SendDataBuffer::Confirm(SafeStreamRingIndex offset) {
   send_action_views_.remove_if([this, offset](auto& action) {
     auto& sending_data = action->sending_data();
@@ -127,4 +147,14 @@ void SendDataBuffer::Stop(SafeStreamRingIndex offset) {
   });
 }
 
+std::list<ActionView<SendingDataAction>>::iterator SendDataBuffer::FindData(
+    SafeStreamRingIndex offset) {
+  return std::find_if(
+      std::begin(send_action_views_), std::end(send_action_views_),
+      [offset, window_size{window_size_}](auto& action) {
+        auto& sending_data = action->sending_data();
+        return sending_data.get_offset_range(window_size).InRange(offset);
+      });
+}
+
 }  // namespace ae
@@ -30,6 +30,7 @@ namespace ae {
 struct DataChunk {
   DataBuffer data;
   SafeStreamRingIndex offset;
+  bool message_end = false;  //< chunk ends the data added at once
 };
 
 class SendDataBuffer {
@@ -43,6 +44,8 @@ class SendDataBuffer {
   ActionView<SendingDataAction> AddData(SendingData&& data);
   // get data slice from the buffer
   DataChunk GetSlice(SafeStreamRingIndex offset, std::size_t max_size);
+  // get data slice not crossing the end of data added at once
+  DataChunk GetMessageSlice(SafeStreamRingIndex offset, std::size_t max_size);
   // confirm data has been sent
   void Confirm(SafeStreamRingIndex offset);
   // sending reject
@@ -53,6 +56,9 @@ class SendDataBuffer {
   std::size_t size() const { return buffer_size_; }
 
  private:
+  std::list<ActionView<SendingDataAction>>::iterator FindData(
+      SafeStreamRingIndex offset);
+
   SafeStreamRingIndex::type window_size_;
   ActionList<SendingDataAction> send_actions_;
   std::list<ActionView<SendingDataAction>> send_action_views_;
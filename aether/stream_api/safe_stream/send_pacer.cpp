@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/stream_api/safe_stream/send_pacer.h"
+
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+namespace ae {
+
+SendPacer::SendPacer(SafeStreamRingIndex::type window_size,
+                     Duration initial_rtt)
+    : window_size_{window_size},
+      burst_size_{},
+      srtt_{initial_rtt},
+      rtt_measured_{},
+      tokens_{} {}
+
+void SendPacer::AddRttSample(Duration rtt) {
+  if (!rtt_measured_) {
+    rtt_measured_ = true;
+    srtt_ = rtt;
+    return;
+  }
+  // srtt = 7/8 srtt + 1/8 rtt
+  srtt_ = std::chrono::duration_cast<Duration>((srtt_ * 7 + rtt) / 8);
+}
+
+void SendPacer::set_burst_size(std::size_t burst_size) {
+  burst_size_ = burst_size;
+}
+
+TimePoint SendPacer::SendTime(std::size_t size, TimePoint current_time) {
+  if (srtt_.count() == 0) {
+    return current_time;
+  }
+  Refill(current_time);
+  // chunk bigger than burst goes out on full bucket and leaves it in debt
+  auto need = static_cast<double>(std::min(size, burst_size_)) - tokens_;
+  if (need <= 0) {
+    return current_time;
+  }
+  auto wait = std::chrono::nanoseconds{
+      static_cast<std::chrono::nanoseconds::rep>(std::ceil(need / rate()))};
+  return current_time + std::chrono::duration_cast<Duration>(wait) +
+         Duration{1};
+}
+
+void SendPacer::Consume(std::size_t size) {
+  if (!last_refill_time_) {
+    return;
+  }
+  tokens_ -= static_cast<double>(size);
+}
+
+void SendPacer::Refill(TimePoint current_time) {
+  if (!last_refill_time_) {
+    // start with full bucket
+    tokens_ = static_cast<double>(burst_size_);
+    last_refill_time_ = current_time;
+    return;
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      current_time - *last_refill_time_);
+  last_refill_time_ = current_time;
+  tokens_ = std::min(
+      tokens_ + (static_cast<double>(elapsed.count()) * rate()),
+      static_cast<double>(burst_size_));
+}
+
+double SendPacer::rate() const {
+  auto srtt_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(srtt_).count();
+  return static_cast<double>(window_size_) / static_cast<double>(srtt_ns);
+}
+
+}  // namespace ae
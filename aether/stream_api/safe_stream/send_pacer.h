@@ -0,0 +1,65 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_STREAM_API_SAFE_STREAM_SEND_PACER_H_
+#define AETHER_STREAM_API_SAFE_STREAM_SEND_PACER_H_
+
+#include <cstddef>
+#include <optional>
+
+#include "aether/common.h"
+
+#include "aether/stream_api/safe_stream/safe_stream_types.h"
+
+namespace ae {
+/**
+ * \brief Token bucket to spread sending of the window over the round trip
+ * time instead of sending it in one burst.
+ * Tokens are bytes refilled with rate window_size / srtt, where srtt is
+ * smoothed like TCP SRTT. Until the first round trip is measured initial_rtt
+ * is used, it should be pessimistic like the confirm timeout.
+ */
+class SendPacer {
+ public:
+  SendPacer(SafeStreamRingIndex::type window_size, Duration initial_rtt);
+
+  void AddRttSample(Duration rtt);
+  void set_burst_size(std::size_t burst_size);
+
+  /**
+   * \brief Time when size bytes may be sent.
+   * current_time if it is allowed now.
+   */
+  TimePoint SendTime(std::size_t size, TimePoint current_time);
+  void Consume(std::size_t size);
+
+  Duration srtt() const { return srtt_; }
+
+ private:
+  void Refill(TimePoint current_time);
+  // bytes per nanosecond
+  double rate() const;
+
+  SafeStreamRingIndex::type window_size_;
+  std::size_t burst_size_;
+  Duration srtt_;
+  bool rtt_measured_;
+  double tokens_;
+  std::optional<TimePoint> last_refill_time_;
+};
+}  // namespace ae
+
+#endif  // AETHER_STREAM_API_SAFE_STREAM_SEND_PACER_H_
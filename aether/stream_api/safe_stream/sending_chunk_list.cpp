@@ -89,4 +89,15 @@ void SendingChunkList::RemoveUpTo(SafeStreamRingIndex offset) {
     return false;
   });
 }
+
+std::optional<TimePoint> SendingChunkList::FirstSendTime(
+    SafeStreamRingIndex end_offset) const {
+  auto it = std::find_if(
+      std::begin(chunks_), std::end(chunks_),
+      [&](auto const& sch) { return sch.end_offset == end_offset; });
+  if ((it == std::end(chunks_)) || (it->repeat_count != 1)) {
+    return std::nullopt;
+  }
+  return it->send_time;
+}
 }  // namespace ae
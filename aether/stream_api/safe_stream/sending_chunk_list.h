@@ -18,6 +18,7 @@
 #define AETHER_STREAM_API_SAFE_STREAM_SENDING_CHUNK_LIST_H_
 
 #include <list>
+#include <optional>
 
 #include "aether/common.h"
 
@@ -42,9 +43,16 @@ class SendingChunkList {
    */
   void RemoveUpTo(SafeStreamRingIndex offset);
 
+  /**
+   * \brief Send time of the chunk ending at the given offset.
+   * Only for chunks sent once, the confirm for repeated one is ambiguous.
+   */
+  std::optional<TimePoint> FirstSendTime(SafeStreamRingIndex end_offset) const;
+
   SendingChunk& front() { return chunks_.front(); }
   bool empty() const { return chunks_.empty(); }
   std::size_t size() const { return chunks_.size(); }
+  void clear() { chunks_.clear(); }
 
  private:
   SafeStreamRingIndex::type window_size_;
@@ -34,9 +34,7 @@ class SerializeGate final : public Gate<TIn, TOut, DataBuffer, DataBuffer> {
   ActionView<StreamWriteAction> Write(TIn&& in_data,
                                       TimePoint current_time) override {
     DataBuffer buffer;
-    auto wb = VectorWriter<PackedSize>{buffer};
-    auto os = omstream{wb};
-    os << std::move(in_data);
+    AppendSerialized<PackedSize>(buffer, in_data);
 
     assert(Base::out_);
     return Base::out_->Write(std::move(buffer), current_time);
@@ -20,6 +20,7 @@
 
 #include "aether/mstream.h"
 #include "aether/mstream_buffers.h"
+#include "aether/transport/data_buffer_pool.h"
 
 namespace ae {
 
@@ -27,12 +28,10 @@ ActionView<StreamWriteAction> SizedPacketGate::Write(DataBuffer&& buffer,
                                                      TimePoint current_time) {
   assert(out_);
 
-  PacketSize size = buffer.size();
-  DataBuffer write_buffer;
-  auto buffer_writer = VectorWriter<PacketSize>(write_buffer);
-  auto os = omstream{buffer_writer};
-  os << size;
-  os.write(buffer.data(), buffer.size());
+  // the same layout as size and data
+  auto write_buffer = GetDataBuffer(SerializedSize<PacketSize>(buffer));
+  AppendSerialized<PacketSize>(write_buffer, buffer);
+  RecycleDataBuffer(std::move(buffer));
 
   return out_->Write(std::move(write_buffer), current_time);
 }
@@ -56,7 +55,7 @@ void SizedPacketGate::LinkOut(OutGate& out) {
 
         for (auto packet = data_packet_collector_.PopPacket(); !packet.empty();
              packet = data_packet_collector_.PopPacket()) {
-          out_data_event_.Emit(packet);
+          out_data_event_.Emit(*packet);
         }
       });
 
@@ -65,6 +65,6 @@ void SplitterGate::OnStream(StreamApi::Stream const& message) {
   auto& new_stream = RegisterStream(message.stream_id);
   new_stream_event_.Emit(message.stream_id, new_stream);
 
-  new_stream.PutData(message.child_data.PackData());
+  new_stream.PutData(message.child_data.CopyData());
 }
 }  // namespace ae
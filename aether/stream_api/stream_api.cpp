@@ -21,16 +21,11 @@
 
 #include "aether/api_protocol/api_message.h"
 #include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/api_dispatch.h"
 
 namespace ae {
 bool StreamApi::LoadResult(MessageId message_id, ApiParser& parser) {
-  switch (message_id) {
-    case Stream::kMessageCode:
-      parser.Load<Stream>(*this);
-      return true;
-    default:
-      return false;
-  }
+  return DispatchLoad(*this, message_id, parser);
 }
 
 void StreamApi::LoadFactory(MessageId message_id, ApiParser& parser) {
@@ -72,7 +67,7 @@ StreamApiGate::StreamApiGate(ProtocolContext& protocol_context,
       [this](auto const& msg) {
         auto const& message = msg.message();
         if (stream_id_ == message.stream_id) {
-          out_data_event_.Emit(message.child_data.PackData());
+          out_data_event_.Emit(message.child_data.CopyData());
         }
       });
 }
@@ -85,7 +80,7 @@ StreamApiGate::StreamApiGate(StreamApiGate&& other) noexcept
       [this](auto const& msg) {
         auto const& message = msg.message();
         if (stream_id_ == message.stream_id) {
-          PutData(message.child_data.PackData());
+          PutData(message.child_data.CopyData());
         }
       });
 }
@@ -99,7 +94,7 @@ StreamApiGate& StreamApiGate::operator=(StreamApiGate&& other) noexcept {
         [this](auto const& msg) {
           auto const& message = msg.message();
           if (stream_id_ == message.stream_id) {
-            PutData(message.child_data.PackData());
+            PutData(message.child_data.CopyData());
           }
         });
   }
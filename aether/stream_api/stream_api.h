@@ -45,6 +45,8 @@ class StreamApi : public ApiClass {
     ChildData child_data;
   };
 
+  using Messages = ApiMessageList<ApiMessageCode<Stream::kMessageCode, Stream>>;
+
   bool LoadResult(MessageId message_id, ApiParser& parser);
   void LoadFactory(MessageId message_id, ApiParser& parser) override;
 
@@ -70,14 +70,10 @@ TransportWriteGate::TransportWriteGate(ActionContext action_context,
     : transport_{std::move(transport)},
       stream_info_{transport_->GetConnectionInfo().max_packet_size, {}, {}, {}},
       transport_connection_subscription_{
-          transport_->ConnectionSuccess().Subscribe([this]() {
-            stream_info_.max_element_size =
-                transport_->GetConnectionInfo().max_packet_size;
-            stream_info_.is_linked = true;
-            stream_info_.is_writeble = true;
-            stream_info_.is_soft_writable = true;
-            gate_update_event_.Emit();
-          })},
+          transport_->ConnectionSuccess().Subscribe(
+              [this]() { OnConnected(); })},
+      transport_error_subscription_{transport_->ConnectionError().Subscribe(
+          [this]() { OnDisconnected(); })},
       transport_read_data_subscription_{transport_->ReceiveEvent().Subscribe(
           [this](auto const& buffer, auto time_point) {
             ReceiveData(buffer, time_point);
@@ -88,14 +84,10 @@ TransportWriteGate::TransportWriteGate(TransportWriteGate&& other) noexcept
     : transport_{std::move(other.transport_)},
       stream_info_{other.stream_info_},
       transport_connection_subscription_{
-          transport_->ConnectionSuccess().Subscribe([this]() {
-            stream_info_.max_element_size =
-                transport_->GetConnectionInfo().max_packet_size;
-            stream_info_.is_linked = true;
-            stream_info_.is_writeble = true;
-            stream_info_.is_soft_writable = true;
-            gate_update_event_.Emit();
-          })},
+          transport_->ConnectionSuccess().Subscribe(
+              [this]() { OnConnected(); })},
+      transport_error_subscription_{transport_->ConnectionError().Subscribe(
+          [this]() { OnDisconnected(); })},
       transport_read_data_subscription_{transport_->ReceiveEvent().Subscribe(
           [this](auto const& buffer, auto time_point) {
             ReceiveData(buffer, time_point);
@@ -125,6 +117,26 @@ TransportWriteGate::gate_update_event() {
 
 StreamInfo TransportWriteGate::stream_info() const { return stream_info_; }
 
+void TransportWriteGate::OnConnected() {
+  stream_info_.max_element_size =
+      transport_->GetConnectionInfo().max_packet_size;
+  stream_info_.is_linked = true;
+  stream_info_.is_writeble = true;
+  stream_info_.is_soft_writable = true;
+  gate_update_event_.Emit();
+}
+
+void TransportWriteGate::OnDisconnected() {
+  // connection lost, streams above should stop sending until reconnect
+  if (!stream_info_.is_linked && !stream_info_.is_writeble) {
+    return;
+  }
+  stream_info_.is_linked = false;
+  stream_info_.is_writeble = false;
+  stream_info_.is_soft_writable = false;
+  gate_update_event_.Emit();
+}
+
 void TransportWriteGate::ReceiveData(DataBuffer const& data,
                                      TimePoint current_time) {
   AE_TELED_DEBUG("Received data from transport\n data:{}\ttime: {}", data,
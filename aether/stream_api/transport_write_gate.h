@@ -56,6 +56,8 @@ class TransportWriteGate final : public ByteIGate {
   StreamInfo stream_info() const override;
 
  private:
+  void OnConnected();
+  void OnDisconnected();
   void ReceiveData(DataBuffer const& data, TimePoint current_time);
 
   Ptr<ITransport> transport_;
@@ -66,6 +68,7 @@ class TransportWriteGate final : public ByteIGate {
   GateUpdateEvent gate_update_event_;
 
   Subscription transport_connection_subscription_;
+  Subscription transport_error_subscription_;
   Subscription transport_read_data_subscription_;
 
   ActionList<TransportStreamWriteAction> write_actions_;
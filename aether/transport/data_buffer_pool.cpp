@@ -0,0 +1,150 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aether/transport/data_buffer_pool.h"
+
+#include <utility>
+#include <algorithm>
+
+namespace ae {
+namespace _internal {
+// smallest class which fits size
+inline std::size_t UpperClass(std::size_t size) {
+  std::size_t index = 0;
+  while ((DataBufferPool::kMinClassSize << index) < size) {
+    ++index;
+  }
+  return index;
+}
+
+// largest class which is fitted by size
+inline std::size_t LowerClass(std::size_t size) {
+  std::size_t index = 0;
+  while ((DataBufferPool::kMinClassSize << (index + 1)) <= size) {
+    ++index;
+  }
+  return index;
+}
+
+// thread's pool with a flag checked after it's destroyed on thread exit
+struct LocalPool {
+  ~LocalPool() { destroyed = true; }
+
+  DataBufferPool pool;
+  static thread_local bool destroyed;
+};
+
+thread_local bool LocalPool::destroyed = false;
+}  // namespace _internal
+
+DataBufferPool::DataBufferPool(std::size_t max_pooled_bytes)
+    : max_pooled_bytes_{max_pooled_bytes} {}
+
+DataBufferPool* DataBufferPool::Local() {
+  if (_internal::LocalPool::destroyed) {
+    return nullptr;
+  }
+  static thread_local _internal::LocalPool local_pool;
+  return &local_pool.pool;
+}
+
+DataBuffer DataBufferPool::Get(std::size_t capacity) {
+  auto buffer = DataBuffer{};
+  if (capacity > kMaxClassSize) {
+    buffer.reserve(capacity);
+    return buffer;
+  }
+  auto index = _internal::UpperClass(capacity);
+  // buffers of the previous class may be large enough too, as they are
+  // returned with any capacity
+  if (index > 0) {
+    auto& buffers = classes_[index - 1];
+    auto it = std::find_if(
+        std::begin(buffers), std::end(buffers),
+        [capacity](auto const& b) { return b.capacity() >= capacity; });
+    if (it != std::end(buffers)) {
+      buffer = std::move(*it);
+      buffers.erase(it);
+      pooled_bytes_ -= buffer.capacity();
+      return buffer;
+    }
+  }
+  // a buffer from the next class is also good enough
+  for (auto i = index; i < std::min(index + 2, kClassCount); ++i) {
+    auto& buffers = classes_[i];
+    if (!buffers.empty()) {
+      buffer = std::move(buffers.back());
+      buffers.pop_back();
+      pooled_bytes_ -= buffer.capacity();
+      return buffer;
+    }
+  }
+  // allocate the whole class size to make it reusable
+  buffer.reserve(kMinClassSize << index);
+  return buffer;
+}
+
+void DataBufferPool::Put(DataBuffer&& buffer) {
+  auto capacity = buffer.capacity();
+  if ((capacity < kMinClassSize) || (capacity > kMaxClassSize) ||
+      (pooled_bytes_ + capacity > max_pooled_bytes_)) {
+    return;
+  }
+  auto& buffers = classes_[_internal::LowerClass(capacity)];
+  if (buffers.size() >= kMaxClassBuffers) {
+    return;
+  }
+  buffer.clear();
+  buffers.emplace_back(std::move(buffer));
+  pooled_bytes_ += capacity;
+}
+
+DataBuffer GetDataBuffer(std::size_t capacity) {
+  if (auto* pool = DataBufferPool::Local(); pool != nullptr) {
+    return pool->Get(capacity);
+  }
+  auto buffer = DataBuffer{};
+  buffer.reserve(capacity);
+  return buffer;
+}
+
+void RecycleDataBuffer(DataBuffer&& buffer) {
+  if (auto* pool = DataBufferPool::Local(); pool != nullptr) {
+    pool->Put(std::move(buffer));
+  }
+}
+
+PooledDataBuffer::PooledDataBuffer(DataBuffer data) : data_{std::move(data)} {}
+
+PooledDataBuffer::PooledDataBuffer(PooledDataBuffer&& other) noexcept
+    : data_{std::move(other.data_)} {
+  other.data_.clear();
+}
+
+PooledDataBuffer::~PooledDataBuffer() { RecycleDataBuffer(std::move(data_)); }
+
+PooledDataBuffer& PooledDataBuffer::operator=(
+    PooledDataBuffer&& other) noexcept {
+  if (this != &other) {
+    RecycleDataBuffer(std::move(data_));
+    data_ = std::move(other.data_);
+    other.data_.clear();
+  }
+  return *this;
+}
+
+DataBuffer PooledDataBuffer::Release() && { return std::move(data_); }
+}  // namespace ae
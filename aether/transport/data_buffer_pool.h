@@ -0,0 +1,111 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AETHER_TRANSPORT_DATA_BUFFER_POOL_H_
+#define AETHER_TRANSPORT_DATA_BUFFER_POOL_H_
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "aether/config.h"
+#include "aether/transport/data_buffer.h"
+
+namespace ae {
+/**
+ * \brief Free DataBuffers kept for reuse, grouped by capacity classes.
+ * Classes are powers of two from kMinClassSize to kMaxClassSize, buffers out
+ * of this range are not pooled. Each class keeps up to kMaxClassBuffers and
+ * total capacity kept is limited by max_pooled_bytes.
+ * Pool is not thread safe, use Local pool of the current thread.
+ */
+class DataBufferPool {
+ public:
+  static constexpr std::size_t kMinClassSize = 64;
+  static constexpr std::size_t kClassCount = 11;
+  static constexpr std::size_t kMaxClassSize = kMinClassSize
+                                               << (kClassCount - 1);
+  static constexpr std::size_t kMaxClassBuffers = 8;
+
+  explicit DataBufferPool(
+      std::size_t max_pooled_bytes = AE_DATA_BUFFER_POOL_SIZE);
+
+  /**
+   * \brief Pool of the current thread, nullptr if it's already destroyed on
+   * thread exit.
+   */
+  static DataBufferPool* Local();
+
+  /**
+   * \brief Get an empty buffer with at least capacity bytes of capacity.
+   */
+  DataBuffer Get(std::size_t capacity);
+  /**
+   * \brief Keep the buffer's memory for reuse.
+   */
+  void Put(DataBuffer&& buffer);
+
+  std::size_t pooled_bytes() const { return pooled_bytes_; }
+
+ private:
+  std::size_t max_pooled_bytes_;
+  std::size_t pooled_bytes_{};
+  std::array<std::vector<DataBuffer>, kClassCount> classes_;
+};
+
+/**
+ * \brief Get buffer from the current thread's pool.
+ */
+DataBuffer GetDataBuffer(std::size_t capacity);
+/**
+ * \brief Return buffer to the current thread's pool.
+ */
+void RecycleDataBuffer(DataBuffer&& buffer);
+
+/**
+ * \brief DataBuffer returned to the current thread's pool on destruction.
+ */
+class PooledDataBuffer {
+ public:
+  PooledDataBuffer() = default;
+  explicit PooledDataBuffer(DataBuffer data);
+  PooledDataBuffer(PooledDataBuffer&& other) noexcept;
+  PooledDataBuffer(PooledDataBuffer const&) = delete;
+  ~PooledDataBuffer();
+
+  PooledDataBuffer& operator=(PooledDataBuffer&& other) noexcept;
+  PooledDataBuffer& operator=(PooledDataBuffer const&) = delete;
+
+  DataBuffer& operator*() { return data_; }
+  DataBuffer const& operator*() const { return data_; }
+  DataBuffer* operator->() { return &data_; }
+  DataBuffer const* operator->() const { return &data_; }
+
+  std::uint8_t* data() { return data_.data(); }
+  std::uint8_t const* data() const { return data_.data(); }
+  std::size_t size() const { return data_.size(); }
+  bool empty() const { return data_.empty(); }
+
+  // take the buffer out, it won't be returned to the pool
+  DataBuffer Release() &&;
+
+ private:
+  DataBuffer data_;
+};
+}  // namespace ae
+
+#endif  // AETHER_TRANSPORT_DATA_BUFFER_POOL_H_
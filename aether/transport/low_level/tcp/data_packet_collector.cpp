@@ -29,42 +29,56 @@ Packet::Packet(std::size_t expected_size)
     : mem_buffer{static_cast<std::streamsize>(expected_size)},
       expected_packet_size{expected_size} {}
 
+Packet::Packet(MemStreamBuf<>&& buffer, std::size_t expected_size)
+    : mem_buffer{std::move(buffer)}, expected_packet_size{expected_size} {
+  mem_buffer.Reset();
+  mem_buffer.Reserve(static_cast<std::streamsize>(expected_size));
+}
+
 Packet::Packet(Packet&& other) noexcept
     : mem_buffer{std::move(other.mem_buffer)},
       expected_packet_size{other.expected_packet_size} {}
 
-void StreamDataPacketCollector::AddData(DataBuffer data_buffer) {
+void StreamDataPacketCollector::AddData(std::uint8_t const* data,
+                                        std::size_t size) {
   std::size_t offset{};
 
   // write data to all packets
-  while ((data_buffer.size() - offset) > 0) {
+  while ((size - offset) > 0) {
     if (packets_.empty() || IsPacketComplete(packets_.back())) {
-      auto [size, ofst] = GetPacketSize(data_buffer.data() + offset,
-                                        data_buffer.size() - offset);
+      auto [packet_size, ofst] = GetPacketSize(data + offset, size - offset);
       // no packet yet
-      if (size == 0) {
+      if (packet_size == 0) {
         return;
       }
       offset += ofst;
-      packets_.emplace(size);
+      NewPacket(packet_size);
     }
 
-    offset += WriteToPacket(packets_.back(), data_buffer.data() + offset,
-                            data_buffer.size() - offset);
+    offset += WriteToPacket(packets_.back(), data + offset, size - offset);
   }
 }
 
-std::vector<std::uint8_t> StreamDataPacketCollector::PopPacket() {
+void StreamDataPacketCollector::AddData(DataBuffer const& data_buffer) {
+  AddData(data_buffer.data(), data_buffer.size());
+}
+
+PooledDataBuffer StreamDataPacketCollector::PopPacket() {
   // no completed packet, return empty
   if (packets_.empty() || !IsPacketComplete(packets_.front())) {
     return {};
   }
   auto& packet = packets_.front();
-  std::vector<std::uint8_t> data_packet(packet.expected_packet_size);
-  std::copy(packet.mem_buffer.Data(),
-            packet.mem_buffer.Data() + packet.mem_buffer.Size(),
-            std::begin(data_packet));
-
+  auto data_packet =
+      PooledDataBuffer{GetDataBuffer(packet.expected_packet_size)};
+  auto const* packet_data =
+      reinterpret_cast<std::uint8_t const*>(packet.mem_buffer.Data());
+  data_packet->assign(packet_data, packet_data + packet.mem_buffer.Size());
+
+  if ((spare_buffers_.size() < kMaxSpareBuffers) &&
+      (packet.mem_buffer.Capacity() <= kMaxSpareCapacity)) {
+    spare_buffers_.emplace_back(std::move(packet.mem_buffer));
+  }
   packets_.pop();
   return data_packet;
 }
@@ -74,8 +88,17 @@ bool StreamDataPacketCollector::IsPacketComplete(Packet const& packet) {
          static_cast<std::streamsize>(packet.expected_packet_size);
 }
 
+void StreamDataPacketCollector::NewPacket(std::size_t expected_size) {
+  if (spare_buffers_.empty()) {
+    packets_.emplace(expected_size);
+    return;
+  }
+  packets_.emplace(std::move(spare_buffers_.back()), expected_size);
+  spare_buffers_.pop_back();
+}
+
 std::pair<std::size_t, std::size_t> StreamDataPacketCollector::GetPacketSize(
-    std::uint8_t* data, std::size_t size) {
+    std::uint8_t const* data, std::size_t size) {
   auto temp_buffer_size = temp_data_buffer_.size();
 
   // use no more than packet size may contain
@@ -102,12 +125,15 @@ std::pair<std::size_t, std::size_t> StreamDataPacketCollector::GetPacketSize(
 }
 
 std::size_t StreamDataPacketCollector::WriteToPacket(Packet& packet,
-                                                     std::uint8_t* data,
+                                                     std::uint8_t const* data,
                                                      std::size_t size) {
-  auto avail_cap = packet.mem_buffer.AvailableCapacity();
-  auto write_size = avail_cap > static_cast<std::streamsize>(size)
+  // reused buffer may be larger than the packet
+  auto remaining =
+      static_cast<std::streamsize>(packet.expected_packet_size) -
+      packet.mem_buffer.Size();
+  auto write_size = remaining > static_cast<std::streamsize>(size)
                         ? static_cast<std::streamsize>(size)
-                        : avail_cap;
+                        : remaining;
 
   packet.mem_buffer.sputn(reinterpret_cast<char const*>(data), write_size);
 
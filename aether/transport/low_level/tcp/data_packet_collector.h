@@ -27,6 +27,7 @@
 #include "aether/packed_int.h"
 
 #include "aether/transport/data_buffer.h"
+#include "aether/transport/data_buffer_pool.h"
 
 namespace ae {
 
@@ -34,6 +35,8 @@ using PacketSize = Packed<std::uint64_t, std::uint8_t, 250>;
 
 struct Packet {
   explicit Packet(std::size_t expected_size);
+  // reuse buffer memory for the new packet
+  Packet(MemStreamBuf<>&& buffer, std::size_t expected_size);
   Packet(Packet const&) = delete;
   Packet(Packet&& other) noexcept;
 
@@ -43,21 +46,28 @@ struct Packet {
 
 class StreamDataPacketCollector {
  public:
-  // fill packets in queue with provided stream data_buffer
-  void AddData(DataBuffer data_buffer);
+  // buffers of popped packets kept to reuse for the next ones
+  static constexpr std::size_t kMaxSpareBuffers = 2;
+  static constexpr std::streamsize kMaxSpareCapacity = 64 * 1024;
+
+  // fill packets in queue with provided stream data
+  void AddData(std::uint8_t const* data, std::size_t size);
+  void AddData(DataBuffer const& data_buffer);
   // pops a packet data if any, else return empty
-  std::vector<std::uint8_t> PopPacket();
+  PooledDataBuffer PopPacket();
 
  private:
   static bool IsPacketComplete(Packet const& packet);
+  void NewPacket(std::size_t expected_size);
   // return new packet size and data offset to start reading
-  std::pair<std::size_t, std::size_t> GetPacketSize(std::uint8_t* data,
+  std::pair<std::size_t, std::size_t> GetPacketSize(std::uint8_t const* data,
                                                     std::size_t size);
   // return data offset
-  std::size_t WriteToPacket(Packet& packet, std::uint8_t* data,
+  std::size_t WriteToPacket(Packet& packet, std::uint8_t const* data,
                             std::size_t size);
 
   std::queue<Packet> packets_;
+  std::vector<MemStreamBuf<>> spare_buffers_;
   // used if packet is not complete to get packet size
   std::vector<std::uint8_t> temp_data_buffer_;
 };
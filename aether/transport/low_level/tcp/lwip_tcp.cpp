@@ -248,10 +248,8 @@ ActionView<PacketSendAction> LwipTcpTransport::Send(DataBuffer data,
   assert(socket_ != kInvalidSocket);
 
   auto packet_data = std::vector<std::uint8_t>{};
-  VectorWriter<PacketSize> vw{packet_data};
-  auto os = omstream{vw};
   // copy data with size
-  os << data;
+  AppendSerialized<PacketSize>(packet_data, data);
 
   return socket_packet_queue_manager_.AddPacket(LwipTcpPacketSendAction{
       action_context_, socket_, std::move(packet_data), current_time});
@@ -307,7 +305,7 @@ void LwipTcpTransport::ReadSocket(TimePoint current_time) {
   } else {  // Data received
     AE_TELE_DEBUG("TcpTransportOnData", "Get data size {}", data.size());
     data.resize(static_cast<std::size_t>(r));
-    data_packet_collector_.AddData(std::move(data));
+    data_packet_collector_.AddData(data);
     OnDataReceived(current_time);
   }
 }
@@ -316,7 +314,7 @@ void LwipTcpTransport::OnDataReceived(TimePoint current_time) {
   for (auto data = data_packet_collector_.PopPacket(); !data.empty();
        data = data_packet_collector_.PopPacket()) {
     AE_TELE_DEBUG("TcpTransportReceive", "Receive data size {}", data.size());
-    data_receive_event_.Emit(std::move(data), current_time);
+    data_receive_event_.Emit(*data, current_time);
   }
 }
 
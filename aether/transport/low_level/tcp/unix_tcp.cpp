@@ -34,6 +34,7 @@
 #  include "aether/mstream_buffers.h"
 #  include "aether/mstream.h"
 #  include "aether/tele/ios_time.h"
+#  include "aether/transport/data_buffer_pool.h"
 #  include "aether/tele/tele.h"
 
 // Workaround for BSD and MacOS
@@ -200,11 +201,10 @@ ActionView<PacketSendAction> UnixTcpTransport::Send(DataBuffer data,
                 FormatTimePoint("%H:%M:%S", current_time));
   assert(socket_ != kInvalidSocket);
 
-  auto packet_data = std::vector<std::uint8_t>{};
-  VectorWriter<PacketSize> vw{packet_data};
-  auto os = omstream{vw};
+  auto packet_data = GetDataBuffer(SerializedSize<PacketSize>(data));
   // copy data with size
-  os << data;
+  AppendSerialized<PacketSize>(packet_data, data);
+  RecycleDataBuffer(std::move(data));
 
   return socket_packet_queue_manager_.AddPacket(UnixPacketSendAction{
       action_context_, socket_, std::move(packet_data), current_time});
@@ -246,12 +246,13 @@ void UnixTcpTransport::OnSocketEvent(TimePoint current_time) {
 void UnixTcpTransport::ReadSocket(TimePoint current_time) {
   int count;
   while (ioctl(socket_, FIONREAD, &count) == 0 && count > 0) {
-    DataBuffer data(static_cast<size_t>(count));
+    auto data = PooledDataBuffer{GetDataBuffer(static_cast<size_t>(count))};
+    data->resize(static_cast<size_t>(count));
     auto r = recv(socket_, data.data(), static_cast<std::size_t>(count), 0);
     if (r > 0) {
       AE_TELE_DEBUG("TcpTransportOnData", "Get data size {}\ndata: {}",
-                    data.size(), data);
-      data_packet_collector_.AddData(std::move(data));
+                    data.size(), *data);
+      data_packet_collector_.AddData(*data);
     } else if (r < 1) {
       AE_TELED_ERROR("Recv error {} {}", errno, strerror(errno));
       Disconnect();
@@ -273,7 +274,7 @@ void UnixTcpTransport::OnDataReceived(TimePoint current_time) {
   for (auto data = data_packet_collector_.PopPacket(); !data.empty();
        data = data_packet_collector_.PopPacket()) {
     AE_TELE_DEBUG("TcpTransportReceive", "Receive data size {}", data.size());
-    data_receive_event_.Emit(data, current_time);
+    data_receive_event_.Emit(*data, current_time);
   }
 }
 
@@ -76,7 +76,7 @@ class UnixTcpTransport : public ITransport {
 
    private:
     int socket_;
-    DataBuffer data_;
+    PooledDataBuffer data_;
     TimePoint current_time_;
     std::size_t sent_offset_ = 0;
     Subscription state_changed_subscription_;
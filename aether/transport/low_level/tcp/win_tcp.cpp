@@ -333,10 +333,8 @@ ActionView<PacketSendAction> WinTcpTransport::Send(DataBuffer data,
                 FormatTimePoint("UTC :%Y-%m-%d %H:%M:%S", current_time));
 
   auto packet_data = std::vector<std::uint8_t>{};
-  VectorWriter<PacketSize> vw{packet_data};
-  auto os = omstream{vw};
   // copy data with size
-  os << data;
+  AppendSerialized<PacketSize>(packet_data, data);
 
   return socket_packet_queue_manager_.AddPacket(WinTcpPacketSendAction{
       action_context_, sync_socket_, send_event_, write_overlapped_,
@@ -428,7 +426,7 @@ void WinTcpTransport::HandleReceivedData() {
   for (auto packet = data_packet_collector_.PopPacket(); !packet.empty();
        packet = data_packet_collector_.PopPacket()) {
     // TODO: get time from action
-    data_receive_event_.Emit(std::move(packet), TimePoint::clock::now());
+    data_receive_event_.Emit(*packet, TimePoint::clock::now());
   }
 }
 
@@ -453,7 +451,7 @@ void WinTcpTransport::OnRecv() {
   }
 
   recv_tmp_buffer_.resize(static_cast<std::size_t>(bytes_transferred));
-  data_packet_collector_.AddData(std::move(recv_tmp_buffer_));
+  data_packet_collector_.AddData(recv_tmp_buffer_);
 }
 
 void WinTcpTransport::Disconnect() {
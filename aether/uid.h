@@ -20,6 +20,8 @@
 #include <array>
 #include <cstdint>
 
+#include "aether/mstream.h"
+
 namespace ae {
 
 struct Uid;
@@ -42,6 +44,12 @@ struct Uid {
   std::array<std::uint8_t, kSize> value;
 };
 
+// vectors of uids are written as a single block
+template <>
+struct IsTriviallySerializable<Uid> : std::true_type {
+  static_assert(sizeof(Uid) == Uid::kSize);
+};
+
 }  // namespace ae
 
 #endif  // AETHER_UID_H_ */
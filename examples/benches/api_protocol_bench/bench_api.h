@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_API_PROTOCOL_BENCH_BENCH_API_H_
+#define EXAMPLES_BENCHES_API_PROTOCOL_BENCH_BENCH_API_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/api_dispatch.h"
+
+namespace ae::bench {
+template <MessageId Code>
+struct BenchMessage : public Message<BenchMessage<Code>> {
+  static constexpr std::uint32_t kMessageId = 100 + Code;
+
+  std::uint32_t value_;
+
+  template <typename T>
+  void Serializator(T& s) {
+    s & value_;
+  }
+};
+
+class BenchApiBase : public ApiClass {
+ public:
+  template <MessageId Code>
+  void Execute(BenchMessage<Code>&& message, ApiParser& parser) {
+    parser.Context().MessageNotify(std::move(message));
+  }
+
+  template <MessageId Code>
+  void Pack(BenchMessage<Code>&& message, ApiPacker& packer) {
+    packer.Pack(Code, std::move(message));
+  }
+};
+
+// messages loaded with a switch as api classes did before dispatch tables
+class BenchSwitchApi : public BenchApiBase {
+ public:
+  static constexpr auto kClassId = 10;
+
+  void LoadFactory(MessageId code, ApiParser& parser) override {
+    switch (code) {
+      case 0:
+        parser.Load<BenchMessage<0>>(*this);
+        break;
+      case 1:
+        parser.Load<BenchMessage<1>>(*this);
+        break;
+      case 2:
+        parser.Load<BenchMessage<2>>(*this);
+        break;
+      case 3:
+        parser.Load<BenchMessage<3>>(*this);
+        break;
+      case 4:
+        parser.Load<BenchMessage<4>>(*this);
+        break;
+      case 5:
+        parser.Load<BenchMessage<5>>(*this);
+        break;
+      case 6:
+        parser.Load<BenchMessage<6>>(*this);
+        break;
+      case 7:
+        parser.Load<BenchMessage<7>>(*this);
+        break;
+      default:
+        break;
+    }
+  }
+};
+
+class BenchTableApi : public BenchApiBase {
+ public:
+  static constexpr auto kClassId = 11;
+
+  using Messages = ApiMessageList<
+      ApiMessageCode<0, BenchMessage<0>>, ApiMessageCode<1, BenchMessage<1>>,
+      ApiMessageCode<2, BenchMessage<2>>, ApiMessageCode<3, BenchMessage<3>>,
+      ApiMessageCode<4, BenchMessage<4>>, ApiMessageCode<5, BenchMessage<5>>,
+      ApiMessageCode<6, BenchMessage<6>>, ApiMessageCode<7, BenchMessage<7>>>;
+
+  void LoadFactory(MessageId code, ApiParser& parser) override {
+    DispatchLoad(*this, code, parser);
+  }
+};
+}  // namespace ae::bench
+
+#endif  // EXAMPLES_BENCHES_API_PROTOCOL_BENCH_BENCH_API_H_
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api_protocol_bench/dispatch_bench.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/protocol_context.h"
+
+#include "api_protocol_bench/bench_api.h"
+
+namespace ae::bench {
+namespace {
+double PerSecond(std::size_t count,
+                 std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+}
+
+template <MessageId... Codes>
+auto SubscribeBenchMessages(ProtocolContext& p_context, std::size_t& received,
+                            std::integer_sequence<MessageId, Codes...>) {
+  return std::array{p_context.OnMessage<BenchMessage<Codes>>(
+      [&](auto const&) { ++received; })...};
+}
+
+template <MessageId... Codes>
+std::vector<std::uint8_t> PackBenchMessages(
+    std::size_t message_count, std::integer_sequence<MessageId, Codes...>) {
+  ProtocolContext p_context{};
+  std::vector<std::uint8_t> pack_data;
+  {
+    auto packer = ApiPacker{p_context, pack_data};
+    for (std::size_t i = 0; i < message_count; i += sizeof...(Codes)) {
+      (packer.Pack(Codes, BenchMessage<Codes>{{}, Codes}), ...);
+    }
+  }
+  return pack_data;
+}
+
+template <typename TApi>
+DispatchResult Measure(std::string mode, std::size_t packet_count,
+                       std::size_t messages_in_packet,
+                       std::vector<std::uint8_t> const& pack_data) {
+  ProtocolContext p_context{};
+  // received messages keep the result observable
+  std::size_t received = 0;
+  auto _ = SubscribeBenchMessages(p_context, received,
+                                  std::make_integer_sequence<MessageId, 8>{});
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < packet_count; ++i) {
+    auto root = TApi{};
+    auto parser = ApiParser{p_context, pack_data};
+    parser.Parse(root);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return DispatchResult{std::move(mode), messages_in_packet,
+                        PerSecond(received, duration)};
+}
+}  // namespace
+
+ParseDispatchRate::ParseDispatchRate(std::size_t packet_count)
+    : packet_count_{packet_count} {}
+
+std::vector<DispatchResult> ParseDispatchRate::Run(
+    std::size_t messages_in_packet) {
+  auto pack_data = PackBenchMessages(
+      messages_in_packet, std::make_integer_sequence<MessageId, 8>{});
+
+  std::vector<DispatchResult> results;
+  results.emplace_back(Measure<BenchSwitchApi>(
+      "switch", packet_count_, messages_in_packet, pack_data));
+  results.emplace_back(Measure<BenchTableApi>(
+      "dispatch table", packet_count_, messages_in_packet, pack_data));
+  return results;
+}
+}  // namespace ae::bench
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_API_PROTOCOL_BENCH_DISPATCH_BENCH_H_
+#define EXAMPLES_BENCHES_API_PROTOCOL_BENCH_DISPATCH_BENCH_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct DispatchResult {
+  std::string mode;  //< switch or dispatch table
+  std::size_t messages_in_packet;
+  double messages_per_second;
+};
+
+/**
+ * \brief Measures parse and dispatch of received packets with small
+ * messages. Messages are loaded by a switch over message codes or by the
+ * compile time dispatch table.
+ */
+class ParseDispatchRate {
+ public:
+  explicit ParseDispatchRate(std::size_t packet_count);
+
+  std::vector<DispatchResult> Run(std::size_t messages_in_packet);
+
+ private:
+  std::size_t packet_count_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::DispatchResult> {
+  static void Print(std::ostream& s, bench::DispatchResult const& r) {
+    s << r.mode << "," << r.messages_in_packet << "," << r.messages_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_API_PROTOCOL_BENCH_DISPATCH_BENCH_H_
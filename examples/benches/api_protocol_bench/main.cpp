@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <iostream>
+
+#include "aether/port/tele_init.h"
+#include "aether/tele/tele.h"
+
+#include "api_protocol_bench/dispatch_bench.h"
+#include "api_protocol_bench/nested_parse_bench.h"
+#include "api_protocol_bench/send_result_bench.h"
+
+namespace ae::bench {
+static constexpr std::size_t kDispatchPackets = 20'000;
+static constexpr std::size_t kMessagesInPacket = 64;
+static constexpr std::size_t kNestedPackets = 20'000;
+static constexpr std::size_t kSendResultRequests = 1'000'000;
+static constexpr std::size_t kRequestsInFlight = 16;
+
+int api_protocol_bench(std::ostream& result_stream) {
+  TeleInit::Init();
+
+  AE_TELED_INFO("Run parse dispatch bench");
+  auto dispatch_results =
+      ParseDispatchRate{kDispatchPackets}.Run(kMessagesInPacket);
+
+  result_stream << "mode,messages in packet,messages/s\n";
+  for (auto const& result : dispatch_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  AE_TELED_INFO("Run nested parse bench");
+  auto nested_results = NestedParseRate{kNestedPackets}.Run({1, 3, 8});
+
+  result_stream << "\ndepth,packets/s\n";
+  for (auto const& result : nested_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  AE_TELED_INFO("Run send result bench");
+  auto send_result_results =
+      SendResultRate{kSendResultRequests}.Run(kRequestsInFlight);
+
+  result_stream << "\nmode,in flight,requests/s\n";
+  for (auto const& result : send_result_results) {
+    Format(result_stream, "{}\n", result);
+  }
+  return 0;
+}
+}  // namespace ae::bench
+
+int main() { return ae::bench::api_protocol_bench(std::cout); }
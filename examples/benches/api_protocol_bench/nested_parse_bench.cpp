@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api_protocol_bench/nested_parse_bench.h"
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "aether/api_protocol/child_data.h"
+#include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/packet_builder.h"
+#include "aether/api_protocol/protocol_context.h"
+#include "aether/stream_api/stream_api.h"
+
+#include "api_protocol_bench/bench_api.h"
+
+namespace ae::bench {
+namespace {
+double PerSecond(std::size_t count,
+                 std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+}
+
+// stream in stream ... with two bench messages inside
+std::vector<std::uint8_t> PackNested(ProtocolContext& p_context,
+                                     std::size_t depth) {
+  auto child = ChildData{PacketBuilder{
+      p_context,
+      PackMessage{BenchTableApi{}, BenchMessage<0>{{}, 1},
+                  BenchMessage<1>{{}, 2}},
+  }};
+  for (auto i = depth; i > 0; --i) {
+    child = ChildData{PacketBuilder{
+        p_context, PackMessage{StreamApi{}, StreamApi::Stream{
+                                                {}, StreamId(i - 1),
+                                                std::move(child)}}}};
+  }
+  return child.CopyData();
+}
+
+NestedParseResult Measure(std::size_t packet_count, std::size_t depth) {
+  ProtocolContext p_context{};
+  auto const pack_data = PackNested(p_context, depth);
+
+  // received messages keep the result observable
+  std::size_t received = 0;
+  auto _0 = p_context.OnMessage<BenchMessage<0>>(
+      [&](auto const&) { ++received; });
+  auto _1 = p_context.OnMessage<BenchMessage<1>>(
+      [&](auto const&) { ++received; });
+  auto _2 = p_context.OnMessage<StreamApi::Stream>([&](auto const& event) {
+    auto const& message = event.message();
+    auto parser = ApiParser{p_context, message.child_data};
+    if (std::size_t{message.stream_id} + 1 < depth) {
+      auto api = StreamApi{};
+      parser.Parse(api);
+    } else {
+      auto api = BenchTableApi{};
+      parser.Parse(api);
+    }
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < packet_count; ++i) {
+    auto root = StreamApi{};
+    auto parser = ApiParser{p_context, pack_data};
+    parser.Parse(root);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return NestedParseResult{depth, PerSecond(received / 2, duration)};
+}
+}  // namespace
+
+NestedParseRate::NestedParseRate(std::size_t packet_count)
+    : packet_count_{packet_count} {}
+
+std::vector<NestedParseResult> NestedParseRate::Run(
+    std::vector<std::size_t> const& depths) {
+  std::vector<NestedParseResult> results;
+  for (auto depth : depths) {
+    results.emplace_back(Measure(packet_count_, depth));
+  }
+  return results;
+}
+}  // namespace ae::bench
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_API_PROTOCOL_BENCH_NESTED_PARSE_BENCH_H_
+#define EXAMPLES_BENCHES_API_PROTOCOL_BENCH_NESTED_PARSE_BENCH_H_
+
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct NestedParseResult {
+  std::size_t depth;
+  double packets_per_second;
+};
+
+/**
+ * \brief Measures parse of packets with messages nested in StreamApi::Stream
+ * levels. Each level parses its child data in place.
+ */
+class NestedParseRate {
+ public:
+  explicit NestedParseRate(std::size_t packet_count);
+
+  std::vector<NestedParseResult> Run(std::vector<std::size_t> const& depths);
+
+ private:
+  std::size_t packet_count_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::NestedParseResult> {
+  static void Print(std::ostream& s, bench::NestedParseResult const& r) {
+    s << r.depth << "," << r.packets_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_API_PROTOCOL_BENCH_NESTED_PARSE_BENCH_H_
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api_protocol_bench/send_result_bench.h"
+
+#include <map>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+#include "aether/common.h"
+#include "aether/api_protocol/send_result_table.h"
+
+namespace ae::bench {
+namespace {
+double PerSecond(std::size_t count,
+                 std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+}
+
+template <typename TFunc>
+SendResultBenchResult Measure(std::string mode, std::size_t request_count,
+                              std::size_t in_flight, TFunc&& request) {
+  // taken results keep the result observable
+  std::size_t results = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < request_count; ++i) {
+    results += request(i);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return SendResultBenchResult{std::move(mode), in_flight,
+                               PerSecond(results, duration)};
+}
+}  // namespace
+
+SendResultRate::SendResultRate(std::size_t request_count)
+    : request_count_{request_count} {}
+
+std::vector<SendResultBenchResult> SendResultRate::Run(
+    std::size_t in_flight) {
+  auto callback = [](ApiParser&) {};
+
+  std::vector<SendResultBenchResult> results;
+  auto map = std::map<std::uint32_t, std::function<void(ApiParser&)>>{};
+  results.emplace_back(
+      Measure("map", request_count_, in_flight, [&](std::size_t i) {
+        map.emplace(static_cast<std::uint16_t>(i), callback);
+        if (i < in_flight) {
+          return std::size_t{0};
+        }
+        auto it = map.find(static_cast<std::uint16_t>(i - in_flight));
+        auto cb = std::move(it->second);
+        map.erase(it);
+        return std::size_t{cb ? 1u : 0u};
+      }));
+
+  auto time = TimePoint{};
+  auto table = SendResultTable{in_flight * 2, in_flight * 2,
+                               std::chrono::seconds{30}};
+  results.emplace_back(Measure(
+      "send result table", request_count_, in_flight, [&](std::size_t i) {
+        table.Add(static_cast<std::uint16_t>(i), callback, {}, time);
+        if (i < in_flight) {
+          return std::size_t{0};
+        }
+        auto cb = table.TakeResult(static_cast<std::uint16_t>(i - in_flight));
+        return std::size_t{cb ? 1u : 0u};
+      }));
+  return results;
+}
+}  // namespace ae::bench
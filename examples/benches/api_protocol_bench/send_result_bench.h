@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_API_PROTOCOL_BENCH_SEND_RESULT_BENCH_H_
+#define EXAMPLES_BENCHES_API_PROTOCOL_BENCH_SEND_RESULT_BENCH_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct SendResultBenchResult {
+  std::string mode;  //< map or send result table
+  std::size_t in_flight;
+  double requests_per_second;
+};
+
+/**
+ * \brief Measures adding requests and taking their results with a fixed
+ * count of requests in flight. A std::map keyed by request id as pending
+ * requests were kept before is compared with SendResultTable.
+ */
+class SendResultRate {
+ public:
+  explicit SendResultRate(std::size_t request_count);
+
+  std::vector<SendResultBenchResult> Run(std::size_t in_flight);
+
+ private:
+  std::size_t request_count_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::SendResultBenchResult> {
+  static void Print(std::ostream& s, bench::SendResultBenchResult const& r) {
+    s << r.mode << "," << r.in_flight << "," << r.requests_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_API_PROTOCOL_BENCH_SEND_RESULT_BENCH_H_
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_bench/box_bench.h"
+
+#include <chrono>
+#include <vector>
+#include <utility>
+
+#include "aether/config.h"
+#include "aether/obj/ptr.h"
+#include "aether/crypto/key.h"
+#include "aether/crypto/icrypto_provider.h"
+#include "aether/crypto/async_crypto_provider.h"
+#include "aether/crypto/sodium/sodium_box_crypto_provider.h"
+
+#include "test_utils/mock_key_provider.h"
+
+namespace ae::bench {
+namespace {
+double PerSecond(std::size_t count,
+                 std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+}
+
+BoxResult Run(std::string mode, IEncryptProvider& encrypt,
+              IDecryptProvider& decrypt, std::size_t message_size,
+              std::size_t message_count) {
+  auto message = DataBuffer(message_size);
+  auto encrypted = std::vector<DataBuffer>{};
+  encrypted.reserve(message_count);
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < message_count; ++i) {
+    encrypted.emplace_back(encrypt.Encrypt(message));
+  }
+  auto encrypt_duration = std::chrono::steady_clock::now() - start;
+
+  auto decrypted = DataBuffer{};
+  start = std::chrono::steady_clock::now();
+  for (auto const& e : encrypted) {
+    decrypt.DecryptInto(e, decrypted);
+  }
+  auto decrypt_duration = std::chrono::steady_clock::now() - start;
+
+  return BoxResult{std::move(mode), message_size, encrypt.EncryptOverhead(),
+                   PerSecond(message_count, encrypt_duration),
+                   PerSecond(message_count, decrypt_duration)};
+}
+}  // namespace
+
+BoxResult BoxMessageRate::RunSeal(std::size_t message_size,
+                                  std::size_t message_count) {
+#if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+  SodiumCurvePublicKey server_pub;
+  SodiumCurveSecretKey server_sec;
+  crypto_box_keypair(server_pub.key.data(), server_sec.key.data());
+
+  auto key_provider = MakePtr<MockAsyncKeyProvider>(server_pub, server_sec);
+  auto encrypt = AsyncEncryptProvider{key_provider};
+  auto decrypt = AsyncDecryptProvider{key_provider};
+  return Run("box seal", encrypt, decrypt, message_size, message_count);
+#else
+  return BoxResult{"box seal", message_size, 0, 0, 0};
+#endif
+}
+
+BoxResult BoxMessageRate::RunPrecomputed(std::size_t message_size,
+                                         std::size_t message_count) {
+#if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+  SodiumCurvePublicKey client_pub;
+  SodiumCurveSecretKey client_sec;
+  crypto_box_keypair(client_pub.key.data(), client_sec.key.data());
+  SodiumCurvePublicKey server_pub;
+  SodiumCurveSecretKey server_sec;
+  crypto_box_keypair(server_pub.key.data(), server_sec.key.data());
+
+  auto encrypt = SodiumBoxEncryptProvider{
+      MakePtr<MockAsyncKeyProvider>(server_pub, client_sec)};
+  auto decrypt = SodiumBoxDecryptProvider{
+      MakePtr<MockAsyncKeyProvider>(client_pub, server_sec)};
+  return Run("precomputed box", encrypt, decrypt, message_size,
+             message_count);
+#else
+  return BoxResult{"precomputed box", message_size, 0, 0, 0};
+#endif
+}
+}  // namespace ae::bench
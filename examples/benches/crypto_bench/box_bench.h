@@ -0,0 +1,58 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_CRYPTO_BENCH_BOX_BENCH_H_
+#define EXAMPLES_BENCHES_CRYPTO_BENCH_BOX_BENCH_H_
+
+#include <string>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct BoxResult {
+  std::string mode;  //< box seal or precomputed box
+  std::size_t message_size;
+  std::size_t overhead;
+  double encrypt_per_second;
+  double decrypt_per_second;
+};
+
+/**
+ * \brief Measures registration style messages encrypted to the same server
+ * public key. Box seal makes a key exchange for each message, precomputed box
+ * makes it once per peer key.
+ */
+class BoxMessageRate {
+ public:
+  BoxResult RunSeal(std::size_t message_size, std::size_t message_count);
+  BoxResult RunPrecomputed(std::size_t message_size,
+                           std::size_t message_count);
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::BoxResult> {
+  static void Print(std::ostream& s, bench::BoxResult const& r) {
+    s << r.mode << "," << r.message_size << "," << r.overhead << ","
+      << r.encrypt_per_second << "," << r.decrypt_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_CRYPTO_BENCH_BOX_BENCH_H_
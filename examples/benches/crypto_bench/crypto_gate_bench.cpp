@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_bench/crypto_gate_bench.h"
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include "aether/stream_api/istream.h"
+#include "aether/stream_api/crypto_stream.h"
+#include "aether/crypto/sync_crypto_provider.h"
+
+namespace ae::bench {
+namespace {
+/**
+ * \brief Keeps the last written buffer and emits received packets.
+ */
+class PacketSinkGate final : public ByteGate {
+ public:
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint /* current_time */) override {
+    last_ = std::move(buffer);
+    return {};
+  }
+
+  StreamInfo stream_info() const override {
+    return StreamInfo{kMaxPacketSize, true, true, true};
+  }
+
+  void Receive(DataBuffer const& buffer) { out_data_event_.Emit(buffer); }
+
+  DataBuffer& last() { return last_; }
+
+ private:
+  static constexpr std::size_t kMaxPacketSize = 1024 * 1024;
+
+  DataBuffer last_;
+};
+
+double MegabytesPerSecond(std::size_t bytes,
+                          std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(bytes) / (1024 * 1024) / seconds
+                     : 0;
+}
+
+/**
+ * \brief The crypto gate with allocating Encrypt and Decrypt calls.
+ */
+class CopyCryptoGate final : public ByteGate {
+ public:
+  CopyCryptoGate(Ptr<IEncryptProvider> crypto_encrypt,
+                 Ptr<IDecryptProvider> crypto_decrypt)
+      : crypto_encrypt_{std::move(crypto_encrypt)},
+        crypto_decrypt_{std::move(crypto_decrypt)} {}
+
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint current_time) override {
+    return out_->Write(crypto_encrypt_->Encrypt(buffer), current_time);
+  }
+
+  void LinkOut(OutGate& out) override {
+    out_ = &out;
+    out_data_subscription_ =
+        out.out_data_event().Subscribe([this](DataBuffer const& buffer) {
+          out_data_event_.Emit(crypto_decrypt_->Decrypt(buffer));
+        });
+  }
+
+ private:
+  Ptr<IEncryptProvider> crypto_encrypt_;
+  Ptr<IDecryptProvider> crypto_decrypt_;
+};
+
+template <typename TCryptoGate>
+CryptoGateResult Run(TCryptoGate& crypto_gate, std::string mode,
+                     std::size_t overhead, std::size_t packet_size,
+                     std::size_t bytes_count) {
+  auto sink = PacketSinkGate{};
+  crypto_gate.LinkOut(sink);
+
+  std::size_t decrypted_bytes = 0;
+  auto _ = crypto_gate.out_data_event().Subscribe(
+      [&](DataBuffer const& buffer) { decrypted_bytes += buffer.size(); });
+
+  auto count = bytes_count / packet_size + 1;
+  // tailroom for mac and nonce
+  auto data = DataBuffer{};
+  data.reserve(packet_size + overhead);
+
+  auto current_time = TimePoint::clock::now();
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < count; ++i) {
+    data.resize(packet_size);
+    crypto_gate.Write(std::move(data), current_time);
+    data = std::move(sink.last());
+  }
+  auto encrypt_duration = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < count; ++i) {
+    sink.Receive(data);
+  }
+  auto decrypt_duration = std::chrono::steady_clock::now() - start;
+
+  return CryptoGateResult{
+      packet_size, std::move(mode),
+      MegabytesPerSecond(count * packet_size, encrypt_duration),
+      MegabytesPerSecond(decrypted_bytes, decrypt_duration)};
+}
+
+}  // namespace
+
+CryptoGateThroughput::CryptoGateThroughput(Ptr<ISyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {}
+
+CryptoGateResult CryptoGateThroughput::RunCopy(std::size_t packet_size,
+                                               std::size_t bytes_count) {
+  auto encrypt = MakePtr<SyncEncryptProvider>(key_provider_);
+  auto overhead = encrypt->EncryptOverhead();
+  auto crypto_gate =
+      CopyCryptoGate{std::move(encrypt),
+                     MakePtr<SyncDecryptProvider>(key_provider_)};
+  return Run(crypto_gate, "copy", overhead, packet_size, bytes_count);
+}
+
+CryptoGateResult CryptoGateThroughput::RunInPlace(std::size_t packet_size,
+                                                  std::size_t bytes_count) {
+  auto encrypt = MakePtr<SyncEncryptProvider>(key_provider_);
+  auto overhead = encrypt->EncryptOverhead();
+  auto crypto_gate = CryptoGate{std::move(encrypt),
+                                MakePtr<SyncDecryptProvider>(key_provider_)};
+  return Run(crypto_gate, "in place", overhead, packet_size, bytes_count);
+}
+}  // namespace ae::bench
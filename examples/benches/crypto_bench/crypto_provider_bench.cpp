@@ -0,0 +1,278 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_bench/crypto_provider_bench.h"
+
+#include <chrono>
+#include <cassert>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+
+#include "aether/config.h"
+
+#include "aether/crypto/key.h"
+#include "aether/crypto/sign.h"
+#include "aether/crypto/key_gen.h"
+#include "aether/crypto/signed_key.h"
+#include "aether/crypto/crypto_nonce.h"
+#include "aether/crypto/sync_crypto_provider.h"
+#include "aether/crypto/async_crypto_provider.h"
+#include "aether/crypto/sodium/sodium_aes_gcm_crypto_provider.h"
+
+#include "test_utils/mock_key_provider.h"
+
+namespace ae::bench {
+namespace {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+constexpr char kSyncBackend[] = "sodium chacha20-poly1305";
+#elif AE_CRYPTO_SYNC == AE_HYDRO_CRYPTO_SK
+constexpr char kSyncBackend[] = "hydrogen secretbox";
+#endif
+
+#if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+constexpr char kAsyncBackend[] = "sodium box seal";
+#elif AE_CRYPTO_ASYNC == AE_HYDRO_CRYPTO_PK
+constexpr char kAsyncBackend[] = "hydrogen kx";
+#endif
+
+#if AE_KDF == AE_SODIUM_KDF
+constexpr char kKdfBackend[] = "sodium kdf";
+#elif AE_KDF == AE_HYDRO_KDF
+constexpr char kKdfBackend[] = "hydrogen kdf";
+#endif
+
+// cheap operations are timed in batches to hide the clock cost
+constexpr std::size_t kSmallOpBatch = 1000;
+
+struct Timing {
+  double total_ns;
+  double p50_ns;
+  double p99_ns;
+};
+
+template <typename TOp>
+Timing Measure(std::size_t iterations, std::size_t batch, TOp&& op) {
+  auto latencies = std::vector<double>{};
+  latencies.reserve(iterations);
+  for (std::size_t i = 0; i < iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t b = 0; b < batch; ++b) {
+      op();
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+    latencies.push_back(std::chrono::duration<double, std::nano>{duration}
+                            .count() /
+                        static_cast<double>(batch));
+  }
+  auto total = std::accumulate(std::begin(latencies), std::end(latencies),
+                               0.0) *
+               static_cast<double>(batch);
+  std::sort(std::begin(latencies), std::end(latencies));
+  return Timing{total, latencies[latencies.size() / 2],
+                latencies[latencies.size() * 99 / 100]};
+}
+
+CryptoOpResult MakeResult(std::string name, std::string backend,
+                          std::size_t size, std::size_t overhead,
+                          std::size_t op_count, Timing const& timing) {
+  auto seconds = timing.total_ns / 1e9;
+  auto ops_per_second =
+      seconds > 0 ? static_cast<double>(op_count) / seconds : 0;
+  return CryptoOpResult{
+      std::move(name),
+      std::move(backend),
+      size,
+      ops_per_second,
+      static_cast<double>(size) * ops_per_second / (1024 * 1024),
+      timing.p50_ns,
+      timing.p99_ns,
+      overhead};
+}
+
+Ptr<ISyncKeyProvider> MakeSyncKeyProvider(Key key) {
+  CryptoNonce nonce;
+  nonce.Init();
+  return MakePtr<MockSyncKeyProvider>(std::move(key), std::move(nonce));
+}
+
+Ptr<IAsyncKeyProvider> MakeAsyncKeyProvider() {
+#if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+  SodiumCurvePublicKey pub_key;
+  SodiumCurveSecretKey sec_key;
+  crypto_box_keypair(pub_key.key.data(), sec_key.key.data());
+  return MakePtr<MockAsyncKeyProvider>(std::move(pub_key), std::move(sec_key));
+#elif AE_CRYPTO_ASYNC == AE_HYDRO_CRYPTO_PK
+  hydro_kx_keypair key_pair;
+  hydro_kx_keygen(&key_pair);
+  HydrogenCurvePublicKey pub_key;
+  std::copy(key_pair.pk, key_pair.pk + sizeof(key_pair.pk),
+            std::begin(pub_key.key));
+  HydrogenCurveSecretKey sec_key;
+  std::copy(key_pair.sk, key_pair.sk + sizeof(key_pair.sk),
+            std::begin(sec_key.key));
+  return MakePtr<MockAsyncKeyProvider>(std::move(pub_key), std::move(sec_key));
+#endif
+}
+
+void RunProviders(std::string const& backend, std::size_t size,
+                  std::size_t iterations, IEncryptProvider& encrypt,
+                  IDecryptProvider& decrypt,
+                  std::vector<CryptoOpResult>& results) {
+  auto overhead = encrypt.EncryptOverhead();
+  auto data = DataBuffer{};
+  data.reserve(size + overhead);
+  auto encrypt_timing = Measure(iterations, 1, [&]() {
+    data.resize(size);
+    encrypt.EncryptInPlace(data);
+  });
+
+  auto decrypted = DataBuffer{};
+  decrypted.reserve(size);
+  auto decrypt_timing =
+      Measure(iterations, 1, [&]() { decrypt.DecryptInto(data, decrypted); });
+
+  results.emplace_back(MakeResult("encrypt", backend, size, overhead,
+                                  iterations, encrypt_timing));
+  results.emplace_back(MakeResult("decrypt", backend, size, overhead,
+                                  iterations, decrypt_timing));
+}
+}  // namespace
+
+CryptoProviderSuite::CryptoProviderSuite(std::size_t iterations)
+    : iterations_{iterations} {}
+
+std::vector<CryptoOpResult> CryptoProviderSuite::Run(
+    std::vector<std::size_t> const& sizes) {
+  auto results = std::vector<CryptoOpResult>{};
+  for (auto size : sizes) {
+    RunSync(size, results);
+    RunAsync(size, results);
+  }
+  RunNonce(results);
+  RunKeyDerive(results);
+  RunSignVerify(results);
+  return results;
+}
+
+void CryptoProviderSuite::RunSync(std::size_t size,
+                                  std::vector<CryptoOpResult>& results) {
+  Key key;
+  CryptoSyncKeygen(key, kDefaultCryptoLibProfile);
+  auto key_provider = MakeSyncKeyProvider(std::move(key));
+  auto encrypt = SyncEncryptProvider{key_provider};
+  auto decrypt = SyncDecryptProvider{key_provider};
+  RunProviders(kSyncBackend, size, iterations_, encrypt, decrypt, results);
+
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  if (SodiumAesGcmAvailable()) {
+    Key aes_key;
+    CryptoSyncKeygen(aes_key, CryptoLibProfile::kSodiumAesGcmLib);
+    auto aes_key_provider = MakeSyncKeyProvider(std::move(aes_key));
+    auto aes_encrypt = SyncEncryptProvider{aes_key_provider};
+    auto aes_decrypt = SyncDecryptProvider{aes_key_provider};
+    RunProviders("sodium aes-256-gcm", size, iterations_, aes_encrypt,
+                 aes_decrypt, results);
+  }
+#endif
+}
+
+void CryptoProviderSuite::RunAsync(std::size_t size,
+                                   std::vector<CryptoOpResult>& results) {
+  auto key_provider = MakeAsyncKeyProvider();
+  auto encrypt = AsyncEncryptProvider{key_provider};
+  auto decrypt = AsyncDecryptProvider{key_provider};
+  RunProviders(kAsyncBackend, size, iterations_, encrypt, decrypt, results);
+}
+
+void CryptoProviderSuite::RunNonce(std::vector<CryptoOpResult>& results) {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  CryptoNonce nonce;
+  nonce.Init();
+  auto timing = Measure(iterations_, kSmallOpBatch, [&]() { nonce.Next(); });
+  results.emplace_back(MakeResult("nonce next", kSyncBackend, 0, 0,
+                                  iterations_ * kSmallOpBatch, timing));
+#else
+  (void)results;
+#endif
+}
+
+void CryptoProviderSuite::RunKeyDerive(std::vector<CryptoOpResult>& results) {
+  Key master_key;
+  CryptoSyncKeygen(master_key, kDefaultCryptoLibProfile);
+  Key client_to_server;
+  Key server_to_client;
+  std::uint32_t key_number = 0;
+  auto timing = Measure(iterations_, 1, [&]() {
+    CryptoSyncKeyDerive(master_key, 1, key_number++, client_to_server,
+                        server_to_client, kDefaultCryptoLibProfile);
+  });
+  results.emplace_back(
+      MakeResult("key derive", kKdfBackend, 0, 0, iterations_, timing));
+}
+
+void CryptoProviderSuite::RunSignVerify(std::vector<CryptoOpResult>& results) {
+#if AE_SIGNATURE == AE_ED25519 && AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+  SodiumSignPublicKey sign_pk;
+  SodiumSignSecretKey sign_sk;
+  crypto_sign_keypair(sign_pk.key.data(), sign_sk.key.data());
+  SodiumCurvePublicKey pk;
+  SodiumCurveSecretKey sk;
+  crypto_box_keypair(pk.key.data(), sk.key.data());
+  SignSodium sign;
+  crypto_sign_detached(sign.signature.data(), nullptr, pk.key.data(),
+                       pk.key.size(), sign_sk.key.data());
+  auto backend = "sodium ed25519";
+  auto size = pk.key.size();
+  auto overhead = sign.signature.size();
+#elif AE_SIGNATURE == AE_HYDRO_SIGNATURE && \
+    AE_CRYPTO_ASYNC == AE_HYDRO_CRYPTO_PK
+  hydro_sign_keypair sign_key_pair;
+  hydro_sign_keygen(&sign_key_pair);
+  HydrogenSignPublicKey sign_pk;
+  std::copy(sign_key_pair.pk, sign_key_pair.pk + sizeof(sign_key_pair.pk),
+            std::begin(sign_pk.key));
+  hydro_kx_keypair key_pair;
+  hydro_kx_keygen(&key_pair);
+  HydrogenCurvePublicKey pk;
+  std::copy(key_pair.pk, key_pair.pk + sizeof(key_pair.pk),
+            std::begin(pk.key));
+  SignHydrogen sign;
+  hydro_sign_create(sign.signature.data(), pk.key.data(), pk.key.size(),
+                    HYDRO_CONTEXT, sign_key_pair.sk);
+  auto backend = "hydrogen sign";
+  auto size = pk.key.size();
+  auto overhead = sign.signature.size();
+#endif
+
+#if (AE_SIGNATURE == AE_ED25519 && AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL) || \
+    (AE_SIGNATURE == AE_HYDRO_SIGNATURE &&                           \
+     AE_CRYPTO_ASYNC == AE_HYDRO_CRYPTO_PK)
+  auto signature = Sign{sign};
+  auto public_key = Key{pk};
+  auto sign_public_key = Key{sign_pk};
+  [[maybe_unused]] auto verified = std::size_t{};
+  auto timing = Measure(iterations_, 1, [&]() {
+    verified += CryptoSignVerify(signature, public_key, sign_public_key);
+  });
+  assert(verified == iterations_);
+  results.emplace_back(
+      MakeResult("sign verify", backend, size, overhead, iterations_, timing));
+#else
+  (void)results;
+#endif
+}
+}  // namespace ae::bench
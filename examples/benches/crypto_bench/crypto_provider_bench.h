@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_CRYPTO_BENCH_CRYPTO_PROVIDER_BENCH_H_
+#define EXAMPLES_BENCHES_CRYPTO_BENCH_CRYPTO_PROVIDER_BENCH_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+/**
+ * \brief One row of the crypto suite.
+ * All rows have the same columns, so results of builds with different crypto
+ * backends may be concatenated and compared by name, backend and size.
+ */
+struct CryptoOpResult {
+  std::string name;     //< operation
+  std::string backend;  //< library and algorithm selected by the config
+  std::size_t size;     //< plain text bytes per operation
+  double ops_per_second;
+  double mbps;      //< plain text megabytes per second, 0 for fixed size ops
+  double p50_ns;    //< median latency of one operation
+  double p99_ns;    //< 99th percentile latency of one operation
+  std::size_t overhead;  //< bytes added to each packet
+};
+
+/**
+ * \brief Measures aether/crypto on the backends selected by the config.
+ * Sync and async providers encrypt and decrypt packets of each size, the
+ * nonce, key derivation and signature verification are measured per call.
+ */
+class CryptoProviderSuite {
+ public:
+  explicit CryptoProviderSuite(std::size_t iterations);
+
+  std::vector<CryptoOpResult> Run(std::vector<std::size_t> const& sizes);
+
+ private:
+  void RunSync(std::size_t size, std::vector<CryptoOpResult>& results);
+  void RunAsync(std::size_t size, std::vector<CryptoOpResult>& results);
+  void RunNonce(std::vector<CryptoOpResult>& results);
+  void RunKeyDerive(std::vector<CryptoOpResult>& results);
+  void RunSignVerify(std::vector<CryptoOpResult>& results);
+
+  std::size_t iterations_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::CryptoOpResult> {
+  static void Print(std::ostream& s, bench::CryptoOpResult const& r) {
+    s << r.name << "," << r.backend << "," << r.size << "," << r.ops_per_second
+      << "," << r.mbps << "," << r.p50_ns << "," << r.p99_ns << ","
+      << r.overhead;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_CRYPTO_BENCH_CRYPTO_PROVIDER_BENCH_H_
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <iostream>
+
+#include "aether/port/tele_init.h"
+#include "aether/tele/tele.h"
+
+#include "aether/obj/domain.h"
+#include "aether/aether.h"
+#include "aether/client.h"
+#include "aether/server.h"
+#include "aether/work_cloud.h"
+
+#include "aether/crypto/key.h"
+#include "aether/crypto/crypto_nonce.h"
+#include "aether/crypto/sodium/sodium_aes_gcm_crypto_provider.h"
+
+#include "test_utils/map_facility.h"
+#include "test_utils/mock_key_provider.h"
+#include "crypto_bench/crypto_gate_bench.h"
+#include "crypto_bench/crypto_provider_bench.h"
+#include "crypto_bench/session_bench.h"
+#include "crypto_bench/offload_bench.h"
+#include "crypto_bench/box_bench.h"
+
+namespace ae::bench {
+static constexpr std::size_t kCryptoBytes = std::size_t{64} * 1024 * 1024;
+static constexpr std::size_t kSessionPackets = 1'000'000;
+static constexpr std::size_t kOffloadPackets = 2'000;
+static constexpr std::size_t kProviderIterations = 10'000;
+static constexpr std::size_t kBoxMessages = 10'000;
+
+Ptr<ISyncKeyProvider> MakeSyncKeyProvider() {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  SodiumChachaKey key;
+  crypto_aead_chacha20poly1305_keygen(key.key.data());
+  CryptoNonce nonce;
+  nonce.Init();
+  return MakePtr<MockSyncKeyProvider>(std::move(key), std::move(nonce));
+#elif AE_CRYPTO_SYNC == AE_HYDRO_CRYPTO_SK
+  HydrogenSecretBoxKey key;
+  hydro_secretbox_keygen(key.key.data());
+  return MakePtr<MockSyncKeyProvider>(std::move(key));
+#endif
+}
+
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+Ptr<ISyncKeyProvider> MakeAesGcmKeyProvider() {
+  SodiumAesGcmKey key;
+  crypto_aead_aes256gcm_keygen(key.key.data());
+  CryptoNonce nonce;
+  nonce.Init();
+  return MakePtr<MockSyncKeyProvider>(std::move(key), std::move(nonce));
+}
+#endif
+
+int crypto_bench(std::ostream& result_stream) {
+  TeleInit::Init();
+
+  auto packet_sizes = std::vector<std::size_t>{
+      16, 64, 256, 1024, 1200, 4096, 16 * 1024, 64 * 1024};
+
+  AE_TELED_INFO("Run crypto provider suite");
+  auto provider_results =
+      CryptoProviderSuite{kProviderIterations}.Run(packet_sizes);
+  result_stream << "operation,backend,size,ops/s,MB/s,p50 ns,p99 ns,overhead "
+                   "bytes\n";
+  for (auto const& result : provider_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  std::vector<CryptoGateResult> results;
+  auto bench = CryptoGateThroughput{MakeSyncKeyProvider()};
+  for (auto packet_size : packet_sizes) {
+    AE_TELED_INFO("Run crypto gate bench packet size {}", packet_size);
+    results.emplace_back(bench.RunCopy(packet_size, kCryptoBytes));
+    results.emplace_back(bench.RunInPlace(packet_size, kCryptoBytes));
+  }
+
+  result_stream << "\npacket size,mode,encrypt MB/s,decrypt MB/s\n";
+  for (auto const& result : results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  if (SodiumAesGcmAvailable()) {
+    // in place results above are for ChaCha20-Poly1305
+    std::vector<CryptoGateResult> aes_results;
+    auto aes_bench = CryptoGateThroughput{MakeAesGcmKeyProvider()};
+    for (auto packet_size : packet_sizes) {
+      AE_TELED_INFO("Run AES-256-GCM bench packet size {}", packet_size);
+      aes_results.emplace_back(aes_bench.RunInPlace(packet_size, kCryptoBytes));
+    }
+
+    result_stream << "\ncipher,packet size,mode,encrypt MB/s,decrypt MB/s\n";
+    for (std::size_t i = 0; i < aes_results.size(); ++i) {
+      Format(result_stream, "chacha20-poly1305,{}\n", results[i * 2 + 1]);
+      Format(result_stream, "aes-256-gcm,{}\n", aes_results[i]);
+    }
+  } else {
+    result_stream << "\nAES-256-GCM is not supported by CPU\n";
+  }
+#endif
+
+  std::vector<OffloadResult> offload_results;
+  auto offload_bench = CryptoOffloadThroughput{MakeSyncKeyProvider()};
+  for (auto packet_size : {std::size_t{4 * 1024}, std::size_t{64 * 1024}}) {
+    AE_TELED_INFO("Run crypto offload bench packet size {}", packet_size);
+    offload_results.emplace_back(
+        offload_bench.RunInPlace(packet_size, kOffloadPackets));
+    for (auto workers : {1, 2, 4, 8}) {
+      offload_results.emplace_back(offload_bench.RunOffload(
+          static_cast<std::size_t>(workers), packet_size, kOffloadPackets));
+    }
+  }
+
+  result_stream << "\nworkers,packet size,messages/s\n";
+  for (auto const& result : offload_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  std::vector<BoxResult> box_results;
+  auto box_bench = BoxMessageRate{};
+  for (auto message_size :
+       {std::size_t{64}, std::size_t{256}, std::size_t{1024}}) {
+    AE_TELED_INFO("Run box bench message size {}", message_size);
+    box_results.emplace_back(box_bench.RunSeal(message_size, kBoxMessages));
+    box_results.emplace_back(
+        box_bench.RunPrecomputed(message_size, kBoxMessages));
+  }
+
+  result_stream << "\nmode,message size,overhead bytes,encrypt messages/s,"
+                   "decrypt messages/s\n";
+  for (auto const& result : box_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+#if defined AE_DISTILLATION
+  // client with a single server to take the stream key material from
+  auto facility = MapFacility{};
+  auto domain = Domain{TimePoint::clock::now(), facility};
+  Aether::ptr aether = domain.CreateObj<Aether>(1);
+  Client::ptr client = domain.CreateObj<Client>(2, aether);
+  Server::ptr server = domain.CreateObj<Server>(3);
+  WorkCloud::ptr cloud = domain.CreateObj<WorkCloud>(4);
+  server->server_id = 1;
+  cloud->AddServer(server);
+  client->SetConfig(Uid{{1}}, Uid{{1}}, Key{}, cloud);
+
+  std::vector<SessionResult> session_results;
+  auto session_bench = SessionOverhead{client, server->server_id};
+  for (auto packet_size : {std::size_t{64}, std::size_t{1200}}) {
+    AE_TELED_INFO("Run key session bench packet size {}", packet_size);
+    session_results.emplace_back(
+        session_bench.RunClientLookup(packet_size, kSessionPackets));
+    session_results.emplace_back(
+        session_bench.RunSession(packet_size, kSessionPackets));
+  }
+
+  result_stream << "\nkey source,packet size,key ns per packet,encrypt ns "
+                   "per packet\n";
+  for (auto const& result : session_results) {
+    Format(result_stream, "{}\n", result);
+  }
+#endif
+  return 0;
+}
+}  // namespace ae::bench
+
+int main() { return ae::bench::crypto_bench(std::cout); }
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_bench/offload_bench.h"
+
+#include <chrono>
+#include <utility>
+
+#include "aether/actions/action_processor.h"
+#include "aether/stream_api/istream.h"
+#include "aether/stream_api/crypto_stream.h"
+#include "aether/stream_api/offload_crypto_gate.h"
+#include "aether/crypto/crypto_worker_pool.h"
+#include "aether/crypto/sync_crypto_provider.h"
+
+namespace ae::bench {
+namespace {
+/**
+ * \brief Emits written packets back as received ones.
+ */
+class LoopbackGate final : public ByteGate {
+ public:
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint /* current_time */) override {
+    out_data_event_.Emit(buffer);
+    return {};
+  }
+
+  StreamInfo stream_info() const override {
+    return StreamInfo{kMaxPacketSize, true, true, true};
+  }
+
+ private:
+  static constexpr std::size_t kMaxPacketSize = 1024 * 1024;
+};
+
+template <typename TCryptoGate>
+OffloadResult Run(ActionProcessor& action_processor, TCryptoGate& crypto_gate,
+                  std::size_t workers, std::size_t packet_size,
+                  std::size_t packet_count) {
+  auto loopback = LoopbackGate{};
+  crypto_gate.LinkOut(loopback);
+
+  std::size_t received = 0;
+  auto _ = crypto_gate.out_data_event().Subscribe(
+      [&](DataBuffer const&) { ++received; });
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < packet_count; ++i) {
+    crypto_gate.Write(DataBuffer(packet_size), TimePoint::clock::now());
+  }
+  while (received < packet_count) {
+    action_processor.get_trigger().WaitUntil(TimePoint::clock::now() +
+                                             std::chrono::milliseconds{10});
+    action_processor.Update(TimePoint::clock::now());
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return OffloadResult{
+      workers, packet_size,
+      seconds > 0 ? static_cast<double>(packet_count) / seconds : 0};
+}
+}  // namespace
+
+CryptoOffloadThroughput::CryptoOffloadThroughput(
+    Ptr<ISyncKeyProvider> key_provider)
+    : key_provider_{std::move(key_provider)} {}
+
+OffloadResult CryptoOffloadThroughput::RunInPlace(std::size_t packet_size,
+                                                  std::size_t packet_count) {
+  auto action_processor = ActionProcessor{};
+  auto crypto_gate = CryptoGate{MakePtr<SyncEncryptProvider>(key_provider_),
+                                MakePtr<SyncDecryptProvider>(key_provider_)};
+  return Run(action_processor, crypto_gate, 0, packet_size, packet_count);
+}
+
+OffloadResult CryptoOffloadThroughput::RunOffload(std::size_t workers,
+                                                  std::size_t packet_size,
+                                                  std::size_t packet_count) {
+  auto action_processor = ActionProcessor{};
+  // offload all packets to see the pool scaling
+  auto crypto_gate = OffloadCryptoGate{
+      action_processor, MakePtr<CryptoWorkerPool>(workers),
+      MakePtr<SyncEncryptProvider>(key_provider_),
+      MakePtr<SyncDecryptProvider>(key_provider_), std::size_t{0}};
+  return Run(action_processor, crypto_gate, workers, packet_size,
+             packet_count);
+}
+}  // namespace ae::bench
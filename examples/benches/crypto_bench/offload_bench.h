@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_CRYPTO_BENCH_OFFLOAD_BENCH_H_
+#define EXAMPLES_BENCHES_CRYPTO_BENCH_OFFLOAD_BENCH_H_
+
+#include <cstddef>
+#include <ostream>
+
+#include "aether/obj/ptr.h"
+#include "aether/tele/ios.h"
+#include "aether/crypto/ikey_provider.h"
+
+namespace ae::bench {
+struct OffloadResult {
+  std::size_t workers;  //< 0 for CryptoGate on the action thread
+  std::size_t packet_size;
+  double messages_per_second;  //< encrypted and decrypted back
+};
+
+/**
+ * \brief Measures messages per second through OffloadCryptoGate.
+ * Encrypted packets are looped back to the gate, so each message is encrypted
+ * and decrypted. The action loop runs until all messages are received back.
+ */
+class CryptoOffloadThroughput {
+ public:
+  explicit CryptoOffloadThroughput(Ptr<ISyncKeyProvider> key_provider);
+
+  OffloadResult RunInPlace(std::size_t packet_size, std::size_t packet_count);
+  OffloadResult RunOffload(std::size_t workers, std::size_t packet_size,
+                           std::size_t packet_count);
+
+ private:
+  Ptr<ISyncKeyProvider> key_provider_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::OffloadResult> {
+  static void Print(std::ostream& s, bench::OffloadResult const& r) {
+    s << r.workers << "," << r.packet_size << "," << r.messages_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_CRYPTO_BENCH_OFFLOAD_BENCH_H_
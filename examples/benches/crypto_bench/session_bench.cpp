@@ -0,0 +1,110 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_bench/session_bench.h"
+
+#include <chrono>
+#include <cassert>
+#include <utility>
+
+#include "aether/client.h"
+#include "aether/crypto/sync_crypto_provider.h"
+#include "aether/client_connections/client_crypto_session.h"
+
+namespace ae::bench {
+namespace {
+/**
+ * \brief Key provider locking the client for each key and nonce.
+ */
+class ClientLookupKeyProvider final : public ISyncKeyProvider {
+ public:
+  ClientLookupKeyProvider(Ptr<Client> const& client, ServerId server_id)
+      : client_{client}, server_id_{server_id} {}
+
+  Key GetKey() const override {
+    auto client_ptr = client_.Lock();
+    assert(client_ptr);
+    auto const* server_keys = client_ptr->server_state(server_id_);
+    assert(server_keys);
+    return server_keys->client_to_server();
+  }
+
+  CryptoNonce const& Nonce() const override {
+    auto client_ptr = client_.Lock();
+    assert(client_ptr);
+    auto* server_keys = client_ptr->server_state(server_id_);
+    assert(server_keys);
+    auto nonce = server_keys->nonce();
+    nonce.Next();
+    server_keys->set_nonce(nonce);
+    return server_keys->nonce();
+  }
+
+ private:
+  PtrView<Client> client_;
+  ServerId server_id_;
+};
+
+double NanosecondsPerPacket(std::chrono::steady_clock::duration duration,
+                            std::size_t packet_count) {
+  return std::chrono::duration<double, std::nano>{duration}.count() /
+         static_cast<double>(packet_count);
+}
+}  // namespace
+
+SessionOverhead::SessionOverhead(Ptr<Client> client, ServerId server_id)
+    : client_{std::move(client)}, server_id_{server_id} {}
+
+SessionResult SessionOverhead::RunClientLookup(std::size_t packet_size,
+                                               std::size_t packet_count) {
+  return Run("client lookup",
+             MakePtr<ClientLookupKeyProvider>(client_, server_id_),
+             packet_size, packet_count);
+}
+
+SessionResult SessionOverhead::RunSession(std::size_t packet_size,
+                                          std::size_t packet_count) {
+  auto session = MakePtr<ClientCryptoSession>(client_, server_id_);
+  return Run("session", MakePtr<SessionEncryptKeyProvider>(session),
+             packet_size, packet_count);
+}
+
+SessionResult SessionOverhead::Run(std::string key_source,
+                                   Ptr<ISyncKeyProvider> const& key_provider,
+                                   std::size_t packet_size,
+                                   std::size_t packet_count) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < packet_count; ++i) {
+    [[maybe_unused]] auto key = key_provider->GetKey();
+    [[maybe_unused]] auto const& nonce = key_provider->Nonce();
+  }
+  auto key_duration = std::chrono::steady_clock::now() - start;
+
+  auto encrypt = SyncEncryptProvider{key_provider};
+  auto data = DataBuffer{};
+  data.reserve(packet_size + encrypt.EncryptOverhead());
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < packet_count; ++i) {
+    data.resize(packet_size);
+    encrypt.EncryptInPlace(data);
+  }
+  auto packet_duration = std::chrono::steady_clock::now() - start;
+
+  return SessionResult{std::move(key_source), packet_size,
+                       NanosecondsPerPacket(key_duration, packet_count),
+                       NanosecondsPerPacket(packet_duration, packet_count)};
+}
+}  // namespace ae::bench
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_CRYPTO_BENCH_SESSION_BENCH_H_
+#define EXAMPLES_BENCHES_CRYPTO_BENCH_SESSION_BENCH_H_
+
+#include <string>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/common.h"
+#include "aether/obj/ptr.h"
+#include "aether/tele/ios.h"
+#include "aether/crypto/ikey_provider.h"
+
+namespace ae {
+class Client;
+}
+
+namespace ae::bench {
+struct SessionResult {
+  std::string key_source;  //< client lookup or session
+  std::size_t packet_size;
+  double key_ns;     //< key and nonce fetch per packet
+  double packet_ns;  //< in place encryption per packet with the key fetch
+};
+
+/**
+ * \brief Measures the per packet cost of the client to server key material.
+ * Client lookup locks the client and finds the server state for each key and
+ * nonce, as the stream did before the crypto session. Session uses the
+ * ClientCryptoSession providers with the cached keys and the local nonce.
+ */
+class SessionOverhead {
+ public:
+  SessionOverhead(Ptr<Client> client, ServerId server_id);
+
+  SessionResult RunClientLookup(std::size_t packet_size,
+                                std::size_t packet_count);
+  SessionResult RunSession(std::size_t packet_size, std::size_t packet_count);
+
+ private:
+  SessionResult Run(std::string key_source,
+                    Ptr<ISyncKeyProvider> const& key_provider,
+                    std::size_t packet_size, std::size_t packet_count);
+
+  Ptr<Client> client_;
+  ServerId server_id_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::SessionResult> {
+  static void Print(std::ostream& s, bench::SessionResult const& r) {
+    s << r.key_source << "," << r.packet_size << "," << r.key_ns << ","
+      << r.packet_ns;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_CRYPTO_BENCH_SESSION_BENCH_H_
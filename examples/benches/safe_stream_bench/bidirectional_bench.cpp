@@ -0,0 +1,160 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "safe_stream_bench/bidirectional_bench.h"
+
+#include <ctime>
+#include <string>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+
+#include "aether/actions/action_processor.h"
+#include "aether/stream_api/safe_stream.h"
+
+#include "aether/tele/tele.h"
+
+namespace ae::bench {
+// max virtual time to run a single bench
+static constexpr auto kMaxRunTime = std::chrono::minutes{10};
+// step of virtual time if nothing is scheduled
+static constexpr auto kIdleStep = std::chrono::milliseconds{1};
+static constexpr std::size_t kBulkMessageSize = 4 * 1024;
+static constexpr std::size_t kPacedMessageSize = 1024;
+
+namespace {
+struct Side {
+  SafeStream& stream;
+  std::size_t written;
+  std::size_t in_buffer;
+  std::size_t received;
+};
+}  // namespace
+
+SafeStreamBidirectional::SafeStreamBidirectional(LinkProfile link_profile,
+                                                 SafeStreamConfig config,
+                                                 bool two_way,
+                                                 Duration write_interval)
+    : link_profile_{std::move(link_profile)},
+      config_{config},
+      two_way_{two_way},
+      write_interval_{write_interval} {}
+
+BidirectionalResult SafeStreamBidirectional::Run(std::size_t bytes_count) {
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, link_profile_};
+  auto left_stream = SafeStream{ap, config_};
+  auto right_stream = SafeStream{ap, config_};
+  left_stream.LinkOut(link.left());
+  right_stream.LinkOut(link.right());
+
+  auto left = Side{left_stream, 0, 0, 0};
+  auto right = Side{right_stream, 0, 0, 0};
+  auto const expected = two_way_ ? bytes_count * 2 : bytes_count;
+
+  auto const start_time = TimePoint{};
+  auto current_time = start_time;
+  bool failed = false;
+
+  auto left_sub = left.stream.in().out_data_event().Subscribe(
+      [&](auto const& data) { left.received += data.size(); });
+  auto right_sub = right.stream.in().out_data_event().Subscribe(
+      [&](auto const& data) { right.received += data.size(); });
+
+  MultiSubscription write_subs;
+
+  auto const paced = write_interval_ != Duration::zero();
+  auto const message_size = paced ? kPacedMessageSize : kBulkMessageSize;
+  auto next_write_time = start_time;
+
+  auto write_message = [&](Side& side) {
+    if ((side.written >= bytes_count) ||
+        ((side.in_buffer + message_size) > config_.buffer_capacity)) {
+      return false;
+    }
+    auto size = std::min(message_size, bytes_count - side.written);
+    auto action = side.stream.in().Write(DataBuffer(size, std::uint8_t{0x42}),
+                                         current_time);
+    side.written += size;
+    side.in_buffer += size;
+    write_subs.Push(
+        action->SubscribeOnResult(
+            [&side, size](auto const&) { side.in_buffer -= size; }),
+        action->SubscribeOnError([&](auto const&) {
+          AE_TELED_ERROR("Write failed");
+          failed = true;
+        }));
+    return true;
+  };
+
+  auto write_more = [&](Side& side) {
+    if (paced) {
+      // application limited traffic, one message per interval
+      write_message(side);
+      return;
+    }
+    // bulk traffic keeps the sending buffer full
+    while (write_message(side)) {
+    }
+  };
+
+  auto const cpu_start = std::clock();
+  while (!failed && ((left.received + right.received) < expected) &&
+         ((current_time - start_time) < kMaxRunTime)) {
+    if (current_time >= next_write_time) {
+      write_more(left);
+      if (two_way_) {
+        write_more(right);
+      }
+      next_write_time += write_interval_;
+    }
+    auto next_time = ap.Update(current_time);
+    // virtual clock, so wait only for triggered actions
+    if (ap.get_trigger().WaitUntil(current_time)) {
+      continue;
+    }
+    next_time =
+        (next_time > current_time) ? next_time : (current_time + kIdleStep);
+    if (paced && (left.written < bytes_count)) {
+      next_time = std::min(next_time, next_write_time);
+    }
+    current_time = next_time;
+  }
+  auto const cpu_time = static_cast<double>(std::clock() - cpu_start) /
+                        static_cast<double>(CLOCKS_PER_SEC);
+
+  auto const bytes = left.received + right.received;
+  auto const megabytes =
+      std::max(static_cast<double>(bytes) / (1024.0 * 1024.0), 1e-9);
+
+  return BidirectionalResult{
+      link_profile_,
+      Format("{}ms/{}",
+             std::chrono::duration_cast<std::chrono::milliseconds>(
+                 config_.send_confirm_timeout)
+                 .count(),
+             config_.confirm_chunk_count),
+      two_way_,
+      paced ? Format("{}B/{}us", message_size, write_interval_.count())
+            : std::string{"bulk"},
+      bytes,
+      std::chrono::duration_cast<Duration>(current_time - start_time),
+      link.sent_packets(),
+      static_cast<double>(link.sent_packets()) / megabytes,
+      cpu_time * 1000.0 / megabytes,
+  };
+}
+}  // namespace ae::bench
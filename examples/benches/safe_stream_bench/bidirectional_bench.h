@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SAFE_STREAM_BENCH_BIDIRECTIONAL_BENCH_H_
+#define EXAMPLES_BENCHES_SAFE_STREAM_BENCH_BIDIRECTIONAL_BENCH_H_
+
+#include <string>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/common.h"
+#include "aether/tele/ios.h"
+#include "aether/stream_api/safe_stream/safe_stream_types.h"
+
+#include "test_utils/sim_link.h"
+
+namespace ae::bench {
+struct BidirectionalResult {
+  LinkProfile link;
+  std::string confirm;  //< confirm mode as timeout/chunks
+  bool two_way;         //< both sides send data
+  std::string traffic;  //< bulk or paced message size and interval
+  std::size_t bytes;    //< bytes delivered in both directions
+  Duration duration;    //< virtual time spent to deliver all bytes
+  std::size_t packets;  //< packets sent through the link in both directions
+  double packets_per_mb;  //< link packets per delivered megabyte
+  double cpu_ms_per_mb;   //< process cpu time per delivered megabyte
+};
+
+/**
+ * \brief Measures the cost of confirms for one way and two way traffic.
+ * Each side writes bytes_count into its SafeStream, the other side counts
+ * delivered bytes. Zero write_interval keeps the sending buffer full, otherwise
+ * one small message is written per interval like rpc or telemetry traffic.
+ * Confirms are delayed by the config and piggybacked on the data going the
+ * opposite way, so the link packet count shows how many standalone confirm
+ * packets are left. Cpu time includes the telemetry, build with
+ * AE_TELE_ENABLED=0 to see the stream cost only.
+ */
+class SafeStreamBidirectional {
+ public:
+  SafeStreamBidirectional(LinkProfile link_profile, SafeStreamConfig config,
+                          bool two_way, Duration write_interval);
+
+  BidirectionalResult Run(std::size_t bytes_count);
+
+ private:
+  LinkProfile link_profile_;
+  SafeStreamConfig config_;
+  bool two_way_;
+  Duration write_interval_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::BidirectionalResult> {
+  static void Print(std::ostream& s, bench::BidirectionalResult const& r) {
+    s << r.link.name << "," << r.confirm << ","
+      << (r.two_way ? "two way" : "one way") << "," << r.traffic << ","
+      << r.bytes << ","
+      << r.duration.count() << "," << r.packets << "," << r.packets_per_mb
+      << "," << r.cpu_ms_per_mb;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SAFE_STREAM_BENCH_BIDIRECTIONAL_BENCH_H_
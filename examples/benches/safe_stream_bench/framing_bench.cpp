@@ -0,0 +1,130 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "safe_stream_bench/framing_bench.h"
+
+#include <chrono>
+#include <utility>
+#include <optional>
+#include <algorithm>
+
+#include "aether/actions/action_processor.h"
+#include "aether/stream_api/safe_stream.h"
+#include "aether/stream_api/sized_packet_stream.h"
+
+#include "aether/tele/tele.h"
+
+namespace ae::bench {
+// max virtual time to run a single bench
+static constexpr auto kMaxRunTime = std::chrono::minutes{10};
+static constexpr auto kWriteInterval = std::chrono::milliseconds{1};
+
+namespace {
+/**
+ * \brief Counts bytes written to the link.
+ */
+class ByteCounterGate final : public ByteGate {
+ public:
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint current_time) override {
+    bytes_ += buffer.size();
+    return out_->Write(std::move(buffer), current_time);
+  }
+
+  std::size_t bytes() const { return bytes_; }
+
+ private:
+  std::size_t bytes_{};
+};
+}  // namespace
+
+SafeStreamFraming::SafeStreamFraming(LinkProfile link_profile,
+                                     SafeStreamConfig config)
+    : link_profile_{std::move(link_profile)}, config_{config} {}
+
+FramingResult SafeStreamFraming::Run(std::size_t message_size,
+                                     std::size_t message_count) {
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, link_profile_};
+  auto sender = SafeStream{ap, config_};
+  auto receiver = SafeStream{ap, config_};
+  auto sender_counter = ByteCounterGate{};
+  auto receiver_counter = ByteCounterGate{};
+  Tie(sender, sender_counter, link.left());
+  Tie(receiver, receiver_counter, link.right());
+
+  auto sender_sized = std::optional<SizedPacketGate>{};
+  auto receiver_sized = std::optional<SizedPacketGate>{};
+  ByteGate::Base* sender_in = &sender.in();
+  ByteGate::Base* receiver_in = &receiver.in();
+  if (!config_.compact_framing) {
+    sender_sized.emplace();
+    receiver_sized.emplace();
+    Tie(*sender_sized, sender);
+    Tie(*receiver_sized, receiver);
+    sender_in = &*sender_sized;
+    receiver_in = &*receiver_sized;
+  }
+
+  std::size_t received = 0;
+  bool broken = false;
+  auto receive_sub =
+      receiver_in->out_data_event().Subscribe([&](auto const& data) {
+        broken = broken || (data.size() != message_size);
+        ++received;
+      });
+
+  auto const start_time = TimePoint{};
+  auto current_time = start_time;
+  auto next_write_time = start_time;
+  std::size_t written = 0;
+  while ((received < message_count) &&
+         ((current_time - start_time) < kMaxRunTime)) {
+    if ((written < message_count) && (current_time >= next_write_time)) {
+      sender_in->Write(DataBuffer(message_size, std::uint8_t{0x42}),
+                       current_time);
+      ++written;
+      next_write_time += kWriteInterval;
+    }
+    auto next_time = ap.Update(current_time);
+    // virtual clock, so wait only for triggered actions
+    if (ap.get_trigger().WaitUntil(current_time)) {
+      continue;
+    }
+    next_time = (next_time > current_time) ? next_time
+                                           : (current_time + kWriteInterval);
+    if (written < message_count) {
+      next_time = std::min(next_time, next_write_time);
+    }
+    current_time = next_time;
+  }
+  if (broken) {
+    AE_TELED_ERROR("Message boundaries are broken");
+  }
+
+  auto const messages = static_cast<double>(std::max(received, std::size_t{1}));
+  auto const data_bytes =
+      static_cast<double>(sender_counter.bytes()) / messages;
+  return FramingResult{
+      config_.compact_framing ? "compact" : "sized",
+      message_size,
+      received,
+      data_bytes,
+      static_cast<double>(receiver_counter.bytes()) / messages,
+      data_bytes - static_cast<double>(message_size),
+  };
+}
+}  // namespace ae::bench
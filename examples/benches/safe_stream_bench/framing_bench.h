@@ -0,0 +1,70 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SAFE_STREAM_BENCH_FRAMING_BENCH_H_
+#define EXAMPLES_BENCHES_SAFE_STREAM_BENCH_FRAMING_BENCH_H_
+
+#include <string>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/common.h"
+#include "aether/tele/ios.h"
+#include "aether/stream_api/safe_stream/safe_stream_types.h"
+
+#include "test_utils/sim_link.h"
+
+namespace ae::bench {
+struct FramingResult {
+  std::string framing;        //< sized packets or compact
+  std::size_t message_size;   //< size of each written message
+  std::size_t messages;       //< delivered messages
+  double data_bytes;          //< bytes written by sender per message
+  double confirm_bytes;       //< bytes written by receiver per message
+  double overhead;            //< sender bytes over the message size
+};
+
+/**
+ * \brief Measures bytes on wire per message for the SafeStream framing.
+ * The sized framing is a SizedPacketGate on top of SafeStream, like in
+ * P2pSafeStream by default. The compact one is SafeStream with
+ * compact_framing. One message is written per millisecond, like rpc traffic.
+ * Bytes are counted right under each SafeStream, headers added by the lower
+ * layers are the same for both framings and not counted.
+ */
+class SafeStreamFraming {
+ public:
+  SafeStreamFraming(LinkProfile link_profile, SafeStreamConfig config);
+
+  FramingResult Run(std::size_t message_size, std::size_t message_count);
+
+ private:
+  LinkProfile link_profile_;
+  SafeStreamConfig config_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::FramingResult> {
+  static void Print(std::ostream& s, bench::FramingResult const& r) {
+    s << r.framing << "," << r.message_size << "," << r.messages << ","
+      << r.data_bytes << "," << r.confirm_bytes << "," << r.overhead;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SAFE_STREAM_BENCH_FRAMING_BENCH_H_
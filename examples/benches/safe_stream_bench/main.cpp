@@ -0,0 +1,228 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <cstddef>
+#include <chrono>
+#include <iostream>
+
+#include "aether/port/tele_init.h"
+#include "aether/tele/tele.h"
+
+#include "test_utils/sim_link.h"
+#include "safe_stream_bench/throughput_bench.h"
+#include "safe_stream_bench/bidirectional_bench.h"
+#include "safe_stream_bench/framing_bench.h"
+#include "safe_stream_bench/recovery_bench.h"
+#include "safe_stream_bench/resume_bench.h"
+
+namespace ae::bench {
+// RingIndex with non power of two Max does not wrap consistently, so with the
+// 16-bit offset space the transfer is kept within one lap of offsets
+static constexpr std::size_t kThroughputBytes =
+    SafeStreamRingIndex::kPowerOfTwo
+        ? std::size_t{8} * 1024 * 1024
+        : static_cast<std::size_t>(SafeStreamRingIndex::max - 1);
+
+int safe_stream_bench(std::ostream& result_stream) {
+  TeleInit::Init();
+
+  auto link_profiles = std::vector<LinkProfile>{
+      {"lan_100mbit_2ms", 12'500'000, std::chrono::milliseconds{1}, 1200, 0.0},
+      {"lfn_100mbit_80ms", 12'500'000, std::chrono::milliseconds{40}, 1200,
+       0.0},
+      {"sat_10mbit_600ms", 1'250'000, std::chrono::milliseconds{300}, 1200,
+       0.0},
+  };
+
+  std::vector<ThroughputResult> results;
+  for (auto const& profile : link_profiles) {
+    AE_TELED_INFO("Run throughput bench for {}", profile.name);
+    auto bench = SafeStreamThroughput{profile, MakeThroughputConfig(profile)};
+    results.emplace_back(bench.Run(kThroughputBytes));
+  }
+
+  // satellite link with random loss, with and without fec
+  auto lossy_profiles = std::vector<LinkProfile>{
+      {"sat_10mbit_600ms", 1'250'000, std::chrono::milliseconds{300}, 1200,
+       0.03},
+      {"sat_10mbit_600ms", 1'250'000, std::chrono::milliseconds{300}, 1200,
+       0.1},
+  };
+  auto fec_configs = std::vector<std::optional<FecConfig>>{
+      std::nullopt,
+      FecConfig{8, 1},
+      FecConfig{4, 1},
+      FecConfig{8, 2},
+  };
+  for (auto const& profile : lossy_profiles) {
+    for (auto const& fec_config : fec_configs) {
+      AE_TELED_INFO("Run loss bench for {} loss {}", profile.name,
+                    profile.loss);
+      auto bench = SafeStreamThroughput{profile, MakeThroughputConfig(profile),
+                                        fec_config};
+      results.emplace_back(bench.Run(kThroughputBytes));
+    }
+  }
+
+  // constrained uplink with short queue, bursts of the window are dropped
+  auto uplink_profile = LinkProfile{
+      "uplink_2mbit_50ms", 250'000, std::chrono::milliseconds{25}, 1200, 0.0,
+      16 * 1024};
+  for (auto pacing : {false, true}) {
+    AE_TELED_INFO("Run pacing bench for {} pacing {}", uplink_profile.name,
+                  pacing);
+    auto config = MakeThroughputConfig(uplink_profile);
+    config.pacing = pacing;
+    auto bench = SafeStreamThroughput{uplink_profile, config};
+    results.emplace_back(bench.Run(kThroughputBytes));
+  }
+
+  // link matrix with jitter, reordering and duplication
+  auto matrix_profiles = std::vector<LinkProfile>{
+      {"wifi_50mbit_10ms", 6'250'000, std::chrono::milliseconds{5}, 1200, 0.01,
+       0, std::chrono::milliseconds{2}, 0.01, 0.005},
+      {"lte_20mbit_60ms", 2'500'000, std::chrono::milliseconds{30}, 1200,
+       0.005, 64 * 1024, std::chrono::milliseconds{10}, 0.02, 0.001},
+      {"3g_2mbit_200ms", 250'000, std::chrono::milliseconds{100}, 1200, 0.02,
+       32 * 1024, std::chrono::milliseconds{40}, 0.02, 0.01},
+      {"sat_10mbit_600ms", 1'250'000, std::chrono::milliseconds{300}, 1200,
+       0.01, 0, std::chrono::milliseconds{20}, 0.005, 0.0},
+  };
+  for (auto const& profile : matrix_profiles) {
+    for (auto pacing : {false, true}) {
+      AE_TELED_INFO("Run link matrix bench for {} pacing {}", profile.name,
+                    pacing);
+      auto config = MakeThroughputConfig(profile);
+      config.pacing = pacing;
+      auto bench = SafeStreamThroughput{profile, config};
+      results.emplace_back(bench.Run(kThroughputBytes));
+    }
+  }
+
+  result_stream << "link,loss,fec,pacing,window bytes,delivered "
+                   "bytes,duration us,goodput Mbit/s,p50 latency us,p90 "
+                   "latency us,p99 latency us,jitter us,packets,dropped,fec "
+                   "restored,retransmit ratio\n";
+  for (auto const& result : results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  // confirm cost, one confirm per update by default, coalescing and delayed
+  // confirms which are piggybacked on the opposite data for two way traffic
+  struct ConfirmMode {
+    Duration timeout;
+    std::uint16_t chunks;
+  };
+  auto confirm_modes = std::vector<ConfirmMode>{
+      {std::chrono::milliseconds{0}, 1},
+      {std::chrono::milliseconds{0}, 2},
+      {std::chrono::milliseconds{5}, 4},
+      {std::chrono::milliseconds{20}, 16},
+  };
+  auto const& lan_profile = link_profiles.front();
+  std::vector<BidirectionalResult> bidirectional_results;
+  auto write_intervals = std::vector<Duration>{
+      Duration::zero(),
+      std::chrono::milliseconds{1},
+  };
+  for (auto write_interval : write_intervals) {
+    for (auto two_way : {false, true}) {
+      for (auto const& mode : confirm_modes) {
+        AE_TELED_INFO("Run confirm bench two way {}", two_way);
+        auto config = MakeThroughputConfig(lan_profile);
+        config.send_confirm_timeout = mode.timeout;
+        config.confirm_chunk_count = mode.chunks;
+        auto bench = SafeStreamBidirectional{lan_profile, config, two_way,
+                                             write_interval};
+        bidirectional_results.emplace_back(bench.Run(kThroughputBytes));
+      }
+    }
+  }
+
+  result_stream << "\nlink,confirm timeout/chunks,direction,traffic,delivered "
+                   "bytes,duration us,packets,packets per MB,cpu ms per MB\n";
+  for (auto const& result : bidirectional_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  // packed BandwidthApi messages, code and payload of OneByte, TenBytes,
+  // HundredBytes, ThousandBytes and VarMessageSize of 1500 bytes
+  auto message_sizes = std::vector<std::size_t>{2, 11, 101, 1001, 1503};
+  std::vector<FramingResult> framing_results;
+  for (auto message_size : message_sizes) {
+    for (auto compact : {false, true}) {
+      AE_TELED_INFO("Run framing bench message size {} compact {}",
+                    message_size, compact);
+      auto config = MakeThroughputConfig(lan_profile);
+      config.compact_framing = compact;
+      auto bench = SafeStreamFraming{lan_profile, config};
+      // size prefix of sized framing is in the stream too
+      auto count = std::min(std::size_t{1000},
+                            kThroughputBytes / (message_size + 4));
+      framing_results.emplace_back(bench.Run(message_size, count));
+    }
+  }
+
+  result_stream << "\nframing,message size,messages,data bytes per "
+                   "message,confirm bytes per message,overhead bytes\n";
+  for (auto const& result : framing_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  // single lost data packet at the start, in the middle and at the tail
+  static constexpr std::size_t kRecoveryMessages = 20;
+  std::vector<RecoveryResult> recovery_results;
+  for (auto const& profile : link_profiles) {
+    for (auto position :
+         {LostPacket::kFirst, LostPacket::kMiddle, LostPacket::kLast}) {
+      AE_TELED_INFO("Run recovery bench for {}", profile.name);
+      auto bench =
+          SafeStreamLossRecovery{profile, MakeThroughputConfig(profile)};
+      recovery_results.emplace_back(bench.Run(kRecoveryMessages, position));
+    }
+  }
+
+  result_stream << "\nlink,position,lost packet,clean delivery us,lossy "
+                   "delivery us,loss penalty us\n";
+  for (auto const& result : recovery_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  // link goes down in the middle of the transfer and gets up again
+  static constexpr std::size_t kResumeMessages = 20;
+  static constexpr auto kDownTime = std::chrono::milliseconds{100};
+  std::vector<ResumeResult> resume_results;
+  for (auto const& profile : link_profiles) {
+    AE_TELED_INFO("Run resume bench for {}", profile.name);
+    auto bench =
+        SafeStreamRelinkResume{profile, MakeThroughputConfig(profile)};
+    resume_results.emplace_back(bench.Run(kResumeMessages, kDownTime));
+  }
+
+  result_stream << "\nlink,down time us,rest bytes,resume delay us,rest "
+                   "delivery us,rest link time us\n";
+  for (auto const& result : resume_results) {
+    Format(result_stream, "{}\n", result);
+  }
+  return 0;
+}
+}  // namespace ae::bench
+
+int main() { return ae::bench::safe_stream_bench(std::cout); }
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "safe_stream_bench/recovery_bench.h"
+
+#include <chrono>
+#include <utility>
+
+#include "aether/actions/action_list.h"
+#include "aether/actions/action_processor.h"
+#include "aether/stream_api/safe_stream.h"
+#include "aether/stream_api/safe_stream/safe_stream_api.h"
+
+#include "aether/tele/tele.h"
+
+namespace ae::bench {
+// max virtual time to run a single bench
+static constexpr auto kMaxRunTime = std::chrono::minutes{10};
+// step of virtual time if nothing is scheduled
+static constexpr auto kIdleStep = std::chrono::milliseconds{1};
+static constexpr std::size_t kMessageSize = 1000;
+
+namespace {
+/**
+ * \brief Drops the lost_packet-th Send packet going to the link.
+ */
+class LossGate final : public ByteGate {
+ public:
+  LossGate(ActionContext action_context, std::size_t lost_packet)
+      : lost_packet_{lost_packet}, write_actions_{action_context} {}
+
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint current_time) override {
+    if (!buffer.empty() &&
+        (buffer[0] == SafeStreamApi::Send::kMessageCode) &&
+        (++send_count_ == lost_packet_)) {
+      // looks written for the sender
+      return write_actions_.Emplace();
+    }
+    return out_->Write(std::move(buffer), current_time);
+  }
+
+  std::size_t send_count() const { return send_count_; }
+
+ private:
+  std::size_t lost_packet_;
+  std::size_t send_count_{};
+  ActionList<SimWriteAction> write_actions_;
+};
+}  // namespace
+
+SafeStreamLossRecovery::SafeStreamLossRecovery(LinkProfile link_profile,
+                                               SafeStreamConfig config)
+    : link_profile_{std::move(link_profile)}, config_{config} {}
+
+RecoveryResult SafeStreamLossRecovery::Run(std::size_t message_count,
+                                           LostPacket position) {
+  auto clean = Deliver(message_count, 0);
+  auto lost_packet = std::size_t{};
+  auto position_name = std::string{};
+  switch (position) {
+    case LostPacket::kFirst:
+      lost_packet = 1;
+      position_name = "first";
+      break;
+    case LostPacket::kMiddle:
+      lost_packet = (clean.send_packets + 1) / 2;
+      position_name = "middle";
+      break;
+    case LostPacket::kLast:
+      lost_packet = clean.send_packets;
+      position_name = "last";
+      break;
+  }
+  auto lossy = Deliver(message_count, lost_packet);
+  auto penalty = (lossy.time > clean.time) ? (lossy.time - clean.time)
+                                           : Duration::zero();
+  return RecoveryResult{
+      link_profile_,
+      std::move(position_name),
+      lost_packet,
+      clean.time,
+      lossy.time,
+      penalty,
+  };
+}
+
+SafeStreamLossRecovery::Delivery SafeStreamLossRecovery::Deliver(
+    std::size_t message_count, std::size_t lost_packet) {
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, link_profile_};
+  auto sender = SafeStream{ap, config_};
+  auto receiver = SafeStream{ap, config_};
+  auto loss_gate = LossGate{ap, lost_packet};
+  Tie(sender, loss_gate, link.left());
+  receiver.LinkOut(link.right());
+
+  auto const bytes_count = message_count * kMessageSize;
+  std::size_t received = 0;
+  auto receive_sub = receiver.in().out_data_event().Subscribe(
+      [&](auto const& data) { received += data.size(); });
+
+  auto const start_time = TimePoint{};
+  auto current_time = start_time;
+  for (std::size_t i = 0; i < message_count; ++i) {
+    sender.in().Write(DataBuffer(kMessageSize, std::uint8_t{0x42}),
+                      current_time);
+  }
+
+  while ((received < bytes_count) &&
+         ((current_time - start_time) < kMaxRunTime)) {
+    auto next_time = ap.Update(current_time);
+    // virtual clock, so wait only for triggered actions
+    if (ap.get_trigger().WaitUntil(current_time)) {
+      continue;
+    }
+    current_time = (next_time > current_time) ? next_time
+                                              : (current_time + kIdleStep);
+  }
+  if (received < bytes_count) {
+    AE_TELED_ERROR("Data is not delivered");
+  }
+  return Delivery{
+      std::chrono::duration_cast<Duration>(current_time - start_time),
+      loss_gate.send_count()};
+}
+}  // namespace ae::bench
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SAFE_STREAM_BENCH_RECOVERY_BENCH_H_
+#define EXAMPLES_BENCHES_SAFE_STREAM_BENCH_RECOVERY_BENCH_H_
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "aether/common.h"
+#include "aether/tele/ios.h"
+#include "aether/stream_api/safe_stream/safe_stream_types.h"
+
+#include "test_utils/sim_link.h"
+
+namespace ae::bench {
+enum class LostPacket : std::uint8_t {
+  kFirst,
+  kMiddle,
+  kLast,
+};
+
+struct RecoveryResult {
+  LinkProfile link;
+  std::string position;     //< first, middle or last of the data packets
+  std::size_t lost_packet;  //< number of the lost data packet from 1
+  Duration clean_time;      //< time to deliver all data without loss
+  Duration lossy_time;      //< time to deliver all data with the loss
+  Duration penalty;         //< extra delivery time caused by the loss
+};
+
+/**
+ * \brief Measures SafeStream recovery of a single lost data packet.
+ * All messages are written at once and the same transfer runs twice, without
+ * loss and with one dropped Send packet. The clean run counts the data
+ * packets, so the lost one is picked by its position. A loss after confirmed
+ * data is repeated on duplicated confirms, without such confirms the repeat
+ * waits for the confirm timeout. Runs in virtual time over the simulated
+ * link.
+ */
+class SafeStreamLossRecovery {
+ public:
+  SafeStreamLossRecovery(LinkProfile link_profile, SafeStreamConfig config);
+
+  RecoveryResult Run(std::size_t message_count, LostPacket position);
+
+ private:
+  struct Delivery {
+    Duration time;
+    std::size_t send_packets;
+  };
+
+  Delivery Deliver(std::size_t message_count, std::size_t lost_packet);
+
+  LinkProfile link_profile_;
+  SafeStreamConfig config_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::RecoveryResult> {
+  static void Print(std::ostream& s, bench::RecoveryResult const& r) {
+    s << r.link.name << "," << r.position << "," << r.lost_packet << ","
+      << r.clean_time.count()
+      << "," << r.lossy_time.count() << "," << r.penalty.count();
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SAFE_STREAM_BENCH_RECOVERY_BENCH_H_
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "safe_stream_bench/resume_bench.h"
+
+#include <chrono>
+#include <utility>
+#include <optional>
+
+#include "aether/actions/action_processor.h"
+#include "aether/stream_api/safe_stream.h"
+
+#include "aether/tele/tele.h"
+
+namespace ae::bench {
+// max virtual time to run a single bench
+static constexpr auto kMaxRunTime = std::chrono::minutes{10};
+// step of virtual time if nothing is scheduled
+static constexpr auto kIdleStep = std::chrono::milliseconds{1};
+static constexpr std::size_t kMessageSize = 1000;
+
+SafeStreamRelinkResume::SafeStreamRelinkResume(LinkProfile link_profile,
+                                               SafeStreamConfig config)
+    : link_profile_{std::move(link_profile)}, config_{config} {}
+
+ResumeResult SafeStreamRelinkResume::Run(std::size_t message_count,
+                                         Duration down_time) {
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, link_profile_};
+  auto sender = SafeStream{ap, config_};
+  auto receiver = SafeStream{ap, config_};
+  sender.LinkOut(link.left());
+  receiver.LinkOut(link.right());
+
+  auto const bytes_count = message_count * kMessageSize;
+  std::size_t received = 0;
+  auto receive_sub = receiver.in().out_data_event().Subscribe(
+      [&](auto const& data) { received += data.size(); });
+
+  auto const start_time = TimePoint{};
+  auto current_time = start_time;
+  for (std::size_t i = 0; i < message_count; ++i) {
+    sender.in().Write(DataBuffer(kMessageSize, std::uint8_t{0x42}),
+                      current_time);
+  }
+
+  std::size_t received_before = 0;
+  auto relink_time = std::optional<TimePoint>{};
+  auto resume_time = std::optional<TimePoint>{};
+  bool linked = true;
+
+  while ((received < bytes_count) &&
+         ((current_time - start_time) < kMaxRunTime)) {
+    auto next_time = ap.Update(current_time);
+    if (!relink_time && (received >= (bytes_count / 2))) {
+      // data in flight is lost with the link
+      link.set_linked(false);
+      linked = false;
+      received_before = received;
+      relink_time = current_time + down_time;
+    }
+    if (!resume_time && linked && relink_time &&
+        (received > received_before)) {
+      resume_time = current_time;
+    }
+    // virtual clock, so wait only for triggered actions
+    if (ap.get_trigger().WaitUntil(current_time)) {
+      continue;
+    }
+    current_time = (next_time > current_time) ? next_time
+                                              : (current_time + kIdleStep);
+    if (!linked && (current_time >= *relink_time)) {
+      current_time = *relink_time;
+      link.set_linked(true);
+      linked = true;
+    }
+  }
+  if (received < bytes_count) {
+    AE_TELED_ERROR("Data is not delivered");
+  }
+  if (!relink_time || !resume_time) {
+    return ResumeResult{link_profile_, down_time, {}, {}, {}, {}};
+  }
+  auto to_duration = [](auto duration) {
+    return std::chrono::duration_cast<Duration>(duration);
+  };
+  auto rest_bytes = bytes_count - received_before;
+  auto link_time = std::chrono::microseconds{
+      rest_bytes * 1'000'000 / link_profile_.bandwidth};
+  return ResumeResult{
+      link_profile_,
+      down_time,
+      rest_bytes,
+      to_duration(*resume_time - *relink_time),
+      to_duration(current_time - *relink_time),
+      to_duration(link_time + link_profile_.delay),
+  };
+}
+}  // namespace ae::bench
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SAFE_STREAM_BENCH_RESUME_BENCH_H_
+#define EXAMPLES_BENCHES_SAFE_STREAM_BENCH_RESUME_BENCH_H_
+
+#include <cstddef>
+#include <ostream>
+
+#include "aether/common.h"
+#include "aether/tele/ios.h"
+#include "aether/stream_api/safe_stream/safe_stream_types.h"
+
+#include "test_utils/sim_link.h"
+
+namespace ae::bench {
+struct ResumeResult {
+  LinkProfile link;
+  Duration down_time;      //< time the link is down
+  std::size_t rest_bytes;  //< bytes not received before the link is down
+  Duration resume_delay;   //< time from relink to the next delivered data
+  Duration rest_time;      //< time from relink to all data delivered
+  Duration link_time;      //< time the link needs to deliver the rest bytes
+};
+
+/**
+ * \brief Measures SafeStream resume after the link goes down and up again.
+ * The link goes down when a half of the data is received, packets in flight
+ * are lost with it. The sender must repeat them right after the relink
+ * instead of waiting for the confirm timeout. Runs in virtual time over the
+ * simulated link.
+ */
+class SafeStreamRelinkResume {
+ public:
+  SafeStreamRelinkResume(LinkProfile link_profile, SafeStreamConfig config);
+
+  ResumeResult Run(std::size_t message_count, Duration down_time);
+
+ private:
+  LinkProfile link_profile_;
+  SafeStreamConfig config_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::ResumeResult> {
+  static void Print(std::ostream& s, bench::ResumeResult const& r) {
+    s << r.link.name << "," << r.down_time.count() << "," << r.rest_bytes
+      << "," << r.resume_delay.count() << "," << r.rest_time.count() << ","
+      << r.link_time.count();
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SAFE_STREAM_BENCH_RESUME_BENCH_H_
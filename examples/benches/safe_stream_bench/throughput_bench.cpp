@@ -0,0 +1,220 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "safe_stream_bench/throughput_bench.h"
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "aether/actions/action_processor.h"
+#include "aether/stream_api/safe_stream.h"
+#include "aether/stream_api/safe_stream/safe_stream_api.h"
+
+#include "aether/tele/tele.h"
+
+namespace ae::bench {
+// max virtual time to run a single bench
+static constexpr auto kMaxRunTime = std::chrono::minutes{10};
+// step of virtual time if nothing is scheduled
+static constexpr auto kIdleStep = std::chrono::milliseconds{1};
+static constexpr std::size_t kMessageSize = 4 * 1024;
+
+namespace {
+/**
+ * \brief Counts first sent and repeated data packets going to the link.
+ * SafeStream packet starts with the Send or Repeat message code.
+ */
+class SendCounterGate final : public ByteGate {
+ public:
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint current_time) override {
+    if (!buffer.empty()) {
+      if (buffer[0] == SafeStreamApi::Send::kMessageCode) {
+        ++sent_;
+      } else if (buffer[0] == SafeStreamApi::Repeat::kMessageCode) {
+        ++repeated_;
+      }
+    }
+    return out_->Write(std::move(buffer), current_time);
+  }
+
+  double retransmit_ratio() const {
+    return (sent_ == 0) ? 0.0
+                        : static_cast<double>(repeated_) /
+                              static_cast<double>(sent_);
+  }
+
+ private:
+  std::size_t sent_{};
+  std::size_t repeated_{};
+};
+}  // namespace
+
+SafeStreamConfig MakeThroughputConfig(LinkProfile const& link_profile) {
+  // window must be less than half of the offset space, and the buffer is not
+  // bigger than window to keep all buffered offsets comparable
+  constexpr auto kWindowSize = static_cast<SafeStreamRingIndex::type>(
+      std::min<std::uint64_t>((SafeStreamRingIndex::max / 2) - 1,
+                              std::uint64_t{4} * 1024 * 1024));
+
+  SafeStreamConfig config;
+  config.buffer_capacity = kWindowSize;
+  config.window_size = kWindowSize;
+  config.max_data_size = kWindowSize - 1;
+  config.max_repeat_count = 10;
+  // full window must be drained by the link before the confirm returns
+  auto window_time = std::chrono::microseconds{
+      (std::uint64_t{kWindowSize} * 1'000'000) / link_profile.bandwidth};
+  config.wait_confirm_timeout = std::chrono::duration_cast<Duration>(
+      (link_profile.delay * 2) + (window_time * 2) +
+      std::chrono::milliseconds{100});
+  config.send_confirm_timeout = {};
+  config.send_repeat_timeout = std::chrono::milliseconds{1000};
+  return config;
+}
+
+SafeStreamThroughput::SafeStreamThroughput(LinkProfile link_profile,
+                                           SafeStreamConfig config,
+                                           std::optional<FecConfig> fec_config)
+    : link_profile_{std::move(link_profile)},
+      config_{config},
+      fec_config_{fec_config} {}
+
+ThroughputResult SafeStreamThroughput::Run(std::size_t bytes_count) {
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, link_profile_};
+  auto sender = SafeStream{ap, config_};
+  auto receiver = SafeStream{ap, config_};
+  auto send_counter = SendCounterGate{};
+  auto sender_fec = std::optional<FecGate>{};
+  auto receiver_fec = std::optional<FecGate>{};
+  if (fec_config_) {
+    sender_fec.emplace(ap, *fec_config_);
+    receiver_fec.emplace(ap, *fec_config_);
+    Tie(sender, send_counter, *sender_fec, link.left());
+    Tie(receiver, *receiver_fec, link.right());
+  } else {
+    Tie(sender, send_counter, link.left());
+    receiver.LinkOut(link.right());
+  }
+
+  auto const start_time = TimePoint{};
+  auto current_time = start_time;
+
+  std::size_t received = 0;
+  std::size_t written = 0;
+  std::size_t in_buffer = 0;
+  // stream gives up on repeat count exceeded
+  bool failed = false;
+  // end offset and write time of messages not delivered yet
+  std::deque<std::pair<std::size_t, TimePoint>> messages;
+  std::vector<Duration> latencies;
+
+  auto receive_sub =
+      receiver.in().out_data_event().Subscribe([&](auto const& data) {
+        received += data.size();
+        while (!messages.empty() && (messages.front().first <= received)) {
+          latencies.push_back(std::chrono::duration_cast<Duration>(
+              current_time - messages.front().second));
+          messages.pop_front();
+        }
+      });
+
+  MultiSubscription write_subs;
+
+  auto write_more = [&]() {
+    while ((written < bytes_count) &&
+           ((in_buffer + kMessageSize) <= config_.buffer_capacity)) {
+      auto size = std::min(kMessageSize, bytes_count - written);
+      auto action =
+          sender.in().Write(DataBuffer(size, std::uint8_t{0x42}), current_time);
+      written += size;
+      in_buffer += size;
+      messages.emplace_back(written, current_time);
+      write_subs.Push(action->SubscribeOnResult(
+                          [&, size](auto const&) { in_buffer -= size; }),
+                      action->SubscribeOnError([&](auto const&) {
+                        AE_TELED_ERROR("Write failed");
+                        failed = true;
+                      }));
+    }
+  };
+
+  while (!failed && (received < bytes_count) &&
+         ((current_time - start_time) < kMaxRunTime)) {
+    write_more();
+    auto next_time = ap.Update(current_time);
+    // virtual clock, so wait only for triggered actions
+    if (ap.get_trigger().WaitUntil(current_time)) {
+      continue;
+    }
+    current_time = (next_time > current_time) ? next_time
+                                              : (current_time + kIdleStep);
+  }
+
+  auto duration = std::chrono::duration_cast<Duration>(current_time -
+                                                       start_time);
+  auto seconds = std::chrono::duration<double>(current_time - start_time);
+  auto p50_latency = Duration{};
+  auto p90_latency = Duration{};
+  auto p99_latency = Duration{};
+  auto jitter = Duration{};
+  if (!latencies.empty()) {
+    std::sort(std::begin(latencies), std::end(latencies));
+    p50_latency = latencies[(latencies.size() * 50 + 99) / 100 - 1];
+    p90_latency = latencies[(latencies.size() * 90 + 99) / 100 - 1];
+    p99_latency = latencies[(latencies.size() * 99 + 99) / 100 - 1];
+
+    double sum = 0;
+    double square_sum = 0;
+    for (auto const& latency : latencies) {
+      auto value = static_cast<double>(latency.count());
+      sum += value;
+      square_sum += value * value;
+    }
+    auto count = static_cast<double>(latencies.size());
+    auto mean = sum / count;
+    jitter = Duration{static_cast<Duration::rep>(
+        std::sqrt(std::max(0.0, (square_sum / count) - (mean * mean))))};
+  }
+  auto fec = fec_config_ ? Format("{}+{}", int{fec_config_->data_count},
+                                  int{fec_config_->parity_count})
+                         : std::string{"none"};
+
+  return ThroughputResult{
+      link_profile_,
+      std::move(fec),
+      config_.pacing,
+      static_cast<std::size_t>(config_.window_size),
+      received,
+      duration,
+      static_cast<double>(received) / seconds.count(),
+      p50_latency,
+      p90_latency,
+      p99_latency,
+      jitter,
+      link.sent_packets(),
+      link.dropped_packets(),
+      receiver_fec ? receiver_fec->restored_count() : 0,
+      send_counter.retransmit_ratio(),
+  };
+}
+}  // namespace ae::bench
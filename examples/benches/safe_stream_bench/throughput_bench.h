@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef EXAMPLES_BENCHES_SAFE_STREAM_BENCH_THROUGHPUT_BENCH_H_
+#define EXAMPLES_BENCHES_SAFE_STREAM_BENCH_THROUGHPUT_BENCH_H_
+
+#include <string>
+#include <cstddef>
+#include <ostream>
+#include <optional>
+
+#include "aether/common.h"
+#include "aether/tele/ios.h"
+#include "aether/stream_api/fec_gate.h"
+#include "aether/stream_api/safe_stream/safe_stream_types.h"
+
+#include "test_utils/sim_link.h"
+
+namespace ae::bench {
+struct ThroughputResult {
+  LinkProfile link;
+  std::string fec;  //< fec config as data+parity or none
+  bool pacing;      //< sending is paced
+  std::size_t window_size;
+  std::size_t bytes;     //< bytes delivered to the receiver
+  Duration duration;     //< virtual time spent to deliver all bytes
+  double goodput;        //< delivered bytes per second
+  Duration p50_latency;  //< median of message delivery time
+  Duration p90_latency;  //< 90th percentile of message delivery time
+  Duration p99_latency;  //< 99th percentile of message delivery time
+  Duration jitter;       //< standard deviation of message delivery time
+  std::size_t packets;   //< packets sent through the link in both directions
+  std::size_t dropped;   //< packets dropped by the link queue limit
+  std::size_t restored;  //< packets restored by fec
+  double retransmit_ratio;  //< repeated data packets per first sent one
+};
+
+/**
+ * \brief Measures SafeStream throughput over the simulated link.
+ * Sender keeps the SafeStream sending buffer full and the receiver counts the
+ * delivered bytes and the delivery time of each message. Sent and repeated
+ * data packets are counted right under the sender. Optional FecGate is
+ * placed between each SafeStream and the link. Everything runs in virtual time
+ * so result depends only on the link profile and the configs.
+ */
+class SafeStreamThroughput {
+ public:
+  SafeStreamThroughput(LinkProfile link_profile, SafeStreamConfig config,
+                       std::optional<FecConfig> fec_config = {});
+
+  ThroughputResult Run(std::size_t bytes_count);
+
+ private:
+  LinkProfile link_profile_;
+  SafeStreamConfig config_;
+  std::optional<FecConfig> fec_config_;
+};
+
+/**
+ * \brief Default config uses the biggest window the offset space allows and
+ * confirm timeout long enough to drain that window over the link.
+ */
+SafeStreamConfig MakeThroughputConfig(LinkProfile const& link_profile);
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::ThroughputResult> {
+  static void Print(std::ostream& s, bench::ThroughputResult const& r) {
+    s << r.link.name << "," << r.link.loss << "," << r.fec << ","
+      << (r.pacing ? "paced" : "burst") << "," << r.window_size << ","
+      << r.bytes << "," << r.duration.count() << ","
+      << (r.goodput * 8 / 1'000'000) << "," << r.p50_latency.count() << ","
+      << r.p90_latency.count() << "," << r.p99_latency.count() << ","
+      << r.jitter.count() << "," << r.packets << "," << r.dropped << ","
+      << r.restored << "," << r.retransmit_ratio;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SAFE_STREAM_BENCH_THROUGHPUT_BENCH_H_
@@ -18,30 +18,11 @@
 
 #include <cassert>
 
+#include "aether/api_protocol/api_dispatch.h"
+
 namespace ae::bench {
 void BenchDelaysApi::LoadFactory(MessageId message_code, ApiParser& parser) {
-  switch (message_code) {
-    case WarmUp::kMessageCode:
-      parser.Load<WarmUp>(*this);
-      break;
-    case TwoByte::kMessageCode:
-      parser.Load<TwoByte>(*this);
-      break;
-    case TenBytes::kMessageCode:
-      parser.Load<TenBytes>(*this);
-      break;
-    case HundredBytes::kMessageCode:
-      parser.Load<HundredBytes>(*this);
-      break;
-    case ThousandBytes::kMessageCode:
-      parser.Load<ThousandBytes>(*this);
-      break;
-    case ThousandAndHalfBytes::kMessageCode:
-      parser.Load<ThousandAndHalfBytes>(*this);
-      break;
-    default:
-      assert(false);
-      break;
-  }
+  [[maybe_unused]] auto res = DispatchLoad(*this, message_code, parser);
+  assert(res);
 }
 }  // namespace ae::bench
@@ -129,6 +129,14 @@ class BenchDelaysApi : public ApiClass {
     std::array<std::uint8_t, 1398> payload;
   };
 
+  using Messages = ApiMessageList<
+      ApiMessageCode<WarmUp::kMessageCode, WarmUp>,
+      ApiMessageCode<TwoByte::kMessageCode, TwoByte>,
+      ApiMessageCode<TenBytes::kMessageCode, TenBytes>,
+      ApiMessageCode<HundredBytes::kMessageCode, HundredBytes>,
+      ApiMessageCode<ThousandBytes::kMessageCode, ThousandBytes>,
+      ApiMessageCode<ThousandAndHalfBytes::kMessageCode, ThousandAndHalfBytes>>;
+
   void LoadFactory(MessageId message_code, ApiParser& parser) override;
 
   template <typename T>
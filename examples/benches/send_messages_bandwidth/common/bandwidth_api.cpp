@@ -16,39 +16,16 @@
 
 #include "send_messages_bandwidth/common/bandwidth_api.h"
 
+#include <cassert>
+
+#include "aether/api_protocol/api_dispatch.h"
+
 namespace ae::bench {
 void BandwidthApi::LoadFactory(MessageId message_code, ApiParser& api_parser) {
-  switch (message_code) {
-    case Handshake::kMessageCode:
-      api_parser.Load<Handshake>(*this);
-      break;
-    case Sync::kMessageCode:
-      api_parser.Load<Sync>(*this);
-      break;
-    case WarmUp::kMessageCode:
-      api_parser.Load<WarmUp>(*this);
-      break;
-    case OneByte::kMessageCode:
-      api_parser.Load<OneByte>(*this);
-      break;
-    case TenBytes::kMessageCode:
-      api_parser.Load<TenBytes>(*this);
-      break;
-    case HundredBytes::kMessageCode:
-      api_parser.Load<HundredBytes>(*this);
-      break;
-    case ThousandBytes::kMessageCode:
-      api_parser.Load<ThousandBytes>(*this);
-      break;
-    case VarMessageSize::kMessageCode:
-      api_parser.Load<VarMessageSize>(*this);
-      break;
-    default:
-      if (!ExtendsApi::LoadExtend(message_code, api_parser)) {
-        assert(false);
-      }
-      break;
-  }
+  [[maybe_unused]] auto res =
+      DispatchLoad(*this, message_code, api_parser) ||
+      ExtendsApi::LoadExtend(message_code, api_parser);
+  assert(res);
 }
 
 template <typename T>
@@ -136,6 +136,16 @@ class BandwidthApi : public ApiClass, ExtendsApi<ReturnResultApi> {
     std::vector<std::uint8_t> payload;
   };
 
+  using Messages = ApiMessageList<
+      ApiMessageCode<Handshake::kMessageCode, Handshake>,
+      ApiMessageCode<Sync::kMessageCode, Sync>,
+      ApiMessageCode<WarmUp::kMessageCode, WarmUp>,
+      ApiMessageCode<OneByte::kMessageCode, OneByte>,
+      ApiMessageCode<TenBytes::kMessageCode, TenBytes>,
+      ApiMessageCode<HundredBytes::kMessageCode, HundredBytes>,
+      ApiMessageCode<ThousandBytes::kMessageCode, ThousandBytes>,
+      ApiMessageCode<VarMessageSize::kMessageCode, VarMessageSize>>;
+
   void LoadFactory(MessageId message_code, ApiParser& api_parser) override;
 
   template <typename T>
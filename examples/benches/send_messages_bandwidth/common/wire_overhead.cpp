@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "send_messages_bandwidth/common/wire_overhead.h"
+
+#include <cstdint>
+
+#include "aether/config.h"
+#include "aether/obj/ptr.h"
+#include "aether/crypto/key.h"
+#include "aether/crypto/crypto_nonce.h"
+#include "aether/crypto/ikey_provider.h"
+#include "aether/crypto/sync_crypto_provider.h"
+#include "aether/crypto/sodium/sodium_sync_crypto_provider.h"
+
+namespace ae::bench {
+namespace {
+class WireKeyProvider : public ISyncKeyProvider {
+ public:
+  WireKeyProvider() {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+    auto key = SodiumChachaKey{};
+    crypto_aead_chacha20poly1305_keygen(key.key.data());
+    key_ = key;
+#endif
+    nonce_.Init();
+  }
+
+  Key GetKey() const override { return key_; }
+  CryptoNonce const& Nonce() const override { return nonce_; }
+
+ private:
+  Key key_;
+  CryptoNonce nonce_;
+};
+}  // namespace
+
+WireOverhead::WireOverhead(std::size_t message_size)
+    : message_size{message_size},
+      explicit_nonce_bytes{},
+      implicit_nonce_bytes{},
+      saving{} {
+  auto key_provider = MakePtr<WireKeyProvider>();
+  auto message = DataBuffer(message_size);
+
+  explicit_nonce_bytes =
+      SyncEncryptProvider{key_provider}.Encrypt(message).size();
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  // the epoch base is sent with one of kBaseSyncInterval packets
+  auto implicit_encrypt = SodiumImplicitNonceEncryptProvider{key_provider};
+  auto total_bytes = std::size_t{};
+  for (std::uint32_t i = 0; i < ImplicitNonceEpoch::kBaseSyncInterval; ++i) {
+    total_bytes += implicit_encrypt.Encrypt(message).size();
+  }
+  implicit_nonce_bytes = total_bytes / ImplicitNonceEpoch::kBaseSyncInterval;
+#else
+  implicit_nonce_bytes = explicit_nonce_bytes;
+#endif
+  saving = 1.0 - static_cast<double>(implicit_nonce_bytes) /
+                     static_cast<double>(explicit_nonce_bytes);
+}
+}  // namespace ae::bench
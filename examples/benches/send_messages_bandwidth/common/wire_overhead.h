@@ -0,0 +1,52 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SEND_MESSAGES_BANDWIDTH_COMMON_WIRE_OVERHEAD_H_
+#define EXAMPLES_BENCHES_SEND_MESSAGES_BANDWIDTH_COMMON_WIRE_OVERHEAD_H_
+
+#include <cstddef>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+/**
+ * \brief Bytes on wire of one encrypted message with the explicit nonce and
+ * the average with the implicit counter nonce.
+ */
+class WireOverhead {
+ public:
+  explicit WireOverhead(std::size_t message_size);
+
+  std::size_t message_size;
+  std::size_t explicit_nonce_bytes;
+  std::size_t implicit_nonce_bytes;
+  double saving;  //< part of explicit nonce bytes saved
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::WireOverhead> {
+  static void Print(std::ostream& s, bench::WireOverhead const& w) {
+    s << "Message size: " << w.message_size
+      << " Explicit nonce: " << w.explicit_nonce_bytes << " bytes"
+      << " Implicit nonce: " << w.implicit_nonce_bytes << " bytes"
+      << " Saving: " << w.saving * 100 << " %";
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SEND_MESSAGES_BANDWIDTH_COMMON_WIRE_OVERHEAD_H_
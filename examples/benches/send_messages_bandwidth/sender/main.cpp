@@ -35,6 +35,7 @@
 
 #include "send_messages_bandwidth/common/sender.h"
 #include "send_messages_bandwidth/common/test_action.h"
+#include "send_messages_bandwidth/common/wire_overhead.h"
 
 namespace ae::bench {
 
@@ -178,6 +179,14 @@ int test_sender_bandwidth(Uid receiver_uid) {
         }
         AE_TELED_DEBUG("Test results: \n {}", res_string);
 
+        // crypto bytes on wire for the same message sizes
+        auto wire_string = std::string{};
+        for (auto message_size : {1, 10, 100, 1000}) {
+          wire_string += Format(
+              "{}\n", WireOverhead{static_cast<std::size_t>(message_size)});
+        }
+        AE_TELED_DEBUG("Wire overhead: \n {}", wire_string);
+
         test_done = true;
       });
 
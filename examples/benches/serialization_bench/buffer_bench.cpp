@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization_bench/buffer_bench.h"
+
+#include <chrono>
+#include <utility>
+
+#include "aether/memory_buffer.h"
+
+namespace ae::bench {
+namespace {
+double MegabytesPerSecond(std::size_t bytes,
+                          std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(bytes) / (1024 * 1024) / seconds
+                     : 0;
+}
+
+// appends chunk_count chunks of chunk_size into a buffer run_count times
+template <typename TAppend>
+BufferAppendResult Measure(std::string payload, std::string mode,
+                           std::size_t run_count, std::size_t chunk_size,
+                           std::size_t chunk_count, TAppend&& append) {
+  auto chunk = std::vector<char>(chunk_size, 0x55);
+  std::size_t bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < run_count; ++i) {
+    bytes += append(chunk, chunk_count);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return BufferAppendResult{std::move(payload), std::move(mode), chunk_count,
+                            MegabytesPerSecond(bytes, duration)};
+}
+
+void RunPayload(std::vector<BufferAppendResult>& results,
+                std::string const& payload, std::size_t run_count,
+                std::size_t chunk_size, std::size_t chunk_count) {
+  results.emplace_back(Measure(
+      payload, "block growth", run_count, chunk_size, chunk_count,
+      [](auto const& chunk, auto count) {
+        auto buffer = MemStreamBuf<>{};
+        auto size = static_cast<std::streamsize>(chunk.size());
+        for (std::size_t i = 0; i < count; ++i) {
+          if (size > buffer.AvailableCapacity()) {
+            buffer.SetCapacity(buffer.Size() + size);
+          }
+          buffer.sputn(chunk.data(), size);
+        }
+        return static_cast<std::size_t>(buffer.Size());
+      }));
+  results.emplace_back(Measure(
+      payload, "geometric growth", run_count, chunk_size, chunk_count,
+      [](auto const& chunk, auto count) {
+        auto buffer = MemStreamBuf<>{};
+        auto size = static_cast<std::streamsize>(chunk.size());
+        for (std::size_t i = 0; i < count; ++i) {
+          buffer.sputn(chunk.data(), size);
+        }
+        return static_cast<std::size_t>(buffer.Size());
+      }));
+  auto reused = MemStreamBuf<>{};
+  results.emplace_back(Measure(
+      payload, "reused buffer", run_count, chunk_size, chunk_count,
+      [&](auto const& chunk, auto count) {
+        reused.Reset();
+        auto size = static_cast<std::streamsize>(chunk.size());
+        for (std::size_t i = 0; i < count; ++i) {
+          reused.sputn(chunk.data(), size);
+        }
+        return static_cast<std::size_t>(reused.Size());
+      }));
+}
+}  // namespace
+
+BufferAppendRate::BufferAppendRate(std::size_t run_count)
+    : run_count_{run_count} {}
+
+std::vector<BufferAppendResult> BufferAppendRate::Run() {
+  std::vector<BufferAppendResult> results;
+  // 1 MiB packet in tcp segment sized chunks
+  RunPayload(results, "large 1400", run_count_, 1400, 750);
+  // many small messages
+  RunPayload(results, "small 16", run_count_, 16, 10'000);
+  return results;
+}
+}  // namespace ae::bench
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SERIALIZATION_BENCH_BUFFER_BENCH_H_
+#define EXAMPLES_BENCHES_SERIALIZATION_BENCH_BUFFER_BENCH_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct BufferAppendResult {
+  std::string payload;
+  std::string mode;  //< buffer growth or reuse mode
+  std::size_t appends;
+  double megabytes_per_second;
+};
+
+/**
+ * \brief Measures appending data to MemStreamBuf.
+ * Block growth reallocates by the appended size as MemStreamBuf did before,
+ * geometric growth is the current policy, and reused buffer is reset between
+ * runs keeping its memory.
+ */
+class BufferAppendRate {
+ public:
+  explicit BufferAppendRate(std::size_t run_count);
+
+  /**
+   * \brief Large packet received in socket sized chunks and many small
+   * appends.
+   */
+  std::vector<BufferAppendResult> Run();
+
+ private:
+  std::size_t run_count_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::BufferAppendResult> {
+  static void Print(std::ostream& s, bench::BufferAppendResult const& r) {
+    s << r.payload << "," << r.mode << "," << r.appends << ","
+      << r.megabytes_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SERIALIZATION_BENCH_BUFFER_BENCH_H_
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstddef>
+#include <iostream>
+
+#include "aether/port/tele_init.h"
+#include "aether/tele/tele.h"
+
+#include "serialization_bench/serialization_bench.h"
+#include "serialization_bench/buffer_bench.h"
+#include "serialization_bench/packed_int_bench.h"
+#include "serialization_bench/packet_receive_bench.h"
+
+namespace ae::bench {
+static constexpr std::size_t kMessages = 1'000'000;
+static constexpr std::size_t kVectorMessages = 10'000;
+static constexpr std::size_t kVectorSize = 1024;
+static constexpr std::size_t kReceiveMessages = 10'000;
+static constexpr std::size_t kBufferRuns = 200;
+static constexpr std::size_t kPackedValues = 100'000;
+static constexpr std::size_t kPackedRounds = 20;
+static constexpr std::size_t kReceivePackets = 1000;
+static constexpr std::size_t kReceiveRounds = 1000;
+
+int serialization_bench(std::ostream& result_stream) {
+  TeleInit::Init();
+
+  AE_TELED_INFO("Run serialization bench");
+  auto results = SerializationRate{kMessages}.Run();
+
+  result_stream << "message,mode,bytes,messages/s\n";
+  for (auto const& result : results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  AE_TELED_INFO("Run vector serialization bench");
+  auto vector_results =
+      SerializationRate{kVectorMessages}.RunVectors(kVectorSize);
+
+  result_stream << "\nvector,mode,bytes,vectors/s\n";
+  for (auto const& result : vector_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  AE_TELED_INFO("Run receive bench");
+  auto receive_results = SerializationRate{kReceiveMessages}.RunReceive(
+      {1200, 64 * 1024, 1024 * 1024});
+
+  result_stream << "\nmessage,mode,bytes,messages/s\n";
+  for (auto const& result : receive_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  AE_TELED_INFO("Run buffer append bench");
+  auto buffer_results = BufferAppendRate{kBufferRuns}.Run();
+
+  result_stream << "\npayload,mode,appends,MB/s\n";
+  for (auto const& result : buffer_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  AE_TELED_INFO("Run packet receive bench");
+  auto packet_results =
+      PacketReceiveRate{kReceivePackets, kReceiveRounds}.Run();
+
+  result_stream << "\nbuffers,packets/s,allocations/packet\n";
+  for (auto const& result : packet_results) {
+    Format(result_stream, "{}\n", result);
+  }
+
+  AE_TELED_INFO("Run packed int bench");
+  auto packed_results = PackedIntRate{kPackedValues, kPackedRounds}.Run();
+
+  result_stream << "\ntype,mode,values/s\n";
+  for (auto const& result : packed_results) {
+    Format(result_stream, "{}\n", result);
+  }
+  return 0;
+}
+}  // namespace ae::bench
+
+int main() { return ae::bench::serialization_bench(std::cout); }
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization_bench/packed_int_bench.h"
+
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <utility>
+
+#include "aether/mstream.h"
+#include "aether/packed_int.h"
+#include "aether/mstream_buffers.h"
+
+namespace ae::bench {
+namespace {
+using PackedSize = Packed<std::uint64_t, std::uint8_t, 250>;
+using PackedIndex = Packed<std::uint32_t, std::uint8_t, 250>;
+
+double PerSecond(std::size_t count,
+                 std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+}
+
+// 70% one byte, 25% two bytes and 5% four bytes values
+template <typename PInt>
+std::vector<PInt> MakeValues(std::size_t count) {
+  auto gen = std::mt19937{42};
+  auto dis = std::uniform_int_distribution<std::uint32_t>{0, 99};
+  auto values = std::vector<PInt>{};
+  values.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto r = dis(gen);
+    if (r < 70) {
+      values.emplace_back(r);
+    } else if (r < 95) {
+      values.emplace_back(251 + r * 12);
+    } else {
+      values.emplace_back(100000 + r);
+    }
+  }
+  return values;
+}
+
+template <typename TFunc>
+PackedIntResult Measure(std::string type, std::string mode,
+                        std::size_t value_count, std::size_t round_count,
+                        TFunc&& run) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < round_count; ++i) {
+    run();
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return PackedIntResult{std::move(type), std::move(mode),
+                         PerSecond(value_count * round_count, duration)};
+}
+
+template <typename PInt>
+void RunType(std::vector<PackedIntResult>& results, std::string const& type,
+             std::size_t value_count, std::size_t round_count) {
+  auto values = MakeValues<PInt>(value_count);
+
+  auto stream_data = std::vector<std::uint8_t>{};
+  stream_data.reserve(value_count * PInt::kMaxSize);
+  results.emplace_back(
+      Measure(type, "encode stream", value_count, round_count, [&]() {
+        stream_data.clear();
+        auto writer = VectorWriter<PackedSize>{stream_data};
+        auto os = omstream{writer};
+        for (auto const& v : values) {
+          v.Serialize(os);
+        }
+      }));
+
+  auto data = std::vector<std::uint8_t>(value_count * PInt::kMaxSize);
+  std::size_t size = 0;
+  results.emplace_back(
+      Measure(type, "encode codec", value_count, round_count, [&]() {
+        size = 0;
+        for (auto const& v : values) {
+          size += v.Encode(data.data() + size);
+        }
+      }));
+  data.resize(size);
+
+  auto decoded = std::vector<PInt>(value_count);
+  results.emplace_back(
+      Measure(type, "decode stream", value_count, round_count, [&]() {
+        auto reader = VectorReader<PackedSize>{data};
+        auto is = imstream{reader};
+        for (auto& v : decoded) {
+          v.Deserialize(is);
+        }
+      }));
+  results.emplace_back(
+      Measure(type, "decode codec", value_count, round_count, [&]() {
+        std::size_t offset = 0;
+        for (auto& v : decoded) {
+          offset += v.Decode(data.data() + offset, data.size() - offset);
+        }
+      }));
+}
+}  // namespace
+
+PackedIntRate::PackedIntRate(std::size_t value_count,
+                             std::size_t round_count)
+    : value_count_{value_count}, round_count_{round_count} {}
+
+std::vector<PackedIntResult> PackedIntRate::Run() {
+  std::vector<PackedIntResult> results;
+  RunType<PackedSize>(results, "PackedSize", value_count_, round_count_);
+  RunType<PackedIndex>(results, "PackedIndex", value_count_, round_count_);
+  return results;
+}
+}  // namespace ae::bench
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SERIALIZATION_BENCH_PACKED_INT_BENCH_H_
+#define EXAMPLES_BENCHES_SERIALIZATION_BENCH_PACKED_INT_BENCH_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct PackedIntResult {
+  std::string type;
+  std::string mode;  //< stream or codec, encode or decode
+  double values_per_second;
+};
+
+/**
+ * \brief Measures Packed integers encoding and decoding.
+ * Stream mode goes range by range through Serialize and Deserialize, codec
+ * mode uses Encode and Decode on contiguous memory. Values are mostly one
+ * byte with some two and four bytes ones.
+ */
+class PackedIntRate {
+ public:
+  PackedIntRate(std::size_t value_count, std::size_t round_count);
+
+  std::vector<PackedIntResult> Run();
+
+ private:
+  std::size_t value_count_;
+  std::size_t round_count_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::PackedIntResult> {
+  static void Print(std::ostream& s, bench::PackedIntResult const& r) {
+    s << r.type << "," << r.mode << "," << r.values_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SERIALIZATION_BENCH_PACKED_INT_BENCH_H_
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization_bench/packet_receive_bench.h"
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "aether/mstream_buffers.h"
+#include "aether/transport/data_buffer_pool.h"
+#include "aether/transport/low_level/tcp/data_packet_collector.h"
+
+#include "test_utils/alloc_counter.h"
+
+namespace ae::bench {
+namespace {
+constexpr std::size_t kReadSize = 1400;
+
+std::vector<std::uint8_t> MakeStream(std::size_t packet_count) {
+  auto stream = std::vector<std::uint8_t>{};
+  for (std::size_t i = 0; i < packet_count; ++i) {
+    AppendSerialized<PacketSize>(
+        stream, std::vector<std::uint8_t>(100 + (i % 10) * 100, 0x55));
+  }
+  return stream;
+}
+
+// receives the stream round_count times after a warm up round
+template <typename TReceive>
+PacketReceiveResult Measure(std::string mode, std::size_t packet_count,
+                            std::size_t round_count, TReceive&& receive) {
+  receive();
+  auto allocations = AllocationCount();
+  std::size_t packets = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < round_count; ++i) {
+    packets += receive();
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  allocations = AllocationCount() - allocations;
+
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  auto expected = static_cast<double>(packet_count * round_count);
+  return PacketReceiveResult{
+      std::move(mode),
+      seconds > 0 ? static_cast<double>(packets) / seconds : 0,
+      static_cast<double>(allocations) / expected};
+}
+}  // namespace
+
+PacketReceiveRate::PacketReceiveRate(std::size_t packet_count,
+                                     std::size_t round_count)
+    : packet_count_{packet_count}, round_count_{round_count} {}
+
+std::vector<PacketReceiveResult> PacketReceiveRate::Run() {
+  std::vector<PacketReceiveResult> results;
+  auto stream = MakeStream(packet_count_);
+
+  auto allocated_collector = StreamDataPacketCollector{};
+  results.emplace_back(
+      Measure("allocated", packet_count_, round_count_, [&]() {
+        std::size_t received = 0;
+        for (std::size_t offset = 0; offset < stream.size();
+             offset += kReadSize) {
+          auto size = std::min(kReadSize, stream.size() - offset);
+          auto data = DataBuffer{stream.data() + offset,
+                                 stream.data() + offset + size};
+          allocated_collector.AddData(data);
+          for (auto packet = allocated_collector.PopPacket(); !packet.empty();
+               packet = allocated_collector.PopPacket()) {
+            // not returned to the pool
+            std::move(packet).Release();
+            ++received;
+          }
+        }
+        return received;
+      }));
+
+  auto pooled_collector = StreamDataPacketCollector{};
+  results.emplace_back(Measure("pooled", packet_count_, round_count_, [&]() {
+    std::size_t received = 0;
+    for (std::size_t offset = 0; offset < stream.size(); offset += kReadSize) {
+      auto size = std::min(kReadSize, stream.size() - offset);
+      // the same as UnixTcpTransport reads the socket
+      auto data = PooledDataBuffer{GetDataBuffer(size)};
+      data->assign(stream.data() + offset, stream.data() + offset + size);
+      pooled_collector.AddData(*data);
+      for (auto packet = pooled_collector.PopPacket(); !packet.empty();
+           packet = pooled_collector.PopPacket()) {
+        ++received;
+      }
+    }
+    return received;
+  }));
+  return results;
+}
+}  // namespace ae::bench
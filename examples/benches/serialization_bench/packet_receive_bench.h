@@ -0,0 +1,62 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SERIALIZATION_BENCH_PACKET_RECEIVE_BENCH_H_
+#define EXAMPLES_BENCHES_SERIALIZATION_BENCH_PACKET_RECEIVE_BENCH_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct PacketReceiveResult {
+  std::string mode;  //< read and packet buffers allocated or pooled
+  double packets_per_second;
+  double allocations_per_packet;
+};
+
+/**
+ * \brief Measures stream packets collection from socket sized reads.
+ * Packets of 100..1000 bytes are read in 1400 bytes parts as UnixTcpTransport
+ * does. Allocated mode makes a new buffer for each read and drops popped
+ * packets, pooled mode takes and recycles both through DataBufferPool.
+ */
+class PacketReceiveRate {
+ public:
+  PacketReceiveRate(std::size_t packet_count, std::size_t round_count);
+
+  std::vector<PacketReceiveResult> Run();
+
+ private:
+  std::size_t packet_count_;
+  std::size_t round_count_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::PacketReceiveResult> {
+  static void Print(std::ostream& s, bench::PacketReceiveResult const& r) {
+    s << r.mode << "," << r.packets_per_second << ","
+      << r.allocations_per_packet;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SERIALIZATION_BENCH_PACKET_RECEIVE_BENCH_H_
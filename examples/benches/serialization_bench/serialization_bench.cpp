@@ -0,0 +1,274 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization_bench/serialization_bench.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "aether/uid.h"
+#include "aether/mstream.h"
+#include "aether/data_view.h"
+#include "aether/mstream_buffers.h"
+#include "aether/api_protocol/api_message.h"
+#include "aether/api_protocol/send_result.h"
+#include "aether/methods/uid_and_cloud.h"
+#include "aether/methods/server_descriptor.h"
+#include "aether/methods/client_api/client_safe_api.h"
+#include "aether/methods/work_server_api/authorized_api.h"
+
+namespace ae::bench {
+namespace {
+double PerSecond(std::size_t count,
+                 std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration<double>{duration}.count();
+  return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+}
+
+template <typename TFunc>
+SerializationResult Measure(std::string message, std::string mode,
+                            std::size_t message_count, TFunc&& serialize) {
+  // bytes of all messages keep the result observable
+  std::size_t bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < message_count; ++i) {
+    bytes += serialize();
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return SerializationResult{std::move(message), std::move(mode),
+                             message_count > 0 ? bytes / message_count : 0,
+                             PerSecond(message_count, duration)};
+}
+
+template <typename TMessage>
+void RunMessage(std::vector<SerializationResult>& results,
+                std::string const& name, TMessage const& message,
+                std::size_t message_count) {
+  results.emplace_back(Measure(name, "vector writer", message_count, [&]() {
+    auto buffer = std::vector<std::uint8_t>{};
+    auto writer = VectorWriter<PackedSize>{buffer};
+    auto os = omstream{writer};
+    os << message;
+    return buffer.size();
+  }));
+  results.emplace_back(Measure(name, "two pass", message_count, [&]() {
+    auto buffer = std::vector<std::uint8_t>{};
+    AppendSerialized<PackedSize>(buffer, message);
+    return buffer.size();
+  }));
+}
+
+// message nested into a send result style message with a size prefix
+template <typename TMessage>
+void RunNested(std::vector<SerializationResult>& results,
+               std::string const& name, TMessage const& message,
+               std::size_t message_count) {
+  auto request_id = RequestId{1};
+  results.emplace_back(
+      Measure(name, "nested temp buffer", message_count, [&]() {
+        auto nested = std::vector<std::uint8_t>{};
+        {
+          auto writer = VectorWriter<PackedSize>{nested};
+          auto os = omstream{writer};
+          os << message;
+        }
+        auto buffer = std::vector<std::uint8_t>{};
+        auto writer = VectorWriter<PackedSize>{buffer};
+        auto os = omstream{writer};
+        os << request_id << nested;
+        return buffer.size();
+      }));
+  results.emplace_back(
+      Measure(name, "nested sized field", message_count, [&]() {
+        auto buffer = std::vector<std::uint8_t>{};
+        AppendSerialized<PackedSize>(buffer, request_id, WithSize(message));
+        return buffer.size();
+      }));
+}
+
+template <typename T>
+void WriteElements(std::vector<std::uint8_t>& buffer,
+                   std::vector<T> const& values) {
+  auto writer = VectorWriter<PackedSize>{buffer};
+  auto os = omstream{writer};
+  os << static_cast<PackedSize>(values.size());
+  for (auto const& v : values) {
+    os << v;
+  }
+}
+
+template <typename T>
+void ReadElements(std::vector<std::uint8_t> const& buffer,
+                  std::vector<T>& values) {
+  auto reader = VectorReader<PackedSize>{buffer};
+  auto is = imstream{reader};
+  PackedSize size{};
+  is >> size;
+  values.resize(static_cast<std::size_t>(size));
+  for (auto& v : values) {
+    is >> v;
+  }
+}
+
+template <typename T>
+void RunVector(std::vector<SerializationResult>& results,
+               std::string const& name, std::vector<T> const& values,
+               std::size_t message_count) {
+  results.emplace_back(
+      Measure(name, "encode per element", message_count, [&]() {
+        auto buffer = std::vector<std::uint8_t>{};
+        buffer.reserve(SerializedSize<PackedSize>(values));
+        WriteElements(buffer, values);
+        return buffer.size();
+      }));
+  results.emplace_back(Measure(name, "encode bulk", message_count, [&]() {
+    auto buffer = std::vector<std::uint8_t>{};
+    AppendSerialized<PackedSize>(buffer, values);
+    return buffer.size();
+  }));
+
+  auto encoded = std::vector<std::uint8_t>{};
+  AppendSerialized<PackedSize>(encoded, values);
+  auto decoded = std::vector<T>{};
+  results.emplace_back(
+      Measure(name, "decode per element", message_count, [&]() {
+        ReadElements(encoded, decoded);
+        return encoded.size();
+      }));
+  results.emplace_back(Measure(name, "decode bulk", message_count, [&]() {
+    auto reader = VectorReader<PackedSize>{encoded};
+    auto is = imstream{reader};
+    is >> decoded;
+    return encoded.size();
+  }));
+}
+
+// ClientSafeApi::SendMessage with the payload read into an owned buffer
+struct CopySendMessage {
+  template <typename T>
+  void Serializator(T& s) {
+    s & uid & data;
+  }
+
+  Uid uid;
+  DataBuffer data;
+};
+
+template <typename TMessage>
+SerializationResult MeasureReceive(std::string const& name, std::string mode,
+                                   std::vector<std::uint8_t> const& packet,
+                                   std::size_t message_count) {
+  return Measure(name, std::move(mode), message_count, [&]() {
+    auto reader = VectorReader<PackedSize>{packet};
+    auto is = imstream{reader};
+    auto message = TMessage{};
+    is >> message;
+    return message.data.size();
+  });
+}
+
+AuthorizedApi::SendMessage MakeSendMessage(std::size_t size) {
+  auto message = AuthorizedApi::SendMessage{};
+  message.request_id = RequestId{1};
+  message.uid = Uid{{1, 2, 3, 4}};
+  message.data = DataBuffer(size, 0x55);
+  return message;
+}
+
+ServerDescriptor MakeServerDescriptor() {
+  auto descriptor = ServerDescriptor{};
+  descriptor.server_id = 1;
+  for (std::uint8_t i = 0; i < 3; ++i) {
+    auto ip = IpAddressAndPort{};
+    ip.ip.version = IpAddress::Version::kIpV4;
+    ip.protocol_and_ports = {{Protocol::kTcp, 9010}, {Protocol::kTcp, 9011}};
+    descriptor.ips.emplace_back(std::move(ip));
+  }
+  return descriptor;
+}
+}  // namespace
+
+SerializationRate::SerializationRate(std::size_t message_count)
+    : message_count_{message_count} {}
+
+std::vector<SerializationResult> SerializationRate::Run() {
+  std::vector<SerializationResult> results;
+
+  auto open_stream = AuthorizedApi::OpenStreamToClient{};
+  open_stream.uid = Uid{{1, 2, 3, 4}};
+  open_stream.stream_id = 1;
+  RunMessage(results, "open stream to client", open_stream, message_count_);
+
+  auto uid_and_cloud = UidAndCloud{};
+  uid_and_cloud.uid = Uid{{1, 2, 3, 4}};
+  uid_and_cloud.cloud = {1, 2, 3, 4, 5};
+  RunMessage(results, "uid and cloud", uid_and_cloud, message_count_);
+
+  RunMessage(results, "server descriptor", MakeServerDescriptor(),
+             message_count_);
+
+  for (auto size : {std::size_t{16}, std::size_t{256}, std::size_t{1200}}) {
+    auto name = "send message " + std::to_string(size);
+    auto send_message = MakeSendMessage(size);
+    RunMessage(results, name, send_message, message_count_);
+    RunNested(results, name, send_message, message_count_);
+  }
+  return results;
+}
+
+std::vector<SerializationResult> SerializationRate::RunVectors(
+    std::size_t vector_size) {
+  std::vector<SerializationResult> results;
+
+  auto uids = std::vector<Uid>(vector_size);
+  for (std::size_t i = 0; i < uids.size(); ++i) {
+    uids[i].value[0] = static_cast<std::uint8_t>(i);
+  }
+  RunVector(results, "uids " + std::to_string(vector_size), uids,
+            message_count_);
+
+  using Key = std::array<std::uint8_t, 32>;
+  auto keys = std::vector<Key>(vector_size);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    keys[i][0] = static_cast<std::uint8_t>(i);
+  }
+  RunVector(results, "keys " + std::to_string(vector_size), keys,
+            message_count_);
+  return results;
+}
+
+std::vector<SerializationResult> SerializationRate::RunReceive(
+    std::vector<std::size_t> const& payload_sizes) {
+  std::vector<SerializationResult> results;
+
+  for (auto size : payload_sizes) {
+    auto message = ClientSafeApi::SendMessage{};
+    message.uid = Uid{{1, 2, 3, 4}};
+    message.data = DataView{DataBuffer(size, 0x55)};
+    auto packet = std::vector<std::uint8_t>{};
+    AppendSerialized<PackedSize>(packet, message);
+
+    auto name = "receive message " + std::to_string(size);
+    results.emplace_back(MeasureReceive<CopySendMessage>(
+        name, "decode copy", packet, message_count_));
+    results.emplace_back(MeasureReceive<ClientSafeApi::SendMessage>(
+        name, "decode view", packet, message_count_));
+  }
+  return results;
+}
+}  // namespace ae::bench
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXAMPLES_BENCHES_SERIALIZATION_BENCH_SERIALIZATION_BENCH_H_
+#define EXAMPLES_BENCHES_SERIALIZATION_BENCH_SERIALIZATION_BENCH_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+#include "aether/tele/ios.h"
+
+namespace ae::bench {
+struct SerializationResult {
+  std::string message;
+  std::string mode;  //< writer, nested field or vector encoding mode
+  std::size_t bytes;
+  double messages_per_second;
+};
+
+/**
+ * \brief Measures serialization of api messages into a new buffer.
+ * Vector writer grows the buffer on each write, two pass computes the size
+ * first and writes into a single allocation. Nested messages are written into
+ * a temporary buffer and copied or written in place as a sized field.
+ */
+class SerializationRate {
+ public:
+  explicit SerializationRate(std::size_t message_count);
+
+  std::vector<SerializationResult> Run();
+  /**
+   * \brief Large vectors of uids and keys, element by element or as a block.
+   */
+  std::vector<SerializationResult> RunVectors(std::size_t vector_size);
+  /**
+   * \brief Parse of received messages with large payloads, copied into an
+   * owned buffer or read as a view into the packet.
+   */
+  std::vector<SerializationResult> RunReceive(
+      std::vector<std::size_t> const& payload_sizes);
+
+ private:
+  std::size_t message_count_;
+};
+}  // namespace ae::bench
+
+namespace ae {
+template <>
+struct PrintToStream<bench::SerializationResult> {
+  static void Print(std::ostream& s, bench::SerializationResult const& r) {
+    s << r.message << "," << r.mode << "," << r.bytes << ","
+      << r.messages_per_second;
+  }
+};
+}  // namespace ae
+
+#endif  // EXAMPLES_BENCHES_SERIALIZATION_BENCH_SERIALIZATION_BENCH_H_
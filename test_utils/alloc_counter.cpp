@@ -0,0 +1,42 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test_utils/alloc_counter.h"
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+namespace ae {
+namespace {
+std::atomic<std::size_t> allocation_count{0};
+}
+
+std::size_t AllocationCount() { return allocation_count.load(); }
+}  // namespace ae
+
+void* operator new(std::size_t size) {
+  ae::allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (auto* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /* size */) noexcept {
+  std::free(ptr);
+}
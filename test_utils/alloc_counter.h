@@ -0,0 +1,29 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TEST_UTILS_ALLOC_COUNTER_H_
+#define TEST_UTILS_ALLOC_COUNTER_H_
+
+#include <cstddef>
+
+namespace ae {
+/**
+ * \brief Count of global operator new calls made by the executable.
+ */
+std::size_t AllocationCount();
+}  // namespace ae
+
+#endif  // TEST_UTILS_ALLOC_COUNTER_H_
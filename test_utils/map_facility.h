@@ -14,8 +14,8 @@
  * limitations under the License.
  */
 
-#ifndef TESTS_TEST_OBJECT_SYSTEM_MAP_FACILITY_H_
-#define TESTS_TEST_OBJECT_SYSTEM_MAP_FACILITY_H_
+#ifndef TEST_UTILS_MAP_FACILITY_H_
+#define TEST_UTILS_MAP_FACILITY_H_
 
 #include <unordered_map>
 #include <vector>
@@ -60,4 +60,4 @@ class MapFacility : public IDomainFacility {
 };
 }  // namespace ae
 
-#endif  // TESTS_TEST_OBJECT_SYSTEM_MAP_FACILITY_H_ */
+#endif  // TEST_UTILS_MAP_FACILITY_H_ */
@@ -14,8 +14,8 @@
  * limitations under the License.
  */
 
-#ifndef TESTS_TEST_STREAM_CRYPTO_STREAM_MOCK_KEY_PROVIDER_H_
-#define TESTS_TEST_STREAM_CRYPTO_STREAM_MOCK_KEY_PROVIDER_H_
+#ifndef TEST_UTILS_MOCK_KEY_PROVIDER_H_
+#define TEST_UTILS_MOCK_KEY_PROVIDER_H_
 
 #include <utility>
 
@@ -53,4 +53,4 @@ class MockAsyncKeyProvider : public IAsyncKeyProvider {
 
 }  // namespace ae
 
-#endif  // TESTS_TEST_STREAM_CRYPTO_STREAM_MOCK_KEY_PROVIDER_H_
+#endif  // TEST_UTILS_MOCK_KEY_PROVIDER_H_
@@ -0,0 +1,274 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TEST_UTILS_SIM_LINK_H_
+#define TEST_UTILS_SIM_LINK_H_
+
+#include <deque>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "aether/common.h"
+#include "aether/actions/action.h"
+#include "aether/actions/action_list.h"
+#include "aether/actions/action_context.h"
+#include "aether/stream_api/istream.h"
+
+namespace ae {
+struct LinkProfile {
+  std::string name;
+  std::uint64_t bandwidth;  //< link rate in bytes per second
+  Duration delay;           //< one way propagation delay
+  std::size_t mtu;          //< max packet size reported to the stream
+  double loss;              //< probability to lose a packet
+  std::size_t queue_limit = 0;  //< bytes queued before drop, 0 is unlimited
+  Duration jitter = {};         //< max random extra delay
+  double reorder = 0;    //< probability to delay a packet by one more delay
+  double duplicate = 0;  //< probability to deliver a packet twice
+};
+
+class SimWriteAction final : public StreamWriteAction {
+ public:
+  explicit SimWriteAction(ActionContext action_context)
+      : StreamWriteAction{action_context} {
+    state_.Set(State::kDone);
+  }
+
+  TimePoint Update(TimePoint current_time) override {
+    if (state_.changed()) {
+      switch (state_.Acquire()) {
+        case State::kDone:
+          Action::Result(*this);
+          break;
+        case State::kStopped:
+          Action::Stop(*this);
+          break;
+        default:
+          break;
+      }
+    }
+    return current_time;
+  }
+
+  void Stop() override { state_.Set(State::kStopped); }
+};
+
+/**
+ * \brief Simulated network link between two byte gates.
+ * Each direction serializes packets with the link rate and delivers them after
+ * the propagation delay and random jitter. With queue_limit packets are
+ * dropped when the bytes waiting for serialization exceed it, like on a
+ * constrained uplink. Packets are lost, reordered and duplicated randomly with
+ * the profile probabilities, the random generator is seeded so runs are
+ * repeatable. Time is taken from the action processor, so the link may be
+ * driven by a virtual clock.
+ */
+class SimLink final : public Action<SimLink> {
+ public:
+  class Endpoint final : public ByteGate {
+    friend class SimLink;
+
+   public:
+    Endpoint(ActionContext action_context, SimLink& link)
+        : link_{&link}, write_actions_{action_context} {}
+
+    ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                        TimePoint current_time) override {
+      link_->Send(*this, std::move(buffer), current_time);
+      return write_actions_.Emplace();
+    }
+
+    StreamInfo stream_info() const override {
+      return StreamInfo{link_->profile().mtu, link_->linked(), true, true};
+    }
+
+   private:
+    void Deliver(DataBuffer const& buffer) { out_data_event_.Emit(buffer); }
+    void LinkUpdate() { gate_update_event_.Emit(); }
+
+    SimLink* link_;
+    ActionList<SimWriteAction> write_actions_;
+  };
+
+  SimLink(ActionContext action_context, LinkProfile profile,
+          std::uint32_t seed = 1)
+      : Action{action_context},
+        profile_{std::move(profile)},
+        left_{action_context, *this},
+        right_{action_context, *this},
+        left_to_right_{&right_, {}, {}},
+        right_to_left_{&left_, {}, {}},
+        random_{seed},
+        loss_{profile_.loss},
+        reorder_{profile_.reorder},
+        duplicate_{profile_.duplicate},
+        jitter_{0, profile_.jitter.count()} {}
+
+  AE_CLASS_NO_COPY_MOVE(SimLink)
+
+  TimePoint Update(TimePoint current_time) override {
+    auto left_next = DeliverArrived(left_to_right_, current_time);
+    auto right_next = DeliverArrived(right_to_left_, current_time);
+    if (left_next == current_time) {
+      return right_next;
+    }
+    if (right_next == current_time) {
+      return left_next;
+    }
+    return std::min(left_next, right_next);
+  }
+
+  Endpoint& left() { return left_; }
+  Endpoint& right() { return right_; }
+
+  /**
+   * \brief Bring the link down or up like a transport reset.
+   * Packets in flight are lost when the link goes down and packets written
+   * while it is down are dropped.
+   */
+  void set_linked(bool linked) {
+    linked_ = linked;
+    if (!linked_) {
+      left_to_right_.packets.clear();
+      right_to_left_.packets.clear();
+    }
+    left_.LinkUpdate();
+    right_.LinkUpdate();
+  }
+
+  bool linked() const { return linked_; }
+  LinkProfile const& profile() const { return profile_; }
+  std::size_t sent_packets() const { return sent_packets_; }
+  std::size_t sent_bytes() const { return sent_bytes_; }
+  std::size_t lost_packets() const { return lost_packets_; }
+  std::size_t dropped_packets() const { return dropped_packets_; }
+  std::size_t reordered_packets() const { return reordered_packets_; }
+  std::size_t duplicated_packets() const { return duplicated_packets_; }
+
+ private:
+  struct Packet {
+    TimePoint arrive_time;
+    DataBuffer data;
+  };
+
+  struct Direction {
+    Endpoint* to;
+    TimePoint free_time;
+    // sorted by arrive time
+    std::deque<Packet> packets;
+  };
+
+  void Send(Endpoint const& from, DataBuffer&& data, TimePoint current_time) {
+    auto& direction = (&from == &left_) ? left_to_right_ : right_to_left_;
+
+    if (!linked_) {
+      return;
+    }
+    sent_packets_ += 1;
+    sent_bytes_ += data.size();
+
+    if ((profile_.queue_limit != 0) && (direction.free_time > current_time)) {
+      auto queued_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          direction.free_time - current_time);
+      auto queued_bytes = static_cast<std::size_t>(
+          static_cast<std::uint64_t>(queued_time.count()) *
+          profile_.bandwidth / 1'000'000'000);
+      if ((queued_bytes + data.size()) > profile_.queue_limit) {
+        // drop tail
+        dropped_packets_ += 1;
+        return;
+      }
+    }
+
+    // serialize the packet after all previous ones in the same direction
+    auto transmit_time = std::chrono::nanoseconds{static_cast<std::int64_t>(
+        data.size() * 1'000'000'000 / profile_.bandwidth)};
+    auto start_time = std::max(current_time, direction.free_time);
+    direction.free_time =
+        start_time +
+        std::chrono::duration_cast<TimePoint::duration>(transmit_time);
+
+    // lost packet still takes the link time
+    if (loss_(random_)) {
+      lost_packets_ += 1;
+      return;
+    }
+
+    auto arrive_time = direction.free_time + profile_.delay +
+                       Duration{jitter_(random_)};
+    if (reorder_(random_)) {
+      // the next packets overtake this one
+      reordered_packets_ += 1;
+      arrive_time += profile_.delay;
+    }
+    if (duplicate_(random_)) {
+      duplicated_packets_ += 1;
+      Push(direction, Packet{arrive_time + Duration{jitter_(random_)}, data});
+    }
+    Push(direction, Packet{arrive_time, std::move(data)});
+    Action::Trigger();
+  }
+
+  static void Push(Direction& direction, Packet&& packet) {
+    auto it = std::upper_bound(
+        std::begin(direction.packets), std::end(direction.packets),
+        packet.arrive_time,
+        [](auto const& time, auto const& p) { return time < p.arrive_time; });
+    direction.packets.insert(it, std::move(packet));
+  }
+
+  static TimePoint DeliverArrived(Direction& direction,
+                                  TimePoint current_time) {
+    while (!direction.packets.empty() &&
+           (direction.packets.front().arrive_time <= current_time)) {
+      auto packet = std::move(direction.packets.front());
+      direction.packets.pop_front();
+      direction.to->Deliver(packet.data);
+    }
+    if (direction.packets.empty()) {
+      return current_time;
+    }
+    return direction.packets.front().arrive_time;
+  }
+
+  LinkProfile profile_;
+  Endpoint left_;
+  Endpoint right_;
+  Direction left_to_right_;
+  Direction right_to_left_;
+  std::minstd_rand random_;
+  std::bernoulli_distribution loss_;
+  std::bernoulli_distribution reorder_;
+  std::bernoulli_distribution duplicate_;
+  std::uniform_int_distribution<Duration::rep> jitter_;
+  bool linked_{true};
+  std::size_t sent_packets_{};
+  std::size_t sent_bytes_{};
+  std::size_t lost_packets_{};
+  std::size_t dropped_packets_{};
+  std::size_t reordered_packets_{};
+  std::size_t duplicated_packets_{};
+};
+
+}  // namespace ae
+
+#endif  // TEST_UTILS_SIM_LINK_H_
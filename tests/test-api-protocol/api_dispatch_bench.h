@@ -0,0 +1,68 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TESTS_TEST_API_PROTOCOL_API_DISPATCH_BENCH_H_
+#define TESTS_TEST_API_PROTOCOL_API_DISPATCH_BENCH_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/api_dispatch.h"
+
+namespace ae {
+template <MessageId Code>
+struct BenchMessage : public Message<BenchMessage<Code>> {
+  static constexpr std::uint32_t kMessageId = 100 + Code;
+
+  std::uint32_t value_;
+
+  template <typename T>
+  void Serializator(T& s) {
+    s & value_;
+  }
+};
+
+class BenchApiBase : public ApiClass {
+ public:
+  template <MessageId Code>
+  void Execute(BenchMessage<Code>&& message, ApiParser& parser) {
+    parser.Context().MessageNotify(std::move(message));
+  }
+
+  template <MessageId Code>
+  void Pack(BenchMessage<Code>&& message, ApiPacker& packer) {
+    packer.Pack(Code, std::move(message));
+  }
+};
+
+class BenchTableApi : public BenchApiBase {
+ public:
+  static constexpr auto kClassId = 11;
+
+  using Messages = ApiMessageList<
+      ApiMessageCode<0, BenchMessage<0>>, ApiMessageCode<1, BenchMessage<1>>,
+      ApiMessageCode<2, BenchMessage<2>>, ApiMessageCode<3, BenchMessage<3>>,
+      ApiMessageCode<4, BenchMessage<4>>, ApiMessageCode<5, BenchMessage<5>>,
+      ApiMessageCode<6, BenchMessage<6>>, ApiMessageCode<7, BenchMessage<7>>>;
+
+  void LoadFactory(MessageId code, ApiParser& parser) override {
+    DispatchLoad(*this, code, parser);
+  }
+};
+}  // namespace ae
+
+#endif  // TESTS_TEST_API_PROTOCOL_API_DISPATCH_BENCH_H_
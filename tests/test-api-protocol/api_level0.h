@@ -24,6 +24,7 @@
 #include <iostream>
 
 #include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/api_dispatch.h"
 #include "aether/crc.h"
 
 #include "api_level1.h"
@@ -66,21 +67,13 @@ class ApiLevel0 : public ApiClass {
     }
   };
 
+  using Messages = ApiMessageList<ApiMessageCode<1, Message1>,
+                                  ApiMessageCode<2, Message2>,
+                                  ApiMessageCode<3, Message3>>;
+
   // for server
   void LoadFactory(MessageId code, ApiParser& parser) override {
-    switch (code) {
-      case 1:
-        parser.Load<Message1>(*this);
-        break;
-      case 2:
-        parser.Load<Message2>(*this);
-        break;
-      case 3:
-        parser.Load<Message3>(*this);
-        break;
-      default:
-        break;
-    }
+    DispatchLoad(*this, code, parser);
   }
 
   void Execute(Message1&& message, ApiParser& parser) {
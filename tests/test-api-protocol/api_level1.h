@@ -23,6 +23,7 @@
 #include <iostream>
 
 #include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/api_dispatch.h"
 #include "aether/crc.h"
 
 namespace ae {
@@ -54,18 +55,12 @@ class ApiLevel1 : public ApiClass {
     }
   };
 
+  using Messages = ApiMessageList<ApiMessageCode<1, Message1>,
+                                  ApiMessageCode<2, Message2>>;
+
   // for server
   void LoadFactory(MessageId code, ApiParser& parser) override {
-    switch (code) {
-      case 1:
-        parser.Load<Message1>(*this);
-        break;
-      case 2:
-        parser.Load<Message2>(*this);
-        break;
-      default:
-        break;
-    }
+    DispatchLoad(*this, code, parser);
   }
 
   void Execute(Message1 message, ApiParser& parser) {
@@ -21,6 +21,7 @@
 #include <utility>
 
 #include "aether/api_protocol/api_protocol.h"
+#include "aether/api_protocol/api_dispatch.h"
 #include "aether/api_protocol/send_result.h"
 
 namespace ae {
@@ -48,18 +49,14 @@ class ApiWithResult : public ApiClass, public ReturnResultApi {
     std::string message_;
   };
 
+  using Messages = ApiMessageList<ApiMessageCode<2, RequestEcho>>;
+
   void LoadFactory(MessageId message_id, ApiParser &parser) override {
     if (ReturnResultApi::LoadResult(message_id, parser)) {
       return;
     }
-    switch (message_id) {
-      case 2:
-        parser.Load<RequestEcho>(*this);
-        break;
-      default:
-        assert(false);
-        break;
-    }
+    [[maybe_unused]] auto loaded = DispatchLoad(*this, message_id, parser);
+    assert(loaded);
   }
 
   void Execute(RequestEcho &&request, ApiParser &parser) {
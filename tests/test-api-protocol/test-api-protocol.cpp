@@ -15,6 +15,8 @@
  */
 
 #include <unity.h>
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 
 #include "aether/api_protocol/api_message.h"
@@ -23,9 +25,14 @@
 #include "aether/api_protocol/packet_builder.h"
 
 #include "aether/api_protocol/send_result.h"
+#include "aether/api_protocol/send_result_table.h"
 #include "aether/transport/low_level/tcp/data_packet_collector.h"
+#include "aether/stream_api/stream_api.h"
+#include "aether/methods/work_server_api/authorized_api.h"
+#include "test_utils/alloc_counter.h"
 #include "api_level0.h"
 #include "api_level1.h"
+#include "api_dispatch_bench.h"
 #include "assert_packet.h"
 #include "tests/test-api-protocol/api_with_result.h"
 
@@ -213,6 +220,386 @@ void test_ApiWithResult() {
     TEST_ASSERT(response_echo_received);
   }
 }
+void test_DispatchTable() {
+  ProtocolContext p_context{};
+  std::vector<std::uint8_t> pack_data;
+  {
+    auto packer = ApiPacker{p_context, pack_data};
+    packer.Pack(MessageId{7}, BenchMessage<7>{{}, 42});
+    // unknown code is not loaded
+    packer.Pack(MessageId{8}, BenchMessage<0>{{}, 0});
+  }
+
+  auto value = std::uint32_t{};
+  auto api_class = static_cast<BenchTableApi const*>(nullptr);
+  auto _ = p_context.OnMessage<BenchMessage<7>>([&](auto const& event) {
+    value = event.message().value_;
+    api_class = event.template GetApiClass<BenchTableApi>();
+  });
+
+  auto root = BenchTableApi{};
+  auto parser = ApiParser{p_context, pack_data};
+  parser.Parse(root);
+
+  TEST_ASSERT_EQUAL(42, value);
+  TEST_ASSERT_EQUAL_PTR(&root, api_class);
+}
+
+template <MessageId... Codes>
+auto SubscribeBenchMessages(ProtocolContext& p_context, std::size_t& received,
+                            std::integer_sequence<MessageId, Codes...>) {
+  return std::array{p_context.OnMessage<BenchMessage<Codes>>(
+      [&](auto const&) { ++received; })...};
+}
+
+void test_ParseDispatchAllCodes() {
+  static constexpr std::size_t kMessagesInPacket = 64;
+
+  ProtocolContext p_context{};
+  std::vector<std::uint8_t> pack_data;
+  {
+    auto packer = ApiPacker{p_context, pack_data};
+    for (std::size_t i = 0; i < kMessagesInPacket; i += 8) {
+      packer.Pack(MessageId{0}, BenchMessage<0>{{}, 0});
+      packer.Pack(MessageId{1}, BenchMessage<1>{{}, 1});
+      packer.Pack(MessageId{2}, BenchMessage<2>{{}, 2});
+      packer.Pack(MessageId{3}, BenchMessage<3>{{}, 3});
+      packer.Pack(MessageId{4}, BenchMessage<4>{{}, 4});
+      packer.Pack(MessageId{5}, BenchMessage<5>{{}, 5});
+      packer.Pack(MessageId{6}, BenchMessage<6>{{}, 6});
+      packer.Pack(MessageId{7}, BenchMessage<7>{{}, 7});
+    }
+  }
+
+  std::size_t received = 0;
+  auto _ = SubscribeBenchMessages(p_context, received,
+                                  std::make_integer_sequence<MessageId, 8>{});
+
+  auto root = BenchTableApi{};
+  auto parser = ApiParser{p_context, pack_data};
+  parser.Parse(root);
+  TEST_ASSERT_EQUAL(kMessagesInPacket, received);
+}
+
+void test_PacketBuilderAllocations() {
+  static constexpr std::size_t kMessageSize = 100;
+
+  ProtocolContext p_context{};
+  auto buffer = std::vector<std::uint8_t>{};
+  buffer.reserve(1024);
+
+  auto send_message = [&](std::vector<std::uint8_t>&& packet_buffer) {
+    auto message = AuthorizedApi::SendMessage{
+        {}, RequestId{1}, Uid{}, DataBuffer(kMessageSize)};
+    auto allocations = AllocationCount();
+    auto packet = std::vector<std::uint8_t>{PacketBuilder{
+        p_context, std::move(packet_buffer),
+        PackMessage{AuthorizedApi{}, std::move(message)}}};
+    allocations = AllocationCount() - allocations;
+    return std::make_pair(std::move(packet), allocations);
+  };
+
+  auto new_packet = send_message({}).first;
+  auto [reused_packet, reused_allocations] = send_message(std::move(buffer));
+  TEST_ASSERT(new_packet == reused_packet);
+  // reused buffer has enough capacity
+  TEST_ASSERT_EQUAL(0, reused_allocations);
+
+  // nested child data is packed in place, only the pack message is allocated
+  auto nested_message = AuthorizedApi::SendMessage{
+      {}, RequestId{1}, Uid{}, DataBuffer(kMessageSize)};
+  auto nested_buffer = std::move(reused_packet);
+  auto nested_allocations = AllocationCount();
+  auto nested_packet = std::vector<std::uint8_t>{PacketBuilder{
+      p_context, std::move(nested_buffer),
+      PackMessage{StreamApi{},
+                  StreamApi::Stream{
+                      {},
+                      StreamId{1},
+                      PackMessage{AuthorizedApi{}, std::move(nested_message)},
+                  }}}};
+  nested_allocations = AllocationCount() - nested_allocations;
+  TEST_ASSERT_EQUAL(1, nested_allocations);
+
+  AssertPacket(nested_packet, MessageId{StreamApi::Stream::kMessageCode},
+               StreamId{1}, new_packet);
+}
+void test_ChildDataSizePrefix() {
+  ProtocolContext p_context{};
+  // sizes for 1, 2 and 4 bytes PackedSize prefix
+  for (std::size_t message_size : {100, 1000, 70'000}) {
+    auto make_message = [&]() {
+      return AuthorizedApi::SendMessage{{}, RequestId{1}, Uid{},
+                                        DataBuffer(message_size)};
+    };
+    auto packet = std::vector<std::uint8_t>{PacketBuilder{
+        p_context, PackMessage{AuthorizedApi{}, make_message()}}};
+    auto nested_packet = std::vector<std::uint8_t>{PacketBuilder{
+        p_context,
+        PackMessage{StreamApi{},
+                    StreamApi::Stream{
+                        {},
+                        StreamId{1},
+                        PackMessage{AuthorizedApi{}, make_message()},
+                    }}}};
+    AssertPacket(nested_packet, MessageId{StreamApi::Stream::kMessageCode},
+                 StreamId{1}, packet);
+  }
+}
+
+void test_NestedChildDataParse() {
+  static constexpr std::size_t kPackets = 100;
+  static constexpr StreamId kDepth = 3;
+
+  ProtocolContext p_context{};
+  // stream in stream in stream with bench messages inside
+  auto child = ChildData{PacketBuilder{
+      p_context,
+      PackMessage{BenchTableApi{}, BenchMessage<0>{{}, 1},
+                  BenchMessage<1>{{}, 2}},
+  }};
+  for (StreamId i = kDepth; i > 0; --i) {
+    child = ChildData{PacketBuilder{
+        p_context, PackMessage{StreamApi{}, StreamApi::Stream{
+                                                {}, StreamId(i - 1),
+                                                std::move(child)}}}};
+  }
+  auto const& pack_data = child.CopyData();
+
+  std::size_t received = 0;
+  std::size_t views = 0;
+  auto _0 = SubscribeBenchMessages(p_context, received,
+                                   std::make_integer_sequence<MessageId, 2>{});
+  auto _1 = p_context.OnMessage<StreamApi::Stream>([&](auto const& event) {
+    auto const& message = event.message();
+    // nested data is parsed in place, not copied on each level
+    if (message.child_data.is_view()) {
+      ++views;
+    }
+    auto parser = ApiParser{p_context, message.child_data};
+    if (message.stream_id + 1 < kDepth) {
+      auto api = StreamApi{};
+      parser.Parse(api);
+    } else {
+      auto api = BenchTableApi{};
+      parser.Parse(api);
+    }
+  });
+
+  for (std::size_t i = 0; i < kPackets; ++i) {
+    auto root = StreamApi{};
+    auto parser = ApiParser{p_context, pack_data};
+    parser.Parse(root);
+  }
+
+  TEST_ASSERT_EQUAL(kPackets * 2, received);
+  TEST_ASSERT_EQUAL(kPackets * kDepth, views);
+}
+
+void test_ChildDataMoveOutOfPacket() {
+  ProtocolContext p_context{};
+  auto child_packet = std::vector<std::uint8_t>{PacketBuilder{
+      p_context, PackMessage{BenchTableApi{}, BenchMessage<0>{{}, 1}}}};
+  // child data has the same layout as a vector
+  auto packet = std::vector<std::uint8_t>(PackedSize::kMaxSize);
+  packet.resize(PackedSize{child_packet.size()}.Encode(packet.data()));
+  packet.insert(packet.end(), child_packet.begin(), child_packet.end());
+
+  ChildData moved;
+  ChildData copied;
+  {
+    auto parser = ApiParser{p_context, packet};
+    auto child_data = parser.Extract<ChildData>();
+    TEST_ASSERT(child_data.is_view());
+    copied = child_data;
+    moved = std::move(child_data);
+  }
+  // the parent packet is gone, moved and copied data are still valid
+  std::fill(packet.begin(), packet.end(), std::uint8_t{0});
+  packet = {};
+
+  TEST_ASSERT_FALSE(moved.is_view());
+  TEST_ASSERT_FALSE(copied.is_view());
+  TEST_ASSERT(moved.CopyData() == child_packet);
+  TEST_ASSERT(copied.CopyData() == child_packet);
+}
+
+void test_NestedDepthLimit() {
+  static constexpr StreamId kDepth = ApiClassStack::kMaxDepth + 4;
+
+  ProtocolContext p_context{};
+  auto child = ChildData{PacketBuilder{
+      p_context,
+      PackMessage{BenchTableApi{}, BenchMessage<0>{{}, 1}},
+  }};
+  for (StreamId i = kDepth; i > 0; --i) {
+    child = ChildData{PacketBuilder{
+        p_context, PackMessage{StreamApi{}, StreamApi::Stream{
+                                                {}, StreamId(i - 1),
+                                                std::move(child)}}}};
+  }
+  auto const& pack_data = child.CopyData();
+
+  std::size_t received = 0;
+  std::size_t streams = 0;
+  auto _0 = SubscribeBenchMessages(p_context, received,
+                                   std::make_integer_sequence<MessageId, 1>{});
+  auto _1 = p_context.OnMessage<StreamApi::Stream>([&](auto const& event) {
+    ++streams;
+    auto parser = ApiParser{p_context, event.message().child_data};
+    auto api = StreamApi{};
+    parser.Parse(api);
+  });
+
+  auto root = StreamApi{};
+  auto parser = ApiParser{p_context, pack_data};
+  parser.Parse(root);
+
+  // too deep data is not parsed
+  TEST_ASSERT_EQUAL(ApiClassStack::kMaxDepth, streams);
+  TEST_ASSERT_EQUAL(0, received);
+}
+
+void test_SendResultExpiry() {
+  auto start = TimePoint{};
+  auto table = SendResultTable{4, 4, std::chrono::seconds{1}};
+
+  int results = 0;
+  int errors = 0;
+  auto last_error = std::uint32_t{};
+  auto on_error = [&](std::uint32_t error_code) {
+    ++errors;
+    last_error = error_code;
+  };
+  auto add = [&](std::uint16_t id, TimePoint time) {
+    table.Add(id, [&](ApiParser&) { ++results; }, on_error, time);
+  };
+  add(1, start);
+  add(2, start + std::chrono::milliseconds{500});
+  TEST_ASSERT_EQUAL(2, table.size());
+
+  // nothing expired yet
+  auto next = table.Expire(start + std::chrono::milliseconds{999});
+  TEST_ASSERT(next == start + std::chrono::seconds{1});
+  TEST_ASSERT_EQUAL(0, errors);
+
+  next = table.Expire(start + std::chrono::seconds{1});
+  TEST_ASSERT_EQUAL(1, errors);
+  TEST_ASSERT_EQUAL(SendResultTable::kTimeoutError, last_error);
+  TEST_ASSERT_EQUAL(1, table.size());
+  TEST_ASSERT(next == start + std::chrono::milliseconds{1500});
+  // late response to the expired request is not matched
+  TEST_ASSERT(!table.TakeResult(1));
+
+  // expiration is also checked on each new request
+  add(3, start + std::chrono::seconds{2});
+  TEST_ASSERT_EQUAL(2, errors);
+  TEST_ASSERT_EQUAL(1, table.size());
+  TEST_ASSERT(table.TakeResult(3));
+  TEST_ASSERT_EQUAL(0, table.size());
+  TEST_ASSERT_EQUAL(0, results);
+
+  // SendError fails the request too
+  auto p_context = ProtocolContext{4, 4, std::chrono::seconds{1}};
+  p_context.AddSendResultCallback(5, [&](ApiParser&) { ++results; }, on_error);
+  TEST_ASSERT(p_context.SetSendResultError(5, 42));
+  TEST_ASSERT_EQUAL(3, errors);
+  TEST_ASSERT_EQUAL(42, last_error);
+  // not handled without error callback
+  p_context.AddSendResultCallback(7, [&](ApiParser&) { ++results; });
+  TEST_ASSERT_FALSE(p_context.SetSendResultError(7, 42));
+  TEST_ASSERT_FALSE(p_context.SetSendResultError(5, 42));
+  p_context.AddSendResultCallback(6, [&](ApiParser&) { ++results; }, on_error);
+  p_context.ExpireSendResults(Now() + std::chrono::seconds{1});
+  TEST_ASSERT_EQUAL(4, errors);
+  TEST_ASSERT_EQUAL(SendResultTable::kTimeoutError, last_error);
+}
+
+void test_SendResultTableGrows() {
+  auto start = TimePoint{};
+  auto table = SendResultTable{2, 8, std::chrono::seconds{10}};
+
+  std::vector<std::uint16_t> failed;
+  auto add = [&](std::uint16_t id, int time) {
+    table.Add(
+        id, [](ApiParser&) {},
+        [&failed, id](std::uint32_t) { failed.push_back(id); },
+        start + std::chrono::seconds{time});
+  };
+  // ids 1 and 3 share the slot, 3 takes the next free one
+  add(1, 0);
+  add(3, 1);
+  TEST_ASSERT_EQUAL(2, table.size());
+  TEST_ASSERT(failed.empty());
+
+  // no live request is dropped, the table grows
+  add(4, 2);
+  add(6, 2);
+  TEST_ASSERT_EQUAL(4, table.size());
+  TEST_ASSERT_EQUAL(4, table.capacity());
+  add(8, 3);
+  TEST_ASSERT_EQUAL(8, table.capacity());
+  TEST_ASSERT(failed.empty());
+
+  // the table does not grow over max capacity, new requests fail at once
+  for (std::uint16_t id = 10; id < 13; ++id) {
+    add(id, 3);
+  }
+  TEST_ASSERT_EQUAL(8, table.size());
+  add(13, 3);
+  TEST_ASSERT_EQUAL(8, table.capacity());
+  TEST_ASSERT_EQUAL(8, table.size());
+  TEST_ASSERT_EQUAL(1, failed.size());
+  TEST_ASSERT_EQUAL(13, failed[0]);
+  TEST_ASSERT_FALSE(table.TakeResult(13));
+  // live requests are kept
+  for (std::uint16_t id = 10; id < 13; ++id) {
+    TEST_ASSERT(table.TakeResult(id));
+  }
+  failed.clear();
+
+  TEST_ASSERT(table.TakeResult(1));
+  TEST_ASSERT(table.TakeResult(3));
+  TEST_ASSERT(table.TakeResult(4));
+  TEST_ASSERT(table.TakeResult(6));
+  TEST_ASSERT(table.TakeResult(8));
+  TEST_ASSERT_EQUAL(0, table.size());
+
+  // the same id added again replaces the request
+  add(4, 3);
+  add(4, 4);
+  TEST_ASSERT_EQUAL(1, table.size());
+  TEST_ASSERT(failed.empty());
+
+  // all of them still expire
+  add(5, 4);
+  table.Expire(start + std::chrono::seconds{20});
+  TEST_ASSERT_EQUAL(0, table.size());
+  TEST_ASSERT_EQUAL(2, failed.size());
+}
+
+void test_SendResultSteadyState() {
+  static constexpr std::size_t kRequests = 100'000;
+  static constexpr std::size_t kInFlight = 16;
+
+  auto time = TimePoint{};
+  std::size_t results = 0;
+
+  // ids wrap around 16 bits, responses come in order with a fixed lag
+  auto table = SendResultTable{32, 32, std::chrono::seconds{30}};
+  for (std::size_t i = 0; i < kRequests; ++i) {
+    table.Add(static_cast<std::uint16_t>(i), [](ApiParser&) {}, {}, time);
+    if (i >= kInFlight) {
+      auto cb = table.TakeResult(static_cast<std::uint16_t>(i - kInFlight));
+      results += cb ? 1 : 0;
+    }
+  }
+
+  TEST_ASSERT_EQUAL(kRequests - kInFlight, results);
+  TEST_ASSERT_EQUAL(kInFlight, table.size());
+  // freed slots are reused, the table does not grow
+  TEST_ASSERT_EQUAL(32, table.capacity());
+}
 }  // namespace ae::test_api_protocol
 
 int main() {
@@ -220,5 +607,15 @@ int main() {
   RUN_TEST(ae::test_api_protocol::test_ApiLevel0_Message_1);
   RUN_TEST(ae::test_api_protocol::test_ApiLevel1);
   RUN_TEST(ae::test_api_protocol::test_ApiWithResult);
+  RUN_TEST(ae::test_api_protocol::test_DispatchTable);
+  RUN_TEST(ae::test_api_protocol::test_ParseDispatchAllCodes);
+  RUN_TEST(ae::test_api_protocol::test_PacketBuilderAllocations);
+  RUN_TEST(ae::test_api_protocol::test_ChildDataSizePrefix);
+  RUN_TEST(ae::test_api_protocol::test_NestedChildDataParse);
+  RUN_TEST(ae::test_api_protocol::test_ChildDataMoveOutOfPacket);
+  RUN_TEST(ae::test_api_protocol::test_NestedDepthLimit);
+  RUN_TEST(ae::test_api_protocol::test_SendResultExpiry);
+  RUN_TEST(ae::test_api_protocol::test_SendResultTableGrows);
+  RUN_TEST(ae::test_api_protocol::test_SendResultSteadyState);
   return UNITY_END();
 }
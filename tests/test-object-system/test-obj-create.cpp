@@ -26,7 +26,7 @@
 #include "objects/collector.h"
 #include "objects/family.h"
 
-#include "map_facility.h"
+#include "test_utils/map_facility.h"
 
 namespace ae::test_obj_create {
 
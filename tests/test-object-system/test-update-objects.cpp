@@ -17,7 +17,7 @@
 #include <unity.h>
 
 #include "aether/obj/domain.h"
-#include "map_facility.h"
+#include "test_utils/map_facility.h"
 #include "objects/seven_fridays.h"
 
 namespace ae::test_update_objects {
@@ -78,6 +78,36 @@ struct Imstream {
   auto& stream() { return stream_; }
 };
 
+// reader over contiguous memory, uses Packed::Decode
+struct IbSpan {
+  using size_type = std::uint32_t;
+
+  std::vector<std::uint8_t> const& data_;
+  std::size_t offset_ = 0;
+  ReadResult result_{};
+
+  size_t read(void* data, size_t size, size_t /* min_size */) {
+    if (offset_ + size > data_.size()) {
+      result_ = ReadResult::kNo;
+      return 0;
+    }
+    std::memcpy(data, data_.data() + offset_, size);
+    offset_ += size;
+    result_ = ReadResult::kYes;
+    return size;
+  }
+
+  ReadResult result() const { return result_; }
+  void result(ReadResult res) { result_ = res; }
+
+  std::uint8_t const* current() const { return data_.data() + offset_; }
+  std::size_t available() const { return data_.size() - offset_; }
+  void skip(std::size_t size) { offset_ += size; }
+};
+
+static_assert(HasContiguousRead<IbSpan>::value);
+static_assert(!HasContiguousRead<IbVector>::value);
+
 static std::string print(std::vector<std::uint8_t> const& v) {
   std::stringstream ss;
   ss << "[";
@@ -98,6 +128,31 @@ T GetRandom(T min, T max) {
   return dis(gen);
 }
 
+// Encode and Decode give the same bytes as Serialize and Deserialize
+template <typename PInt>
+void TestCodec(PInt const& p, std::vector<std::uint8_t> const& serialized) {
+  std::uint8_t data[PInt::kMaxSize];
+  auto size = p.Encode(data);
+  TEST_ASSERT_EQUAL(serialized.size(), size);
+  TEST_ASSERT_EQUAL(serialized.size(), p.Size());
+  TEST_ASSERT_EQUAL(0, std::memcmp(serialized.data(), data, size));
+
+  auto decoded = PInt{};
+  TEST_ASSERT_EQUAL(size, decoded.Decode(data, size));
+  TEST_ASSERT_EQUAL(static_cast<typename PInt::ValueType>(p),
+                    static_cast<typename PInt::ValueType>(decoded));
+  // unchecked path with enough data after the value
+  std::uint8_t padded[PInt::kMaxSize * 2] = {};
+  std::memcpy(padded, data, size);
+  auto padded_decoded = PInt{};
+  TEST_ASSERT_EQUAL(size, padded_decoded.Decode(padded, sizeof(padded)));
+  TEST_ASSERT_EQUAL(static_cast<typename PInt::ValueType>(p),
+                    static_cast<typename PInt::ValueType>(padded_decoded));
+  // not enough data
+  auto truncated = PInt{};
+  TEST_ASSERT_EQUAL(0, truncated.Decode(data, size - 1));
+}
+
 template <typename PInt>
 void TestRange() {
   auto get_next_step = [&]() {
@@ -125,6 +180,7 @@ void TestRange() {
     TEST_ASSERT_EQUAL(res, PackedDeserializeRes::kFinished);
     TEST_ASSERT_EQUAL(static_cast<typename PInt::ValueType>(p),
                       static_cast<typename PInt::ValueType>(des_p));
+    TestCodec(p, os.data());
   }
 }
 
@@ -147,6 +203,7 @@ void TestValueToSize(typename PInt::ValueType value,
   TEST_ASSERT_EQUAL(res, PackedDeserializeRes::kFinished);
   TEST_ASSERT_EQUAL(static_cast<typename PInt::ValueType>(p),
                     static_cast<typename PInt::ValueType>(des_p));
+  TestCodec(p, os.data());
 }
 
 void test_StorePackedInt250() {
@@ -274,6 +331,102 @@ void test_StoreFourBytesMin() {
   TestValueToSize<P64_0x10000000>(0xffffffffff, 8);
   TestRange<P64_0x10000000>();
 }
+
+using PackedSize = Packed<std::uint64_t, std::uint8_t, 250>;
+using PackedIndex = Packed<std::uint32_t, std::uint8_t, 250>;
+
+void test_StreamOperators() {
+  auto values = std::vector<std::uint64_t>{0,     250,     251,
+                                           1514,  1515,    65000,
+                                           70000, 1049834, 0xffffffffff};
+  Omstream os{};
+  for (auto v : values) {
+    os.stream() << PackedSize{v};
+  }
+
+  // contiguous reader
+  auto span = IbSpan{os.data()};
+  auto span_is = imstream{span};
+  // element by element reader
+  Imstream is{os.data()};
+  for (auto v : values) {
+    auto span_value = PackedSize{};
+    span_is >> span_value;
+    TEST_ASSERT_EQUAL(ReadResult::kYes, span_is.result());
+    TEST_ASSERT_EQUAL(v, static_cast<std::uint64_t>(span_value));
+
+    auto value = PackedSize{};
+    is.stream() >> value;
+    TEST_ASSERT_EQUAL(v, static_cast<std::uint64_t>(value));
+  }
+  auto end_value = PackedSize{};
+  span_is >> end_value;
+  TEST_ASSERT_EQUAL(ReadResult::kNo, span_is.result());
+}
+
+// typical sizes, ids and offsets, mostly small
+template <typename PInt>
+std::vector<PInt> MakeValues(std::size_t count) {
+  auto gen = std::mt19937{42};
+  auto dis = std::uniform_int_distribution<std::uint32_t>{0, 99};
+  auto values = std::vector<PInt>{};
+  values.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto r = dis(gen);
+    if (r < 70) {
+      values.emplace_back(r);
+    } else if (r < 95) {
+      values.emplace_back(251 + r * 12);
+    } else {
+      values.emplace_back(100000 + r);
+    }
+  }
+  return values;
+}
+
+template <typename PInt>
+void TestCodecMatchesStream() {
+  static constexpr std::size_t kValues = 10'000;
+
+  auto values = MakeValues<PInt>(kValues);
+
+  // through the stream, value by value
+  Omstream os{};
+  for (auto const& v : values) {
+    v.Serialize(os.stream());
+  }
+
+  auto data = std::vector<std::uint8_t>(kValues * PInt::kMaxSize);
+  std::size_t size = 0;
+  for (auto const& v : values) {
+    size += v.Encode(data.data() + size);
+  }
+  data.resize(size);
+  TEST_ASSERT(os.data() == data);
+
+  auto decoded = std::vector<PInt>(kValues);
+  {
+    auto ib = IbSpan{data};
+    auto is = imstream{ib};
+    for (auto& v : decoded) {
+      v.Deserialize(is);
+    }
+  }
+  TEST_ASSERT(values == decoded);
+
+  decoded.assign(kValues, PInt{});
+  std::size_t offset = 0;
+  for (auto& v : decoded) {
+    offset += v.Decode(data.data() + offset, data.size() - offset);
+  }
+  TEST_ASSERT_EQUAL(data.size(), offset);
+  TEST_ASSERT(values == decoded);
+}
+
+void test_CodecMatchesStream() {
+  TestCodecMatchesStream<PackedSize>();
+  TestCodecMatchesStream<PackedIndex>();
+}
 }  // namespace ae::test_packet_int
 
 int main() {
@@ -283,6 +436,8 @@ int main() {
   RUN_TEST(ae::test_packet_int::test_StoreOneByteMin);
   RUN_TEST(ae::test_packet_int::test_StoreTwoBytesMin);
   RUN_TEST(ae::test_packet_int::test_StoreFourBytesMin);
+  RUN_TEST(ae::test_packet_int::test_StreamOperators);
+  RUN_TEST(ae::test_packet_int::test_CodecMatchesStream);
 
   return UNITY_END();
 }
@@ -16,6 +16,8 @@
 
 #include <unity.h>
 
+#include <chrono>
+#include <cstdint>
 #include <vector>
 
 #include "aether/stream_api/istream.h"
@@ -24,11 +26,16 @@
 #include "aether/actions/action_context.h"
 
 #include "aether/stream_api/crypto_stream.h"
+#include "aether/stream_api/offload_crypto_gate.h"
 
+#include "aether/crypto/crypto_worker_pool.h"
 #include "aether/crypto/sync_crypto_provider.h"
 #include "aether/crypto/async_crypto_provider.h"
+#include "aether/crypto/sodium/sodium_aes_gcm_crypto_provider.h"
+#include "aether/crypto/sodium/sodium_box_crypto_provider.h"
+#include "aether/crypto/sodium/sodium_sync_crypto_provider.h"
 
-#include "tests/test-stream/crypto-stream/mock_key_provider.h"
+#include "test_utils/mock_key_provider.h"
 #include "tests/test-stream/mock_read_gate.h"
 #include "tests/test-stream/mock_write_gate.h"
 #include "unity_internals.h"
@@ -107,6 +114,258 @@ void test_SyncCryptoStream() {
   TEST_ASSERT_EQUAL_STRING(test_data, received_data.data());
 }
 
+void test_SyncCryptoStreamPackets() {
+  auto ap = ActionProcessor{};
+
+  auto received_data = std::vector<DataBuffer>{};
+
+  auto read_stream = MockReadStream{};
+  auto write_stream = MockWriteGate{ap, std::size_t{10 * 1024}};
+
+  auto key_provider = SyncKeyProviderFactory();
+  auto crypto_gate = CryptoGate{MakePtr<SyncEncryptProvider>(key_provider),
+                                MakePtr<SyncDecryptProvider>(key_provider)};
+
+  Tie(read_stream, crypto_gate, write_stream);
+
+  auto _0 = write_stream.on_write_event().Subscribe(
+      [&](auto data, auto) { write_stream.WriteOut(std::move(data)); });
+
+  auto _1 = read_stream.out_data_event().Subscribe(
+      [&](auto data) { received_data.emplace_back(std::move(data)); });
+
+  // decrypt buffer is reused for packets of different sizes
+  auto sizes = std::vector<std::size_t>{sizeof(test_data), 1, 40, 0, 80};
+  for (auto size : sizes) {
+    crypto_gate.Write({test_data, test_data + size}, TimePoint::clock::now());
+  }
+
+  TEST_ASSERT_EQUAL(sizes.size(), received_data.size());
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    TEST_ASSERT_EQUAL(sizes[i], received_data[i].size());
+    if (sizes[i] != 0) {
+      TEST_ASSERT_EQUAL_CHAR_ARRAY(test_data, received_data[i].data(),
+                                   sizes[i]);
+    }
+  }
+}
+
+void test_SyncCryptoStreamAesGcm() {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  if (!SodiumAesGcmAvailable()) {
+    TEST_IGNORE_MESSAGE("AES-256-GCM is not supported by CPU");
+  }
+
+  auto ap = ActionProcessor{};
+
+  auto received_data = std::vector<DataBuffer>{};
+
+  auto read_stream = MockReadStream{};
+  auto write_stream = MockWriteGate{ap, std::size_t{10 * 1024}};
+
+  SodiumAesGcmKey key;
+  crypto_aead_aes256gcm_keygen(key.key.data());
+  CryptoNonce nonce;
+  nonce.Init();
+  auto key_provider =
+      MakePtr<MockSyncKeyProvider>(std::move(key), std::move(nonce));
+  // sync providers select AES-256-GCM by the key type
+  auto crypto_gate = CryptoGate{MakePtr<SyncEncryptProvider>(key_provider),
+                                MakePtr<SyncDecryptProvider>(key_provider)};
+
+  Tie(read_stream, crypto_gate, write_stream);
+
+  auto _0 = write_stream.on_write_event().Subscribe(
+      [&](auto data, auto) { write_stream.WriteOut(std::move(data)); });
+
+  auto _1 = read_stream.out_data_event().Subscribe(
+      [&](auto data) { received_data.emplace_back(std::move(data)); });
+
+  auto sizes = std::vector<std::size_t>{sizeof(test_data), 1, 0};
+  for (auto size : sizes) {
+    crypto_gate.Write({test_data, test_data + size}, TimePoint::clock::now());
+  }
+
+  TEST_ASSERT_EQUAL(sizes.size(), received_data.size());
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    TEST_ASSERT_EQUAL(sizes[i], received_data[i].size());
+    if (sizes[i] != 0) {
+      TEST_ASSERT_EQUAL_CHAR_ARRAY(test_data, received_data[i].data(),
+                                   sizes[i]);
+    }
+  }
+#else
+  TEST_IGNORE_MESSAGE("AES-256-GCM is available with sodium only");
+#endif
+}
+
+void test_ImplicitNonceCryptoProvider() {
+#if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  SodiumChachaKey key;
+  crypto_aead_chacha20poly1305_keygen(key.key.data());
+  // each side has its own nonce
+  CryptoNonce sender_nonce;
+  sender_nonce.Init();
+  CryptoNonce receiver_nonce;
+  receiver_nonce.Init();
+  auto crypto_encrypt = SodiumImplicitNonceEncryptProvider{
+      MakePtr<MockSyncKeyProvider>(key, sender_nonce)};
+  auto crypto_decrypt = SodiumImplicitNonceDecryptProvider{
+      MakePtr<MockSyncKeyProvider>(key, receiver_nonce)};
+
+  auto explicit_encrypt = SyncEncryptProvider{SyncKeyProviderFactory()};
+  TEST_ASSERT_LESS_OR_EQUAL(explicit_encrypt.EncryptOverhead(),
+                            crypto_encrypt.EncryptOverhead());
+
+  auto data = DataBuffer{test_data, test_data + sizeof(test_data)};
+  auto wire_size = std::size_t{};
+  auto decrypted = DataBuffer{};
+  auto packets = ImplicitNonceEpoch::kBaseSyncInterval * 2;
+  for (std::uint32_t i = 0; i < packets; ++i) {
+    auto encrypted = crypto_encrypt.Encrypt(data);
+    wire_size += encrypted.size();
+    // every second packet is lost
+    if ((i % 2) == 1) {
+      continue;
+    }
+    TEST_ASSERT_TRUE(crypto_decrypt.DecryptInto(encrypted, decrypted));
+    TEST_ASSERT_EQUAL(sizeof(test_data), decrypted.size());
+    TEST_ASSERT_EQUAL_STRING(test_data, decrypted.data());
+  }
+  TEST_ASSERT_LESS_THAN(
+      (sizeof(test_data) + explicit_encrypt.EncryptOverhead()) * packets,
+      wire_size);
+
+  // modified and truncated packets are rejected
+  auto encrypted = crypto_encrypt.Encrypt(data);
+  encrypted[0] ^= 1;
+  TEST_ASSERT_FALSE(crypto_decrypt.DecryptInto(encrypted, decrypted));
+  encrypted.resize(1);
+  TEST_ASSERT_FALSE(crypto_decrypt.DecryptInto(encrypted, decrypted));
+#else
+  TEST_IGNORE_MESSAGE("implicit nonce is only for ChaCha20-Poly1305");
+#endif
+}
+
+void test_OffloadCryptoStream() {
+  auto ap = ActionProcessor{};
+
+  auto written_results = std::size_t{};
+  auto received_data = std::vector<DataBuffer>{};
+
+  auto read_stream = MockReadStream{};
+  auto write_stream = MockWriteGate{ap, std::size_t{10 * 1024}};
+
+  auto key_provider = SyncKeyProviderFactory();
+  // packets from 40 bytes are encrypted by workers
+  auto crypto_gate = OffloadCryptoGate{
+      ap, MakePtr<CryptoWorkerPool>(std::size_t{2}),
+      MakePtr<SyncEncryptProvider>(key_provider),
+      MakePtr<SyncDecryptProvider>(key_provider), std::size_t{40}};
+
+  Tie(read_stream, crypto_gate, write_stream);
+
+  auto _0 = write_stream.on_write_event().Subscribe(
+      [&](auto data, auto) { write_stream.WriteOut(std::move(data)); });
+
+  auto _1 = read_stream.out_data_event().Subscribe(
+      [&](auto data) { received_data.emplace_back(std::move(data)); });
+
+  // small packets wait for the offloaded ones before them
+  auto sizes = std::vector<std::size_t>{sizeof(test_data), 1, 80, 40, 0, 120};
+  auto write_subscriptions = MultiSubscription{};
+  for (auto size : sizes) {
+    auto write_action = crypto_gate.Write({test_data, test_data + size},
+                                          TimePoint::clock::now());
+    write_subscriptions.Push(write_action->SubscribeOnResult(
+        [&](auto const&) { ++written_results; }));
+  }
+
+  auto deadline = TimePoint::clock::now() + std::chrono::seconds{5};
+  while ((received_data.size() < sizes.size() ||
+          written_results < sizes.size()) &&
+         (TimePoint::clock::now() < deadline)) {
+    ap.get_trigger().WaitUntil(TimePoint::clock::now() +
+                               std::chrono::milliseconds{10});
+    ap.Update(TimePoint::clock::now());
+  }
+
+  TEST_ASSERT_EQUAL(sizes.size(), written_results);
+  TEST_ASSERT_EQUAL(sizes.size(), received_data.size());
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    TEST_ASSERT_EQUAL(sizes[i], received_data[i].size());
+    if (sizes[i] != 0) {
+      TEST_ASSERT_EQUAL_CHAR_ARRAY(test_data, received_data[i].data(),
+                                   sizes[i]);
+    }
+  }
+}
+
+void test_BoxCryptoProvider() {
+#if AE_CRYPTO_ASYNC == AE_SODIUM_BOX_SEAL
+  SodiumCurvePublicKey alice_pub;
+  SodiumCurveSecretKey alice_sec;
+  crypto_box_keypair(alice_pub.key.data(), alice_sec.key.data());
+  SodiumCurvePublicKey bob_pub;
+  SodiumCurveSecretKey bob_sec;
+  crypto_box_keypair(bob_pub.key.data(), bob_sec.key.data());
+
+  // alice encrypts to bob's public key with her own secret key
+  auto crypto_encrypt = SodiumBoxEncryptProvider{
+      MakePtr<MockAsyncKeyProvider>(bob_pub, alice_sec)};
+  auto crypto_decrypt = SodiumBoxDecryptProvider{
+      MakePtr<MockAsyncKeyProvider>(alice_pub, bob_sec)};
+
+  auto data = DataBuffer{test_data, test_data + sizeof(test_data)};
+  // the second message uses the cached shared key
+  for (auto i = 0; i < 2; ++i) {
+    auto encrypted = crypto_encrypt.Encrypt(data);
+    TEST_ASSERT_EQUAL(sizeof(test_data) + crypto_encrypt.EncryptOverhead(),
+                      encrypted.size());
+    auto decrypted = crypto_decrypt.Decrypt(encrypted);
+    TEST_ASSERT_EQUAL(sizeof(test_data), decrypted.size());
+    TEST_ASSERT_EQUAL_STRING(test_data, decrypted.data());
+  }
+
+  auto detached = crypto_encrypt.Detach();
+  TEST_ASSERT_TRUE(static_cast<bool>(detached));
+  auto encrypted = data;
+  detached(encrypted);
+  auto decrypted = DataBuffer{};
+  TEST_ASSERT(crypto_decrypt.DecryptInto(encrypted, decrypted));
+  TEST_ASSERT_EQUAL_STRING(test_data, decrypted.data());
+
+  // modified and truncated packets are rejected
+  auto modified = encrypted;
+  modified[0] ^= 0x01;
+  TEST_ASSERT_FALSE(crypto_decrypt.DecryptInto(modified, decrypted));
+  TEST_ASSERT(decrypted.empty());
+  auto truncated = DataBuffer{std::begin(encrypted), std::begin(encrypted) + 8};
+  TEST_ASSERT_FALSE(crypto_decrypt.DecryptInto(truncated, decrypted));
+
+  // a packet from anyone but the configured peer is rejected
+  SodiumCurvePublicKey carol_pub;
+  SodiumCurveSecretKey carol_sec;
+  crypto_box_keypair(carol_pub.key.data(), carol_sec.key.data());
+  auto carol_encrypt = SodiumBoxEncryptProvider{
+      MakePtr<MockAsyncKeyProvider>(bob_pub, carol_sec)};
+  TEST_ASSERT_FALSE(
+      crypto_decrypt.DecryptInto(carol_encrypt.Encrypt(data), decrypted));
+  TEST_ASSERT(crypto_decrypt.Decrypt(carol_encrypt.Encrypt(data)).empty());
+
+  // no shared key with a low order peer key, nothing is encrypted
+  auto low_order_encrypt = SodiumBoxEncryptProvider{
+      MakePtr<MockAsyncKeyProvider>(SodiumCurvePublicKey{}, alice_sec)};
+  TEST_ASSERT(low_order_encrypt.Encrypt(data).empty());
+  auto low_order_detached = low_order_encrypt.Detach();
+  auto low_order_data = data;
+  low_order_detached(low_order_data);
+  TEST_ASSERT(low_order_data.empty());
+#else
+  TEST_IGNORE_MESSAGE("crypto_box is not used");
+#endif
+}
+
 void test_AsyncCryptoStream() {
   auto ap = ActionProcessor{};
 
@@ -144,6 +403,11 @@ void test_AsyncCryptoStream() {
 int test_crypto_stream() {
   UNITY_BEGIN();
   RUN_TEST(ae::test_crypto_stream::test_SyncCryptoStream);
+  RUN_TEST(ae::test_crypto_stream::test_SyncCryptoStreamPackets);
+  RUN_TEST(ae::test_crypto_stream::test_SyncCryptoStreamAesGcm);
+  RUN_TEST(ae::test_crypto_stream::test_ImplicitNonceCryptoProvider);
+  RUN_TEST(ae::test_crypto_stream::test_OffloadCryptoStream);
   RUN_TEST(ae::test_crypto_stream::test_AsyncCryptoStream);
+  RUN_TEST(ae::test_crypto_stream::test_BoxCryptoProvider);
   return UNITY_END();
 }
@@ -16,6 +16,11 @@
 
 #include <unity.h>
 
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <optional>
+
 #include "aether/api_protocol/api_message.h"
 #include "aether/port/tele_init.h"
 
@@ -28,6 +33,7 @@
 
 #include "tests/test-stream/mock_read_gate.h"
 #include "tests/test-stream/mock_write_gate.h"
+#include "test_utils/sim_link.h"
 
 namespace ae::test_safe_stream {
 constexpr auto config = SafeStreamConfig{
@@ -143,6 +149,310 @@ void test_SafeStreamPacketLoss() {
   TEST_ASSERT_EQUAL(sizeof(_200_bytes_data), received_packet.size());
 }
 
+void test_SafeStreamSinglePacketLossRecovery() {
+  // timeouts are long enough to be sure the loss is not recovered by them
+  auto recovery_config = config;
+  recovery_config.wait_confirm_timeout = std::chrono::milliseconds{1000};
+  recovery_config.send_repeat_timeout = std::chrono::milliseconds{1000};
+  recovery_config.max_repeat_count = 10;
+
+  auto epoch = TimePoint::clock::now();
+
+  auto ap = ActionProcessor{};
+  auto pc = ProtocolContext{};
+
+  auto received_packet = DataBuffer{};
+  auto sent_data = DataBuffer{};
+  for (auto i = 0; i < 10; ++i) {
+    sent_data.insert(std::end(sent_data), std::begin(_100_bytes_data),
+                     std::end(_100_bytes_data));
+  }
+
+  auto read_stream = MockReadStream{};
+  auto write_stream = MockWriteGate{ap, std::size_t{100}};
+
+  auto safe_stream = SafeStream{ap, recovery_config};
+  Tie(read_stream, safe_stream, write_stream);
+
+  auto send_count = 0;
+  auto loss_time = TimePoint{};
+  // loop data to itself and lose the third "send" packet
+  auto _0 = write_stream.on_write_event().Subscribe(
+      [&](auto data, auto current_time) {
+        auto api_parser = ApiParser{pc, data};
+        auto mid = api_parser.Extract<MessageId>();
+        if ((mid == SafeStreamApi::Send::kMessageCode) &&
+            (++send_count == 3)) {
+          loss_time = current_time;
+          return;
+        }
+        write_stream.WriteOut(std::move(data));
+      });
+
+  auto _1 = read_stream.out_data_event().Subscribe([&](auto data) {
+    received_packet.insert(std::end(received_packet), std::begin(data),
+                           std::end(data));
+  });
+
+  safe_stream.in().Write(DataBuffer{sent_data}, epoch);
+
+  for (auto i = 0; (i < 2000) && (received_packet.size() < sent_data.size());
+       ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{1});
+  }
+
+  TEST_ASSERT_EQUAL(sent_data.size(), received_packet.size());
+  TEST_ASSERT(sent_data == received_packet);
+
+  auto recovery_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(epoch - loss_time);
+  // recovered by duplicated confirms, not by timeout
+  TEST_ASSERT_LESS_THAN(100, recovery_time.count());
+}
+
+void test_SafeStreamSimLink() {
+  auto link_config = config;
+  link_config.wait_confirm_timeout = std::chrono::milliseconds{200};
+  link_config.send_repeat_timeout = std::chrono::milliseconds{100};
+  link_config.max_repeat_count = 20;
+
+  // everything bad at once, but seeded so the run is repeatable
+  auto profile = LinkProfile{
+      "lossy", 100'000, std::chrono::milliseconds{10}, 200, 0.05, 0,
+      std::chrono::milliseconds{5}, 0.05, 0.05};
+
+  auto epoch = TimePoint{};
+
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, profile, 42};
+  auto sender = SafeStream{ap, link_config};
+  auto receiver = SafeStream{ap, link_config};
+  sender.LinkOut(link.left());
+  receiver.LinkOut(link.right());
+
+  auto sent_data = DataBuffer{};
+  auto received_data = DataBuffer{};
+
+  auto _0 = receiver.in().out_data_event().Subscribe([&](auto const& data) {
+    received_data.insert(std::end(received_data), std::begin(data),
+                         std::end(data));
+  });
+
+  for (auto i = 0; i < 50; ++i) {
+    auto data = DataBuffer{std::begin(_200_bytes_data),
+                           std::end(_200_bytes_data)};
+    data[0] = static_cast<std::uint8_t>(i);
+    sent_data.insert(std::end(sent_data), std::begin(data), std::end(data));
+    sender.in().Write(std::move(data), epoch);
+  }
+
+  for (auto i = 0; (i < 60000) && (received_data.size() < sent_data.size());
+       ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{1});
+  }
+
+  TEST_ASSERT_GREATER_THAN(0, link.lost_packets());
+  TEST_ASSERT_GREATER_THAN(0, link.reordered_packets());
+  TEST_ASSERT_GREATER_THAN(0, link.duplicated_packets());
+  TEST_ASSERT_EQUAL(sent_data.size(), received_data.size());
+  TEST_ASSERT(sent_data == received_data);
+}
+
+/**
+ * \brief Records the biggest packet written to the link.
+ */
+class PacketSizeGate final : public ByteGate {
+ public:
+  ActionView<StreamWriteAction> Write(DataBuffer&& buffer,
+                                      TimePoint current_time) override {
+    max_packet_size_ = std::max(max_packet_size_, buffer.size());
+    return out_->Write(std::move(buffer), current_time);
+  }
+
+  std::size_t max_packet_size() const { return max_packet_size_; }
+
+ private:
+  std::size_t max_packet_size_{};
+};
+
+// max size of packets written by two streams sending to each other
+std::size_t TwoWayMaxPacketSize(std::uint16_t confirm_chunk_count) {
+  auto link_config = config;
+  link_config.send_confirm_timeout = std::chrono::milliseconds{10};
+  link_config.confirm_chunk_count = confirm_chunk_count;
+
+  auto profile = LinkProfile{"two way", 100'000,
+                             std::chrono::milliseconds{10}, 200, 0.0};
+
+  auto epoch = TimePoint{};
+
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, profile};
+  auto left = SafeStream{ap, link_config};
+  auto right = SafeStream{ap, link_config};
+  auto left_size = PacketSizeGate{};
+  auto right_size = PacketSizeGate{};
+  Tie(left, left_size, link.left());
+  Tie(right, right_size, link.right());
+
+  auto sent_data = DataBuffer{};
+  auto left_received = DataBuffer{};
+  auto right_received = DataBuffer{};
+  auto _0 = left.in().out_data_event().Subscribe([&](auto const& data) {
+    left_received.insert(std::end(left_received), std::begin(data),
+                         std::end(data));
+  });
+  auto _1 = right.in().out_data_event().Subscribe([&](auto const& data) {
+    right_received.insert(std::end(right_received), std::begin(data),
+                          std::end(data));
+  });
+
+  // both directions send max size chunks
+  for (auto i = 0; i < 20; ++i) {
+    auto data = DataBuffer{std::begin(_200_bytes_data),
+                           std::end(_200_bytes_data)};
+    data[0] = static_cast<std::uint8_t>(i);
+    sent_data.insert(std::end(sent_data), std::begin(data), std::end(data));
+    left.in().Write(DataBuffer{data}, epoch);
+    right.in().Write(std::move(data), epoch);
+  }
+
+  for (auto i = 0; (i < 10000) && ((left_received.size() < sent_data.size()) ||
+                                   (right_received.size() < sent_data.size()));
+       ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{1});
+  }
+
+  TEST_ASSERT(sent_data == left_received);
+  TEST_ASSERT(sent_data == right_received);
+  return std::max(left_size.max_packet_size(), right_size.max_packet_size());
+}
+
+void test_SafeStreamPiggybackFitsElement() {
+  // confirms are sent separately
+  auto max_data_packet = TwoWayMaxPacketSize(1);
+  // confirms are piggybacked only if the data packet has room for them
+  auto max_piggyback_packet = TwoWayMaxPacketSize(2);
+  TEST_ASSERT_LESS_OR_EQUAL(max_data_packet, max_piggyback_packet);
+}
+
+void test_SafeStreamResume() {
+  auto link_config = config;
+  // resume must not wait for the confirm timeout
+  link_config.wait_confirm_timeout = std::chrono::milliseconds{1000};
+  link_config.send_repeat_timeout = std::chrono::milliseconds{100};
+
+  auto profile =
+      LinkProfile{"reset", 100'000, std::chrono::milliseconds{10}, 200, 0};
+
+  auto epoch = TimePoint{};
+
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, profile};
+  auto sender = SafeStream{ap, link_config};
+  auto receiver = SafeStream{ap, link_config};
+  sender.LinkOut(link.left());
+  receiver.LinkOut(link.right());
+
+  auto sent_data = DataBuffer{};
+  auto received_data = DataBuffer{};
+
+  auto _0 = receiver.in().out_data_event().Subscribe([&](auto const& data) {
+    received_data.insert(std::end(received_data), std::begin(data),
+                         std::end(data));
+  });
+
+  for (auto i = 0; i < 50; ++i) {
+    auto data = DataBuffer{std::begin(_200_bytes_data),
+                           std::end(_200_bytes_data)};
+    data[0] = static_cast<std::uint8_t>(i);
+    sent_data.insert(std::end(sent_data), std::begin(data), std::end(data));
+    sender.in().Write(std::move(data), epoch);
+  }
+
+  auto start = epoch;
+  auto step = std::chrono::milliseconds{1};
+  // data in flight is lost with the link
+  for (; epoch < (start + std::chrono::milliseconds{30});) {
+    ap.Update(epoch += step);
+  }
+  link.set_linked(false);
+  for (; epoch < (start + std::chrono::milliseconds{130});) {
+    ap.Update(epoch += step);
+  }
+  auto received_before = received_data.size();
+  TEST_ASSERT_GREATER_THAN(0, received_before);
+  TEST_ASSERT_LESS_THAN(sent_data.size(), received_before);
+
+  link.set_linked(true);
+  auto relink_time = epoch;
+  auto resume_time = std::optional<TimePoint>{};
+  for (auto i = 0; (i < 10000) && (received_data.size() < sent_data.size());
+       ++i) {
+    ap.Update(epoch += step);
+    if (!resume_time && (received_data.size() > received_before)) {
+      resume_time = epoch;
+    }
+  }
+
+  TEST_ASSERT_EQUAL(sent_data.size(), received_data.size());
+  TEST_ASSERT(sent_data == received_data);
+  TEST_ASSERT(resume_time.has_value());
+
+  auto to_ms = [](auto duration) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+        .count();
+  };
+  TEST_ASSERT_LESS_THAN(to_ms(link_config.wait_confirm_timeout),
+                        to_ms(*resume_time - relink_time));
+}
+
+void test_SafeStreamCompactFraming() {
+  auto link_config = config;
+  link_config.wait_confirm_timeout = std::chrono::milliseconds{200};
+  link_config.send_repeat_timeout = std::chrono::milliseconds{100};
+  link_config.max_repeat_count = 20;
+  link_config.compact_framing = true;
+
+  auto profile = LinkProfile{
+      "lossy", 100'000, std::chrono::milliseconds{10}, 200, 0.05, 0,
+      std::chrono::milliseconds{5}, 0.05, 0.05};
+
+  auto epoch = TimePoint{};
+
+  auto ap = ActionProcessor{};
+  auto link = SimLink{ap, profile, 42};
+  auto sender = SafeStream{ap, link_config};
+  auto receiver = SafeStream{ap, link_config};
+  sender.LinkOut(link.left());
+  receiver.LinkOut(link.right());
+
+  auto sent_messages = std::vector<DataBuffer>{};
+  auto received_messages = std::vector<DataBuffer>{};
+
+  auto _0 = receiver.in().out_data_event().Subscribe(
+      [&](auto const& data) { received_messages.emplace_back(data); });
+
+  // small messages and messages split to a few chunks
+  for (std::size_t i = 0; i < 40; ++i) {
+    auto data = DataBuffer((i * 37) % 450 + 1);
+    for (std::size_t j = 0; j < data.size(); ++j) {
+      data[j] = static_cast<std::uint8_t>(i + j);
+    }
+    sent_messages.emplace_back(data);
+    sender.in().Write(std::move(data), epoch);
+  }
+
+  for (auto i = 0;
+       (i < 60000) && (received_messages.size() < sent_messages.size()); ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{1});
+  }
+
+  TEST_ASSERT_GREATER_THAN(0, link.lost_packets());
+  TEST_ASSERT_EQUAL(sent_messages.size(), received_messages.size());
+  TEST_ASSERT(sent_messages == received_messages);
+}
+
 }  // namespace ae::test_safe_stream
 
 int test_safe_stream() {
@@ -151,5 +461,10 @@ int test_safe_stream() {
   UNITY_BEGIN();
   RUN_TEST(ae::test_safe_stream::test_SafeStreamWriteFewData);
   RUN_TEST(ae::test_safe_stream::test_SafeStreamPacketLoss);
+  RUN_TEST(ae::test_safe_stream::test_SafeStreamSinglePacketLossRecovery);
+  RUN_TEST(ae::test_safe_stream::test_SafeStreamSimLink);
+  RUN_TEST(ae::test_safe_stream::test_SafeStreamPiggybackFitsElement);
+  RUN_TEST(ae::test_safe_stream::test_SafeStreamResume);
+  RUN_TEST(ae::test_safe_stream::test_SafeStreamCompactFraming);
   return UNITY_END();
 }
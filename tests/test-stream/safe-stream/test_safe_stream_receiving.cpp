@@ -190,6 +190,80 @@ void test_SafeStreamReceiveRequestRepeat() {
   TEST_ASSERT_EQUAL(0, repeat_requested.size());
 }
 
+void test_SafeStreamReceiveDelayConfirm() {
+  auto epoch = TimePoint::clock::now();
+
+  auto ap = ActionProcessor{};
+  auto ac = ActionContext{ap};
+  auto pc = ProtocolContext{};
+
+  auto delayed_config = config;
+  delayed_config.send_confirm_timeout = std::chrono::milliseconds{10};
+  delayed_config.confirm_chunk_count = 3;
+
+  auto confirms = std::vector<std::uint16_t>{};
+  auto received_size = std::size_t{};
+
+  auto receiving = SafeStreamReceivingAction{ac, pc, delayed_config};
+
+  auto _0 = receiving.send_data_event().Subscribe([&](auto const& data, auto) {
+    auto api_parser = ae::ApiParser(pc, data);
+    auto api = SafeStreamApi{};
+    api_parser.Parse(api);
+  });
+
+  auto _1 = pc.OnMessage<SafeStreamApi::Confirm>([&](auto const& msg) {
+    confirms.push_back(static_cast<std::uint16_t>(msg.message().offset));
+  });
+
+  auto _2 = receiving.receive_event().Subscribe(
+      [&](DataBuffer&& data) { received_size += data.size(); });
+
+  ap.Update(epoch);
+
+  // two chunks are delivered at once, but confirmed after timeout
+  receiving.ReceiveSend(SafeStreamRingIndex{0},
+                        {_200_bytes_data, _200_bytes_data + 100});
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  receiving.ReceiveSend(SafeStreamRingIndex{100},
+                        {_200_bytes_data + 100, _200_bytes_data + 200});
+  ap.Update(epoch += std::chrono::milliseconds{1});
+
+  TEST_ASSERT_EQUAL(200, received_size);
+  TEST_ASSERT_EQUAL(0, confirms.size());
+
+  ap.Update(epoch += delayed_config.send_confirm_timeout);
+  TEST_ASSERT_EQUAL(1, confirms.size());
+  TEST_ASSERT_EQUAL(199, confirms[0]);
+  confirms.clear();
+
+  // confirm_chunk_count chunks are confirmed without waiting
+  for (SafeStreamRingIndex::type offset = 200; offset < 500; offset += 100) {
+    receiving.ReceiveSend(SafeStreamRingIndex{offset},
+                          {_100_bytes_data, _100_bytes_data + 100});
+  }
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  TEST_ASSERT_EQUAL(1, confirms.size());
+  TEST_ASSERT_EQUAL(499, confirms[0]);
+  confirms.clear();
+
+  // confirm taken for the outgoing data is not sent again, even if the chunk
+  // is not handled by update yet
+  receiving.ReceiveSend(SafeStreamRingIndex{500},
+                        {_100_bytes_data, _100_bytes_data + 100});
+  auto piggyback = receiving.TakeConfirms(epoch);
+  TEST_ASSERT_FALSE(piggyback.empty());
+  TEST_ASSERT_EQUAL(600, received_size);
+  auto api_parser = ae::ApiParser(pc, piggyback);
+  auto api = SafeStreamApi{};
+  api_parser.Parse(api);
+  TEST_ASSERT_EQUAL(1, confirms.size());
+  TEST_ASSERT_EQUAL(599, confirms[0]);
+  TEST_ASSERT_TRUE(receiving.TakeConfirms(epoch).empty());
+
+  ap.Update(epoch += delayed_config.send_confirm_timeout);
+  TEST_ASSERT_EQUAL(1, confirms.size());
+}
 }  // namespace ae::test_safe_stream_receiving
 
 int test_safe_stream_receiving() {
@@ -197,5 +271,6 @@ int test_safe_stream_receiving() {
   UNITY_BEGIN();
   RUN_TEST(ae::test_safe_stream_receiving::test_SafeStreamReceiveAFewPackets);
   RUN_TEST(ae::test_safe_stream_receiving::test_SafeStreamReceiveRequestRepeat);
+  RUN_TEST(ae::test_safe_stream_receiving::test_SafeStreamReceiveDelayConfirm);
   return UNITY_END();
 }
@@ -286,6 +286,118 @@ void test_SafeStreamSendingRepeatRequest() {
   TEST_ASSERT(sending_error);
 }
 
+void test_SafeStreamSendingFastRepeat() {
+  auto epoch = TimePoint::clock::now();
+
+  auto ap = ActionProcessor{};
+  auto ac = ActionContext(ap);
+  auto pc = ProtocolContext{};
+  auto received_packet = DataBuffer{};
+  auto send_count = 0;
+  auto repeat_count = 0;
+  auto repeat_offset = SafeStreamRingIndex::type{};
+
+  auto sending = SafeStreamSendingAction{ac, pc, config};
+  sending.set_max_data_size(100);
+
+  auto _0 = sending.write_data_event().Subscribe([&](auto, auto data, auto) {
+    received_packet = std::move(data);
+    auto api_parser = ae::ApiParser(pc, received_packet);
+    auto mid = api_parser.Extract<MessageId>();
+    switch (mid) {
+      case SafeStreamApi::Send::kMessageCode: {
+        api_parser.Extract<SafeStreamApi::Send>();
+        ++send_count;
+        break;
+      }
+      case SafeStreamApi::Repeat::kMessageCode: {
+        auto repeat = api_parser.Extract<SafeStreamApi::Repeat>();
+        ++repeat_count;
+        repeat_offset = repeat.offset;
+        break;
+      }
+      default:
+        TEST_ASSERT(false);
+        break;
+    }
+  });
+
+  sending.SendData(
+      {_100_bytes_data, _100_bytes_data + sizeof(_100_bytes_data)});
+  sending.SendData(
+      {_200_bytes_data, _200_bytes_data + sizeof(_200_bytes_data)});
+  for (auto i = 0; i < 3; ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{1});
+  }
+  TEST_ASSERT_EQUAL(3, send_count);
+
+  // chunk at 100 is lost, chunks after it are confirmed by duplicates
+  sending.Confirm(SafeStreamRingIndex{99});
+  sending.Confirm(SafeStreamRingIndex{99});
+  sending.Confirm(SafeStreamRingIndex{99});
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  TEST_ASSERT_EQUAL(0, repeat_count);
+
+  sending.Confirm(SafeStreamRingIndex{99});
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  // repeated long before wait confirm timeout
+  TEST_ASSERT_EQUAL(1, repeat_count);
+  TEST_ASSERT_EQUAL(100, repeat_offset);
+
+  // next duplicates do not repeat it again
+  sending.Confirm(SafeStreamRingIndex{99});
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  TEST_ASSERT_EQUAL(1, repeat_count);
+  TEST_ASSERT_EQUAL(3, send_count);
+}
+
+void test_SafeStreamSendingLinkNeverBack() {
+  auto epoch = TimePoint::clock::now();
+
+  auto ap = ActionProcessor{};
+  auto ac = ActionContext(ap);
+  auto pc = ProtocolContext{};
+  auto send_count = 0;
+  auto sending_error = false;
+
+  auto sending = SafeStreamSendingAction{ac, pc, config};
+  sending.set_max_data_size(100);
+  sending.set_linked(true);
+
+  auto _0 = sending.write_data_event().Subscribe(
+      [&](auto, auto, auto) { ++send_count; });
+
+  auto send_action = sending.SendData(
+      {_100_bytes_data, _100_bytes_data + sizeof(_100_bytes_data)});
+  auto _1 =
+      send_action->SubscribeOnError([&](auto const&) { sending_error = true; });
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  TEST_ASSERT_EQUAL(1, send_count);
+
+  sending.set_linked(false);
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  // data is kept while the link may come back
+  for (auto i = 0; i < 9; ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{10});
+  }
+  TEST_ASSERT_FALSE(sending_error);
+
+  // link is lost for max_repeat_count * wait_confirm_timeout
+  ap.Update(epoch += std::chrono::milliseconds{11});
+  TEST_ASSERT(sending_error);
+  TEST_ASSERT_EQUAL(1, send_count);
+
+  // new data is rejected while the link is still lost
+  auto late_error = false;
+  auto late_action = sending.SendData(
+      {_100_bytes_data, _100_bytes_data + sizeof(_100_bytes_data)});
+  auto _2 =
+      late_action->SubscribeOnError([&](auto const&) { late_error = true; });
+  ap.Update(epoch += std::chrono::milliseconds{1});
+  TEST_ASSERT(late_error);
+  TEST_ASSERT_EQUAL(1, send_count);
+}
+
 }  // namespace ae::test_safe_stream_sending
 
 int test_safe_stream_sending() {
@@ -296,6 +408,8 @@ int test_safe_stream_sending() {
   RUN_TEST(ae::test_safe_stream_sending::test_SafeStreamSendingWaitConfirm);
   RUN_TEST(ae::test_safe_stream_sending::test_SafeStreamSendingRepeat);
   RUN_TEST(ae::test_safe_stream_sending::test_SafeStreamSendingRepeatRequest);
+  RUN_TEST(ae::test_safe_stream_sending::test_SafeStreamSendingFastRepeat);
+  RUN_TEST(ae::test_safe_stream_sending::test_SafeStreamSendingLinkNeverBack);
 
   return UNITY_END();
 }
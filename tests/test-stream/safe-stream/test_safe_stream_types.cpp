@@ -23,6 +23,7 @@
 #include "aether/actions/action_context.h"
 #include "aether/actions/action_processor.h"
 
+#include "aether/stream_api/safe_stream/send_pacer.h"
 #include "aether/stream_api/safe_stream/send_data_buffer.h"
 #include "aether/stream_api/safe_stream/safe_stream_types.h"
 #include "aether/stream_api/safe_stream/sending_chunk_list.h"
@@ -247,6 +248,36 @@ void test_SendDataBuffer() {
   TEST_ASSERT_TRUE(a3_res.stopped);
 }
 
+void test_SendPacer() {
+  auto epoch = TimePoint{std::chrono::seconds{1}};
+
+  auto pacer = SendPacer{10000, std::chrono::seconds{1}};
+  pacer.set_burst_size(2000);
+
+  // burst is sent at once
+  TEST_ASSERT(pacer.SendTime(1000, epoch) == epoch);
+  pacer.Consume(1000);
+  TEST_ASSERT(pacer.SendTime(1000, epoch) == epoch);
+  pacer.Consume(1000);
+
+  // initial rtt gives 10 bytes per ms
+  auto send_time = pacer.SendTime(1000, epoch);
+  TEST_ASSERT(send_time > (epoch + std::chrono::milliseconds{99}));
+  TEST_ASSERT(send_time <= (epoch + std::chrono::milliseconds{101}));
+
+  // measured rtt replaces the initial one, 100 bytes per ms
+  pacer.AddRttSample(std::chrono::milliseconds{100});
+  TEST_ASSERT(pacer.srtt() == std::chrono::milliseconds{100});
+  send_time = pacer.SendTime(1000, epoch);
+  TEST_ASSERT(send_time > (epoch + std::chrono::milliseconds{9}));
+  TEST_ASSERT(send_time <= (epoch + std::chrono::milliseconds{11}));
+  TEST_ASSERT(pacer.SendTime(1000, send_time) == send_time);
+
+  // next samples are smoothed
+  pacer.AddRttSample(std::chrono::milliseconds{900});
+  TEST_ASSERT(pacer.srtt() == std::chrono::milliseconds{200});
+}
+
 }  // namespace ae::test_safe_stream_types
 
 int test_safe_stream_types() {
@@ -257,5 +288,6 @@ int test_safe_stream_types() {
   RUN_TEST(ae::test_safe_stream_types::test_SendingChunkList);
   RUN_TEST(ae::test_safe_stream_types::test_SendingChunkListRepeatCount);
   RUN_TEST(ae::test_safe_stream_types::test_SendDataBuffer);
+  RUN_TEST(ae::test_safe_stream_types::test_SendPacer);
   return UNITY_END();
 }
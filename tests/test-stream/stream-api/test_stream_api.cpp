@@ -15,6 +15,8 @@
  */
 
 #include <chrono>
+#include <vector>
+#include <algorithm>
 #include "aether/common.h"
 #include "aether/transport/data_buffer.h"
 #include "unity.h"
@@ -23,6 +25,7 @@
 #include "aether/port/tele_init.h"
 
 #include "aether/stream_api/stream_api.h"
+#include "aether/stream_api/fec_gate.h"
 
 #include "tests/test-stream/mock_read_gate.h"
 #include "tests/test-stream/mock_write_gate.h"
@@ -66,6 +69,106 @@ void test_SteamApiMakePacket() {
   TEST_ASSERT_EQUAL_STRING(test_data, read_data.data());
 }
 
+void test_FecGateRestore() {
+  auto epoch = TimePoint::clock::now();
+  ActionProcessor ap;
+
+  auto read_data = std::vector<DataBuffer>{};
+  auto read_stream = MockReadStream{};
+  auto write_stream = MockWriteGate{ap, std::size_t{100}};
+
+  auto fec_gate = FecGate{ap, FecConfig{4, 2}};
+
+  // lose data packets 1 and 2, they are covered by different parities
+  auto written_count = 0;
+  auto _0 = write_stream.on_write_event().Subscribe([&](auto data, auto) {
+    auto index = written_count++;
+    if ((index == 1) || (index == 2)) {
+      return;
+    }
+    write_stream.WriteOut(std::move(data));
+  });
+
+  auto _1 = read_stream.out_data_event().Subscribe(
+      [&](auto data) { read_data.emplace_back(std::move(data)); });
+
+  Tie(read_stream, fec_gate, write_stream);
+
+  TEST_ASSERT_EQUAL(100 - 6, fec_gate.stream_info().max_element_size);
+
+  auto packets = std::vector<DataBuffer>{
+      {test_data, test_data + sizeof(test_data)},
+      {test_data, test_data + 5},
+      {test_data + 5, test_data + sizeof(test_data)},
+      {test_data, test_data + 1},
+  };
+  for (auto packet : packets) {
+    fec_gate.Write(std::move(packet), epoch);
+  }
+
+  // 4 data packets and 2 parity
+  TEST_ASSERT_EQUAL(6, written_count);
+  TEST_ASSERT_EQUAL(2, fec_gate.restored_count());
+  TEST_ASSERT_EQUAL(4, read_data.size());
+  for (auto const& packet : packets) {
+    TEST_ASSERT(std::find(std::begin(read_data), std::end(read_data),
+                          packet) != std::end(read_data));
+  }
+}
+
+void test_FecGateFlushPartialGroup() {
+  auto epoch = TimePoint::clock::now();
+  ActionProcessor ap;
+
+  auto read_data = std::vector<DataBuffer>{};
+  auto read_stream = MockReadStream{};
+  auto write_stream = MockWriteGate{ap, std::size_t{100}};
+
+  auto config = FecConfig{4, 2, std::chrono::milliseconds{20}};
+  auto fec_gate = FecGate{ap, config};
+
+  // lose data packet 1 of the group which is never filled up
+  auto written_count = 0;
+  auto _0 = write_stream.on_write_event().Subscribe([&](auto data, auto) {
+    if (written_count++ == 1) {
+      return;
+    }
+    write_stream.WriteOut(std::move(data));
+  });
+
+  auto _1 = read_stream.out_data_event().Subscribe(
+      [&](auto data) { read_data.emplace_back(std::move(data)); });
+
+  Tie(read_stream, fec_gate, write_stream);
+
+  auto packets = std::vector<DataBuffer>{
+      {test_data, test_data + sizeof(test_data)},
+      {test_data, test_data + 5},
+      {test_data + 5, test_data + sizeof(test_data)},
+  };
+  for (auto packet : packets) {
+    fec_gate.Write(std::move(packet), epoch);
+  }
+  ap.Update(epoch);
+  TEST_ASSERT_EQUAL(3, written_count);
+  TEST_ASSERT_EQUAL(2, read_data.size());
+
+  // writer is idle, the partial group is closed with parity
+  ap.Update(epoch + std::chrono::milliseconds{10});
+  TEST_ASSERT_EQUAL(3, written_count);
+  ap.Update(epoch + config.flush_timeout);
+  TEST_ASSERT_EQUAL(5, written_count);
+  TEST_ASSERT_EQUAL(1, fec_gate.restored_count());
+  TEST_ASSERT_EQUAL(3, read_data.size());
+  TEST_ASSERT(read_data.back() == packets[1]);
+
+  // the next group starts from the beginning
+  fec_gate.Write({test_data, test_data + 1}, epoch + config.flush_timeout);
+  ap.Update(epoch + config.flush_timeout * 2);
+  TEST_ASSERT_EQUAL(7, written_count);
+  TEST_ASSERT_EQUAL(4, read_data.size());
+}
+
 }  // namespace ae::test_stream_api
 
 int test_stream_api() {
@@ -73,5 +176,7 @@ int test_stream_api() {
 
   UNITY_BEGIN();
   RUN_TEST(ae::test_stream_api::test_SteamApiMakePacket);
+  RUN_TEST(ae::test_stream_api::test_FecGateRestore);
+  RUN_TEST(ae::test_stream_api::test_FecGateFlushPartialGroup);
   return UNITY_END();
 }
@@ -16,6 +16,10 @@
 
 #include "unity.h"
 
+#include <memory>
+#include <cstdint>
+#include <utility>
+
 #include "aether/obj/domain.h"
 #include "aether/aether.h"
 #include "aether/client.h"
@@ -23,9 +27,12 @@
 #include "aether/work_cloud.h"
 #include "aether/port/tele_init.h"
 
+#include "aether/crypto/key_gen.h"
+#include "aether/client_connections/client_crypto_session.h"
 #include "aether/client_connections/client_to_server_stream.h"
+#include "aether/crypto/sodium/sodium_sync_crypto_provider.h"
 
-#include "test-object-system/map_facility.h"
+#include "test_utils/map_facility.h"
 #include "test-transport/mock_transport.h"
 
 #if defined AE_DISTILLATION
@@ -36,11 +43,11 @@ inline constexpr char test_data[] =
 
 class TestClientToServerStreamFixture {
  public:
-  TestClientToServerStreamFixture() {
+  explicit TestClientToServerStreamFixture(Key master_key = Key{}) {
     TeleInit::Init();
     server->server_id = 1;
     cloud->AddServer(server);
-    client->SetConfig(Uid{{1}}, Uid{{1}}, Key{}, cloud);
+    client->SetConfig(Uid{{1}}, Uid{{1}}, std::move(master_key), cloud);
   }
 
   auto MockTransport() {
@@ -130,6 +137,86 @@ void test_clientToServerStreamConnectionDeferred() {
 
   TEST_ASSERT(data_received);
 }
+
+#  if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+// epoch base of the packet if it is sent
+std::uint64_t PacketEpochBase(DataBuffer const& packet) {
+  auto const* header = packet.data() + packet.size() -
+                       ImplicitNonceEpoch::kHeaderSize;
+  if ((header[1] & (ImplicitNonceEpoch::kBaseFlag >> 8)) == 0) {
+    return 0;
+  }
+  auto const* base_bytes = header - ImplicitNonceEpoch::kBaseSize;
+  auto base = std::uint64_t{};
+  for (std::size_t i = 0; i < ImplicitNonceEpoch::kBaseSize; ++i) {
+    base |= std::uint64_t{base_bytes[i]} << (i * 8);
+  }
+  return base;
+}
+
+void test_implicitNonceSessions() {
+  auto master_key = Key{};
+  TEST_ASSERT(CryptoSyncKeygen(master_key));
+
+  // client and the server side with the same keys and independent nonces
+  TestClientToServerStreamFixture client_fixture{master_key};
+  TestClientToServerStreamFixture server_fixture{master_key};
+  auto server_id = client_fixture.server->server_id;
+  for (auto* fixture : {&client_fixture, &server_fixture}) {
+    auto nonce = CryptoNonce{};
+    nonce.Init();
+    fixture->client->server_state(server_id)->set_nonce(nonce);
+  }
+
+  auto crypto_encrypt =
+      std::make_unique<SodiumImplicitNonceEncryptProvider>(
+          MakePtr<SessionEncryptKeyProvider>(MakePtr<ClientCryptoSession>(
+              client_fixture.client, server_id)));
+  auto crypto_decrypt = SodiumImplicitNonceDecryptProvider{
+      MakePtr<SessionEncryptKeyProvider>(
+          MakePtr<ClientCryptoSession>(server_fixture.client, server_id))};
+
+  auto data = DataBuffer{test_data, test_data + sizeof(test_data)};
+  auto decrypted = DataBuffer{};
+
+  auto first = crypto_encrypt->Encrypt(data);
+  auto first_base = PacketEpochBase(first);
+  TEST_ASSERT_NOT_EQUAL(0, first_base);
+  // the first packet with the base is lost, the epoch is unknown
+  for (std::uint32_t i = 1; i < ImplicitNonceEpoch::kBaseSyncInterval; ++i) {
+    auto encrypted = crypto_encrypt->Encrypt(data);
+    TEST_ASSERT_EQUAL(0, PacketEpochBase(encrypted));
+    TEST_ASSERT_FALSE(crypto_decrypt.DecryptInto(encrypted, decrypted));
+  }
+  // every second packet is lost after the base is repeated
+  for (auto i = 0; i < 10; ++i) {
+    auto encrypted = crypto_encrypt->Encrypt(data);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(test_data) +
+                                  crypto_encrypt->EncryptOverhead(),
+                              encrypted.size());
+    if ((i % 2) == 1) {
+      continue;
+    }
+    TEST_ASSERT(crypto_decrypt.DecryptInto(encrypted, decrypted));
+    TEST_ASSERT_EQUAL(sizeof(test_data), decrypted.size());
+    TEST_ASSERT_EQUAL_STRING(test_data, decrypted.data());
+  }
+
+  // modified packet is rejected
+  auto encrypted = crypto_encrypt->Encrypt(data);
+  encrypted[0] ^= 1;
+  TEST_ASSERT_FALSE(crypto_decrypt.DecryptInto(encrypted, decrypted));
+
+  // restarted client continues after the checkpointed nonce
+  crypto_encrypt = std::make_unique<SodiumImplicitNonceEncryptProvider>(
+      MakePtr<SessionEncryptKeyProvider>(
+          MakePtr<ClientCryptoSession>(client_fixture.client, server_id)));
+  encrypted = crypto_encrypt->Encrypt(data);
+  TEST_ASSERT_GREATER_THAN(first_base, PacketEpochBase(encrypted));
+  TEST_ASSERT(crypto_decrypt.DecryptInto(encrypted, decrypted));
+  TEST_ASSERT_EQUAL_STRING(test_data, decrypted.data());
+}
+#  endif
 }  // namespace ae::test_client_to_server_stream
 
 #endif
@@ -142,6 +229,9 @@ int test_client_to_server_stream() {
                test_clientToServerStreamConnectionFailed);
   RUN_TEST(ae::test_client_to_server_stream::
                test_clientToServerStreamConnectionDeferred);
+#  if AE_CRYPTO_SYNC == AE_CHACHA20_POLY1305
+  RUN_TEST(ae::test_client_to_server_stream::test_implicitNonceSessions);
+#  endif
 #endif
   return UNITY_END();
 }
@@ -20,12 +20,16 @@ void setUp() {}
 void tearDown() {}
 
 extern int test_data_packet_collector();
+extern int test_data_buffer_pool();
+extern int test_transport_write_gate();
 
 extern int test_client_to_server_stream();
 
 int main() {
   int res = 0;
   res += test_data_packet_collector();
+  res += test_data_buffer_pool();
+  res += test_transport_write_gate();
   res += test_client_to_server_stream();
   return res;
 }
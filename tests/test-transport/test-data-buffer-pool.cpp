@@ -0,0 +1,175 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unity.h>
+
+#include <vector>
+#include <cstdint>
+
+#include "aether/mstream.h"
+#include "aether/mstream_buffers.h"
+#include "aether/transport/data_buffer_pool.h"
+#include "aether/transport/low_level/tcp/data_packet_collector.h"
+
+#include "test_utils/alloc_counter.h"
+
+namespace ae::test_data_buffer_pool {
+void test_GetPut() {
+  auto pool = DataBufferPool{4096};
+  auto buffer = pool.Get(100);
+  TEST_ASSERT(buffer.empty());
+  // rounded up to the class size
+  TEST_ASSERT_EQUAL(128, buffer.capacity());
+  buffer.resize(100);
+  auto const* data = buffer.data();
+
+  pool.Put(std::move(buffer));
+  TEST_ASSERT_EQUAL(128, pool.pooled_bytes());
+
+  auto reused = pool.Get(120);
+  TEST_ASSERT(reused.empty());
+  TEST_ASSERT_EQUAL_PTR(data, reused.data());
+  TEST_ASSERT_EQUAL(0, pool.pooled_bytes());
+
+  // a buffer of the previous class is used if it's large enough
+  auto odd = DataBuffer{};
+  odd.reserve(250);
+  auto const* odd_data = odd.data();
+  pool.Put(std::move(odd));
+  TEST_ASSERT(pool.Get(251).data() != odd_data);
+  TEST_ASSERT_EQUAL_PTR(odd_data, pool.Get(250).data());
+
+  // buffer of the next class is also used
+  pool.Put(std::move(reused));
+  auto small = pool.Get(60);
+  TEST_ASSERT_EQUAL_PTR(data, small.data());
+  // but not a larger one
+  auto large = pool.Get(512);
+  auto const* large_data = large.data();
+  pool.Put(std::move(large));
+  auto tiny = pool.Get(10);
+  TEST_ASSERT(tiny.data() != large_data);
+  TEST_ASSERT_EQUAL(512, pool.pooled_bytes());
+}
+
+void test_Limits() {
+  auto pool = DataBufferPool{1000};
+  // too small and too large buffers are not pooled
+  auto small = DataBuffer{};
+  small.reserve(10);
+  pool.Put(std::move(small));
+  auto large = DataBuffer{};
+  large.reserve(DataBufferPool::kMaxClassSize + 1);
+  pool.Put(std::move(large));
+  TEST_ASSERT_EQUAL(0, pool.pooled_bytes());
+
+  // only max_pooled_bytes are kept
+  pool.Put(pool.Get(256));
+  pool.Put(pool.Get(512));
+  TEST_ASSERT_EQUAL(768, pool.pooled_bytes());
+  pool.Put(pool.Get(1000));
+  TEST_ASSERT_EQUAL(768, pool.pooled_bytes());
+
+  // and only kMaxClassBuffers per class
+  auto class_pool = DataBufferPool{4096};
+  for (std::size_t i = 0; i <= DataBufferPool::kMaxClassBuffers; ++i) {
+    auto buffer = DataBuffer{};
+    buffer.reserve(64);
+    class_pool.Put(std::move(buffer));
+  }
+  TEST_ASSERT_EQUAL(DataBufferPool::kMaxClassBuffers * 64,
+                    class_pool.pooled_bytes());
+
+  auto huge = pool.Get(DataBufferPool::kMaxClassSize * 2);
+  TEST_ASSERT(huge.capacity() >= DataBufferPool::kMaxClassSize * 2);
+}
+
+void test_PooledDataBuffer() {
+  auto* pool = DataBufferPool::Local();
+  TEST_ASSERT_NOT_NULL(pool);
+  auto const* data = static_cast<std::uint8_t const*>(nullptr);
+  {
+    auto buffer = PooledDataBuffer{GetDataBuffer(1000)};
+    buffer->resize(1000);
+    data = buffer.data();
+    auto moved = std::move(buffer);
+    TEST_ASSERT(buffer.empty());
+    TEST_ASSERT_EQUAL(1000, moved.size());
+  }
+  // returned to the thread's pool on destruction
+  auto reused = GetDataBuffer(1000);
+  TEST_ASSERT_EQUAL_PTR(data, reused.data());
+
+  // released buffer is not returned
+  auto released = PooledDataBuffer{std::move(reused)};
+  auto buffer = std::move(released).Release();
+  TEST_ASSERT_EQUAL_PTR(data, buffer.data());
+}
+
+std::vector<std::uint8_t> MakeStreamPacket(std::size_t size) {
+  std::vector<std::uint8_t> packet;
+  AppendSerialized<PacketSize>(packet, std::vector<std::uint8_t>(size, 0x55));
+  return packet;
+}
+
+void test_ReceiveAllocations() {
+  static constexpr std::size_t kPackets = 1000;
+  static constexpr std::size_t kReadSize = 1400;
+
+  // packets of different sizes read in socket sized parts
+  auto stream = std::vector<std::uint8_t>{};
+  for (std::size_t i = 0; i < kPackets; ++i) {
+    auto packet = MakeStreamPacket(100 + (i % 10) * 100);
+    stream.insert(stream.end(), packet.begin(), packet.end());
+  }
+
+  StreamDataPacketCollector collector;
+  auto receive = [&]() {
+    std::size_t received = 0;
+    for (std::size_t offset = 0; offset < stream.size(); offset += kReadSize) {
+      auto size = std::min(kReadSize, stream.size() - offset);
+      // the same as UnixTcpTransport reads the socket
+      auto data = PooledDataBuffer{GetDataBuffer(size)};
+      data->assign(stream.data() + offset, stream.data() + offset + size);
+      collector.AddData(*data);
+      for (auto packet = collector.PopPacket(); !packet.empty();
+           packet = collector.PopPacket()) {
+        ++received;
+      }
+    }
+    return received;
+  };
+  // warm up buffers
+  TEST_ASSERT_EQUAL(kPackets, receive());
+
+  auto allocations = AllocationCount();
+  TEST_ASSERT_EQUAL(kPackets, receive());
+  allocations = AllocationCount() - allocations;
+
+  // only the packet queue allocates its nodes from time to time, see
+  // serialization_bench for the number per packet
+  TEST_ASSERT(allocations < kPackets / 4);
+}
+}  // namespace ae::test_data_buffer_pool
+
+int test_data_buffer_pool() {
+  UNITY_BEGIN();
+  RUN_TEST(ae::test_data_buffer_pool::test_GetPut);
+  RUN_TEST(ae::test_data_buffer_pool::test_Limits);
+  RUN_TEST(ae::test_data_buffer_pool::test_PooledDataBuffer);
+  RUN_TEST(ae::test_data_buffer_pool::test_ReceiveAllocations);
+  return UNITY_END();
+}
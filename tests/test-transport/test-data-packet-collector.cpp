@@ -75,7 +75,7 @@ void test_AddOnePacket() {
   auto data_packet = collector.PopPacket();
 
   TEST_ASSERT(!data_packet.empty());
-  AssertPacket(data_packet);
+  AssertPacket(*data_packet);
 
   auto p = collector.PopPacket();
   TEST_ASSERT(p.empty());
@@ -91,7 +91,7 @@ void test_AddFewPackets() {
     auto data_packet = collector.PopPacket();
 
     TEST_ASSERT(!data_packet.empty());
-    AssertPacket(data_packet);
+    AssertPacket(*data_packet);
   }
 
   auto p = collector.PopPacket();
@@ -123,7 +123,7 @@ void test_AddFewPacketInOne() {
     auto data_packet = collector.PopPacket();
 
     TEST_ASSERT(!data_packet.empty());
-    AssertPacket(data_packet);
+    AssertPacket(*data_packet);
   }
   auto p = collector.PopPacket();
   TEST_ASSERT(p.empty());
@@ -151,6 +151,28 @@ void test_BigPacketPartially() {
     TEST_ASSERT(!p.empty());
   }
 }
+
+void test_ReusePacketBuffers() {
+  StreamDataPacketCollector collector;
+  // buffers of popped packets are reused for smaller and larger ones
+  for (auto size : {2000, 100, 1, 3000, 100, 70'000, 10}) {
+    auto data = std::vector<std::uint8_t>(static_cast<std::size_t>(size));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<std::uint8_t>(i + static_cast<std::size_t>(size));
+    }
+    auto packet = MakeStreamPacket(data);
+    // with the next packet's size in the same data
+    auto next = TestPacket();
+    packet.insert(packet.end(), next.begin(), next.end());
+    collector.AddData(std::move(packet));
+
+    auto data_packet = collector.PopPacket();
+    TEST_ASSERT_EQUAL(data.size(), data_packet.size());
+    TEST_ASSERT(data == *data_packet);
+    AssertPacket(*collector.PopPacket());
+    TEST_ASSERT(collector.PopPacket().empty());
+  }
+}
 }  // namespace ae::test_data_pc
 
 int test_data_packet_collector() {
@@ -161,5 +183,6 @@ int test_data_packet_collector() {
   RUN_TEST(ae::test_data_pc::test_AddBigPacket);
   RUN_TEST(ae::test_data_pc::test_AddFewPacketInOne);
   RUN_TEST(ae::test_data_pc::test_BigPacketPartially);
+  RUN_TEST(ae::test_data_pc::test_ReusePacketBuffers);
   return UNITY_END();
 }
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unity.h>
+
+#include <chrono>
+#include <cstddef>
+
+#include "aether/obj/ptr.h"
+#include "aether/actions/action_processor.h"
+#include "aether/stream_api/safe_stream.h"
+#include "aether/stream_api/buffer_gate.h"
+#include "aether/stream_api/transport_write_gate.h"
+
+#include "test-transport/mock_transport.h"
+
+namespace ae::test_transport_write_gate {
+constexpr auto config = SafeStreamConfig{
+    20 * 1024,
+    10 * 1024,
+    100,
+    std::chrono::milliseconds{50},
+    std::chrono::milliseconds{0},
+    std::chrono::milliseconds{10},
+    2,
+};
+
+constexpr char _100_bytes_data[] =
+    "The quick brown fox jumps over the lazy dog. Pack my box with five dozen "
+    "liquor jugs. How vexing...";
+
+void test_LinkFollowsTransport() {
+  auto ap = ActionProcessor{};
+  auto transport = MakePtr<MockTransport>(ap, ConnectionInfo{{}, 1500});
+  auto transport_gate = TransportWriteGate{ap, transport};
+
+  TEST_ASSERT_FALSE(transport_gate.stream_info().is_linked);
+  transport->Connect();
+  TEST_ASSERT(transport_gate.stream_info().is_linked);
+  TEST_ASSERT(transport_gate.stream_info().is_writeble);
+
+  int updates = 0;
+  auto _0 = transport_gate.gate_update_event().Subscribe(
+      [&]() { ++updates; });
+  transport->Disconnected();
+  TEST_ASSERT_FALSE(transport_gate.stream_info().is_linked);
+  TEST_ASSERT_FALSE(transport_gate.stream_info().is_writeble);
+  TEST_ASSERT_EQUAL(1, updates);
+  // repeated errors are not reported again
+  transport->Disconnected();
+  TEST_ASSERT_EQUAL(1, updates);
+
+  transport->Connected();
+  TEST_ASSERT(transport_gate.stream_info().is_linked);
+  TEST_ASSERT_EQUAL(2, updates);
+}
+
+void test_SafeStreamPausesOnDisconnect() {
+  auto epoch = TimePoint::clock::now();
+  auto ap = ActionProcessor{};
+  auto transport = MakePtr<MockTransport>(ap, ConnectionInfo{{}, 1500});
+
+  auto safe_stream = SafeStream{ap, config};
+  auto buffer_gate = BufferGate{ap, 100};
+  auto transport_gate = TransportWriteGate{ap, transport};
+  Tie(safe_stream, buffer_gate, transport_gate);
+
+  std::size_t sent_packets = 0;
+  auto _0 = transport->sent_data_event().Subscribe([&](auto& action) {
+    ++sent_packets;
+    action.SetState(PacketSendAction::State::kSuccess);
+  });
+
+  transport->Connect();
+  safe_stream.in().Write(
+      DataBuffer{std::begin(_100_bytes_data), std::end(_100_bytes_data)},
+      epoch);
+  ap.Update(epoch);
+  TEST_ASSERT_GREATER_THAN(0, sent_packets);
+
+  // the link state goes through buffer gate to safe stream
+  transport->Disconnected();
+  TEST_ASSERT_FALSE(buffer_gate.stream_info().is_linked);
+
+  // no repeats are sent to a disconnected transport
+  sent_packets = 0;
+  for (auto i = 0; i < 20; ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{10});
+  }
+  TEST_ASSERT_EQUAL(0, sent_packets);
+
+  // sending resumes after reconnect
+  transport->Connected();
+  TEST_ASSERT(buffer_gate.stream_info().is_linked);
+  for (auto i = 0; (i < 20) && (sent_packets == 0); ++i) {
+    ap.Update(epoch += std::chrono::milliseconds{10});
+  }
+  TEST_ASSERT_GREATER_THAN(0, sent_packets);
+}
+}  // namespace ae::test_transport_write_gate
+
+int test_transport_write_gate() {
+  UNITY_BEGIN();
+  RUN_TEST(ae::test_transport_write_gate::test_LinkFollowsTransport);
+  RUN_TEST(ae::test_transport_write_gate::test_SafeStreamPausesOnDisconnect);
+  return UNITY_END();
+}
@@ -22,11 +22,15 @@ void tearDown() {}
 extern int test_fixed_point();
 extern int test_literal_array();
 extern int test_ring_buffer();
+extern int test_mstream();
+extern int test_memory_buffer();
 
 int main() {
   int res = 0;
   res += test_fixed_point();
   res += test_literal_array();
   res += test_ring_buffer();
+  res += test_mstream();
+  res += test_memory_buffer();
   return res;
 }
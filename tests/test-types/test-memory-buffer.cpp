@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unity.h>
+
+#include <vector>
+#include <cstdint>
+
+#include "aether/memory_buffer.h"
+
+namespace ae::test_memory_buffer {
+using Buffer = MemStreamBuf<char, std::char_traits<char>, 16>;
+
+void Append(Buffer& buffer, std::size_t size, char value) {
+  auto data = std::vector<char>(size, value);
+  buffer.sputn(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+void test_GeometricGrowth() {
+  auto buffer = Buffer{};
+  TEST_ASSERT_EQUAL(16, buffer.Capacity());
+
+  std::size_t reallocations = 0;
+  auto capacity = buffer.Capacity();
+  for (std::size_t i = 0; i < 1000; ++i) {
+    Append(buffer, 3, static_cast<char>(i));
+    if (buffer.Capacity() != capacity) {
+      ++reallocations;
+      // at least doubled
+      TEST_ASSERT(buffer.Capacity() >= capacity * 2);
+      capacity = buffer.Capacity();
+    }
+  }
+  TEST_ASSERT_EQUAL(3000, buffer.Size());
+  TEST_ASSERT(reallocations <= 8);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_EQUAL(static_cast<char>(i), buffer.Data()[i * 3 + 2]);
+  }
+
+  // large append grows to the required size
+  Append(buffer, 10'000, 1);
+  TEST_ASSERT_EQUAL(13'000, buffer.Size());
+  TEST_ASSERT(buffer.Capacity() >= 13'000);
+  TEST_ASSERT_EQUAL(0, buffer.Capacity() % 16);
+
+  // single chars go through overflow
+  auto chars = Buffer{};
+  for (std::size_t i = 0; i < 100; ++i) {
+    chars.sputc('a');
+  }
+  TEST_ASSERT_EQUAL(100, chars.Size());
+  TEST_ASSERT_EQUAL(128, chars.Capacity());
+}
+
+void test_Reserve() {
+  auto buffer = Buffer{};
+  buffer.Reserve(1000);
+  TEST_ASSERT_EQUAL(1008, buffer.Capacity());
+  auto* data = buffer.Data();
+  Append(buffer, 1000, 1);
+  TEST_ASSERT_EQUAL_PTR(data, buffer.Data());
+
+  // never shrinks
+  buffer.Reserve(10);
+  TEST_ASSERT_EQUAL(1008, buffer.Capacity());
+  TEST_ASSERT_EQUAL(1000, buffer.Size());
+}
+
+void test_ResetKeepsCapacity() {
+  auto buffer = Buffer{};
+  Append(buffer, 1000, 1);
+  auto capacity = buffer.Capacity();
+  auto* data = buffer.Data();
+
+  buffer.Reset();
+  TEST_ASSERT_EQUAL(0, buffer.Size());
+  TEST_ASSERT_EQUAL(0, buffer.AvailableData());
+  TEST_ASSERT_EQUAL(capacity, buffer.Capacity());
+
+  Append(buffer, 10, 2);
+  TEST_ASSERT_EQUAL_PTR(data, buffer.Data());
+  TEST_ASSERT_EQUAL(10, buffer.Size());
+  TEST_ASSERT_EQUAL(10, buffer.AvailableData());
+  char read[10];
+  TEST_ASSERT_EQUAL(10, buffer.sgetn(read, 10));
+  TEST_ASSERT_EQUAL(2, read[9]);
+
+  // rewinding the write position keeps capacity too
+  buffer.pubseekpos(0, std::ios_base::out);
+  TEST_ASSERT_EQUAL(0, buffer.Size());
+  TEST_ASSERT_EQUAL(capacity, buffer.Capacity());
+}
+}  // namespace ae::test_memory_buffer
+
+int test_memory_buffer() {
+  UNITY_BEGIN();
+  RUN_TEST(ae::test_memory_buffer::test_GeometricGrowth);
+  RUN_TEST(ae::test_memory_buffer::test_Reserve);
+  RUN_TEST(ae::test_memory_buffer::test_ResetKeepsCapacity);
+  return UNITY_END();
+}
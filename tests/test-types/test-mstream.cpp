@@ -0,0 +1,352 @@
+/*
+ * Copyright 2024 Aethernet Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unity.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "aether/uid.h"
+#include "aether/mstream.h"
+#include "aether/data_view.h"
+#include "aether/packed_int.h"
+#include "aether/mstream_buffers.h"
+
+namespace ae::test_mstream {
+using PackedSize = Packed<std::uint64_t, std::uint8_t, 250>;
+
+struct Item {
+  template <typename T>
+  void Serializator(T& s) {
+    s & id & name;
+  }
+
+  std::uint16_t id;
+  std::string name;
+};
+
+struct Message {
+  template <typename T>
+  void Serializator(T& s) {
+    s & code & items & payload;
+  }
+
+  std::uint8_t code;
+  std::vector<Item> items;
+  std::vector<std::uint8_t> payload;
+};
+
+Message MakeMessage() {
+  return Message{
+      3, {{1, "first"}, {2, "second"}}, std::vector<std::uint8_t>(300, 7)};
+}
+
+template <typename T>
+std::vector<std::uint8_t> WriteWithVector(T const& value) {
+  auto data = std::vector<std::uint8_t>{};
+  auto writer = VectorWriter<PackedSize>{data};
+  auto os = omstream{writer};
+  os << value;
+  return data;
+}
+
+void test_SerializedSize() {
+  auto message = MakeMessage();
+  auto data = WriteWithVector(message);
+  TEST_ASSERT_EQUAL(data.size(), SerializedSize<PackedSize>(message));
+  // payload size 300 is packed to two bytes
+  TEST_ASSERT_EQUAL(1 + 1 + (2 + 1 + 5) + (2 + 1 + 6) + 2 + 300, data.size());
+}
+
+void test_AppendSerialized() {
+  auto message = MakeMessage();
+  auto expected = WriteWithVector(message);
+
+  auto data = std::vector<std::uint8_t>{1, 2, 3};
+  AppendSerialized<PackedSize>(data, message);
+  TEST_ASSERT_EQUAL(expected.size() + 3, data.size());
+  TEST_ASSERT_EQUAL(expected.size() + 3, data.capacity());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), data.data() + 3,
+                                expected.size());
+}
+
+void test_SizedField() {
+  auto message = MakeMessage();
+  auto nested = WriteWithVector(message);
+  // the same layout as nested data written into a temporary buffer
+  auto expected = WriteWithVector(nested);
+
+  auto data = std::vector<std::uint8_t>{};
+  AppendSerialized<PackedSize>(data, WithSize(message));
+  TEST_ASSERT_EQUAL(expected.size(), data.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), data.data(), expected.size());
+
+  auto reader = VectorReader<PackedSize>{data};
+  auto is = imstream{reader};
+  auto read_message = Message{};
+  is >> WithSize(read_message);
+  TEST_ASSERT_EQUAL(ReadResult::kYes, is.result());
+  TEST_ASSERT_EQUAL(message.code, read_message.code);
+  TEST_ASSERT_EQUAL(message.items.size(), read_message.items.size());
+  TEST_ASSERT_EQUAL_STRING(message.items[1].name.c_str(),
+                           read_message.items[1].name.c_str());
+  TEST_ASSERT(message.payload == read_message.payload);
+}
+
+std::vector<std::uint8_t> SizedData(std::vector<std::uint8_t> const& field,
+                                    std::size_t size) {
+  auto data = std::vector<std::uint8_t>{};
+  auto writer = VectorWriter<PackedSize>{data};
+  auto os = omstream{writer};
+  os << PackedSize{size};
+  data.insert(std::end(data), std::begin(field), std::end(field));
+  // the next value after the field
+  data.push_back(0xAB);
+  return data;
+}
+
+template <typename Reader>
+ReadResult ReadSized(Reader& reader, Message& message, std::uint8_t& next) {
+  auto is = imstream{reader};
+  is >> WithSize(message);
+  if (is.result() != ReadResult::kYes) {
+    return is.result();
+  }
+  is >> next;
+  return is.result();
+}
+
+void test_SizedFieldBounds() {
+  auto message = MakeMessage();
+  auto nested = WriteWithVector(message);
+
+  // unknown rest of the field is skipped
+  auto extended = nested;
+  extended.insert(std::end(extended), {1, 2, 3});
+  auto data = SizedData(extended, extended.size());
+  {
+    auto reader = VectorReader<PackedSize>{data};
+    auto read_message = Message{};
+    std::uint8_t next{};
+    TEST_ASSERT_EQUAL(ReadResult::kYes,
+                      ReadSized(reader, read_message, next));
+    TEST_ASSERT(message.payload == read_message.payload);
+    TEST_ASSERT_EQUAL(0xAB, next);
+  }
+  // the same through a stream buffer without contiguous read
+  {
+    auto reader = MemStreamReader<PackedSize>{};
+    reader.add_data(data.data(), data.size());
+    auto read_message = Message{};
+    std::uint8_t next{};
+    TEST_ASSERT_EQUAL(ReadResult::kYes,
+                      ReadSized(reader, read_message, next));
+    TEST_ASSERT(message.payload == read_message.payload);
+    TEST_ASSERT_EQUAL(0xAB, next);
+  }
+
+  // the field does not read past its size
+  auto short_data = SizedData(nested, nested.size() - 10);
+  {
+    auto reader = VectorReader<PackedSize>{short_data};
+    auto read_message = Message{};
+    std::uint8_t next{};
+    TEST_ASSERT_EQUAL(ReadResult::kNo, ReadSized(reader, read_message, next));
+  }
+  {
+    auto reader = MemStreamReader<PackedSize>{};
+    reader.add_data(short_data.data(), short_data.size());
+    auto read_message = Message{};
+    std::uint8_t next{};
+    TEST_ASSERT_EQUAL(ReadResult::kNo, ReadSized(reader, read_message, next));
+  }
+
+  // the size is more than the data
+  auto long_data = SizedData(nested, nested.size() + 100);
+  {
+    auto reader = VectorReader<PackedSize>{long_data};
+    auto read_message = Message{};
+    std::uint8_t next{};
+    TEST_ASSERT_EQUAL(ReadResult::kNo, ReadSized(reader, read_message, next));
+  }
+}
+
+// payload counting its serializations
+struct CountedPayload {
+  std::vector<std::uint8_t> data;
+  mutable std::size_t writes = 0;
+};
+
+template <typename Ob>
+omstream<Ob>& operator<<(omstream<Ob>& s, CountedPayload const& payload) {
+  ++payload.writes;
+  return s << payload.data;
+}
+
+// payload nested in depth sized fields
+struct NestedLevel {
+  std::size_t depth;
+  CountedPayload const& payload;
+};
+
+template <typename Ob>
+omstream<Ob>& operator<<(omstream<Ob>& s, NestedLevel const& level) {
+  if (level.depth == 0) {
+    return s << level.payload;
+  }
+  return s << WithSize(NestedLevel{level.depth - 1, level.payload});
+}
+
+void test_NestedSizedField() {
+  static constexpr std::size_t kDepth = 5;
+
+  auto payload = CountedPayload{std::vector<std::uint8_t>(300, 7)};
+  // the same layout as each level written into a temporary buffer
+  auto expected = WriteWithVector(payload.data);
+  for (std::size_t i = 0; i < kDepth; ++i) {
+    expected = WriteWithVector(expected);
+  }
+  payload.writes = 0;
+
+  auto data = std::vector<std::uint8_t>{};
+  AppendSerialized<PackedSize>(data, NestedLevel{kDepth, payload});
+  TEST_ASSERT_EQUAL(expected.size(), data.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), data.data(), expected.size());
+  // one counting and one writing pass whatever the depth is
+  TEST_ASSERT_EQUAL(2, payload.writes);
+}
+
+static_assert(IsTriviallySerializableV<std::uint32_t>);
+static_assert(IsTriviallySerializableV<std::array<std::uint16_t, 4>>);
+static_assert(IsTriviallySerializableV<Uid>);
+static_assert(!IsTriviallySerializableV<Item>);
+
+void test_BulkArrays() {
+  auto uids = std::vector<Uid>{};
+  for (std::uint8_t i = 0; i < 10; ++i) {
+    uids.emplace_back(Uid{{i, 1, 2, 3}});
+  }
+  auto data = WriteWithVector(uids);
+
+  // the same bytes as written element by element
+  auto expected = std::vector<std::uint8_t>{};
+  {
+    auto writer = VectorWriter<PackedSize>{expected};
+    auto os = omstream{writer};
+    os << static_cast<PackedSize>(uids.size());
+    for (auto const& uid : uids) {
+      os << uid;
+    }
+  }
+  TEST_ASSERT_EQUAL(expected.size(), data.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), data.data(), expected.size());
+
+  auto reader = VectorReader<PackedSize>{data};
+  auto is = imstream{reader};
+  auto read_uids = std::vector<Uid>{};
+  is >> read_uids;
+  TEST_ASSERT_EQUAL(ReadResult::kYes, is.result());
+  TEST_ASSERT(uids == read_uids);
+
+  auto values = std::array<std::array<std::uint16_t, 3>, 2>{
+      {{1, 2, 3}, {0x0102, 0x0304, 0x0506}}};
+  auto values_data = WriteWithVector(values);
+  TEST_ASSERT_EQUAL(sizeof(values), values_data.size());
+  auto values_reader = VectorReader<PackedSize>{values_data};
+  auto values_is = imstream{values_reader};
+  auto read_values = std::array<std::array<std::uint16_t, 3>, 2>{};
+  values_is >> read_values;
+  TEST_ASSERT(values == read_values);
+}
+
+struct Payload {
+  template <typename T>
+  void Serializator(T& s) {
+    s & code & data;
+  }
+
+  std::uint8_t code;
+  DataView data;
+};
+
+void test_DataView() {
+  auto payload = std::vector<std::uint8_t>(300, 7);
+  // the same layout as DataBuffer
+  auto data = WriteWithVector(Payload{3, DataView{payload}});
+  auto expected = WriteWithVector(Message{3, {}, payload});
+  TEST_ASSERT_EQUAL(expected.size() - 1, data.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data() + 2, data.data() + 1,
+                                data.size() - 1);
+
+  // contiguous reader makes a view into the read data
+  auto reader = VectorReader<PackedSize>{data};
+  auto is = imstream{reader};
+  auto read_payload = Payload{};
+  is >> read_payload;
+  TEST_ASSERT_EQUAL(ReadResult::kYes, is.result());
+  TEST_ASSERT(read_payload.data.is_view());
+  TEST_ASSERT_EQUAL_PTR(data.data() + 3, read_payload.data.data());
+  TEST_ASSERT_EQUAL(payload.size(), read_payload.data.size());
+  TEST_ASSERT(payload == read_payload.data.CopyData());
+
+  // copy owns the data
+  auto copy = read_payload.data;
+  TEST_ASSERT(!copy.is_view());
+  TEST_ASSERT(payload == std::move(copy).ToBuffer());
+
+  // moved view owns the data and does not dangle
+  auto viewed = payload;
+  auto view = DataView{viewed.data(), viewed.size()};
+  auto moved_payload = Payload{3, std::move(view)};
+  TEST_ASSERT(!moved_payload.data.is_view());
+  auto moved = std::move(read_payload.data);
+  TEST_ASSERT(!moved.is_view());
+  TEST_ASSERT(payload == moved.CopyData());
+  viewed.assign(viewed.size(), 0);
+  TEST_ASSERT(payload == moved_payload.data.CopyData());
+
+  // other readers copy the data
+  auto stream_reader = MemStreamReader<PackedSize>{};
+  stream_reader.add_data(data.data(), data.size());
+  auto stream_is = imstream{stream_reader};
+  auto stream_payload = Payload{};
+  stream_is >> stream_payload;
+  TEST_ASSERT_EQUAL(ReadResult::kYes, stream_is.result());
+  TEST_ASSERT(!stream_payload.data.is_view());
+  TEST_ASSERT(payload == stream_payload.data.CopyData());
+
+  // truncated data is not read
+  auto truncated = std::vector<std::uint8_t>{data.begin(), data.end() - 1};
+  auto truncated_reader = VectorReader<PackedSize>{truncated};
+  auto truncated_is = imstream{truncated_reader};
+  truncated_is >> read_payload;
+  TEST_ASSERT_EQUAL(ReadResult::kNo, truncated_is.result());
+}
+
+}  // namespace ae::test_mstream
+
+int test_mstream() {
+  UNITY_BEGIN();
+  RUN_TEST(ae::test_mstream::test_SerializedSize);
+  RUN_TEST(ae::test_mstream::test_AppendSerialized);
+  RUN_TEST(ae::test_mstream::test_SizedField);
+  RUN_TEST(ae::test_mstream::test_SizedFieldBounds);
+  RUN_TEST(ae::test_mstream::test_NestedSizedField);
+  RUN_TEST(ae::test_mstream::test_BulkArrays);
+  RUN_TEST(ae::test_mstream::test_DataView);
+  return UNITY_END();
+}
@@ -76,11 +76,42 @@ void test_RingBufferDistance() {
   TEST_ASSERT_EQUAL(4, d4);
 }
 
+void test_RingBufferPowerOfTwo() {
+  using U8RI = RingIndex<std::uint8_t, 16>;
+  static_assert(U8RI::kPowerOfTwo);
+
+  auto b1 = U8RI{0};
+  TEST_ASSERT_EQUAL(1, static_cast<std::uint8_t>(b1 + 1));
+  TEST_ASSERT_EQUAL(15, static_cast<std::uint8_t>(b1 - 1));
+  TEST_ASSERT_EQUAL(0, static_cast<std::uint8_t>(b1 + 16));
+  TEST_ASSERT_EQUAL(2, static_cast<std::uint8_t>(b1 + 18));
+  TEST_ASSERT_EQUAL(1, static_cast<std::uint8_t>(U8RI{17}));
+
+  auto b2 = U8RI{14};
+  TEST_ASSERT_EQUAL(3, static_cast<std::uint8_t>(b2 + 5));
+  TEST_ASSERT_EQUAL(5, b2.Distance(b2 + 5));
+  TEST_ASSERT_EQUAL(11, (b2 + 5).Distance(b2));
+
+  using U32RI = RingIndex<std::uint32_t, (std::uint32_t{1} << 31)>;
+  static_assert(U32RI::kPowerOfTwo);
+  static_assert(!RingIndex<std::uint16_t>::kPowerOfTwo);
+
+  auto a1 = U32RI{(std::uint32_t{1} << 31) - 10};
+  auto a2 = a1 + 1024 * 1024;
+  TEST_ASSERT_EQUAL(1024 * 1024 - 10, static_cast<std::uint32_t>(a2));
+  TEST_ASSERT_EQUAL(1024 * 1024, a1.Distance(a2));
+  TEST_ASSERT(a1 == (a2 - 1024 * 1024));
+  auto a3 = U32RI{U32RI::kMask};
+  ++a3;
+  TEST_ASSERT_EQUAL(0, static_cast<std::uint32_t>(a3));
+}
+
 }  // namespace ae::test_ring_buffer
 
 int test_ring_buffer() {
   UNITY_BEGIN();
   RUN_TEST(ae::test_ring_buffer::test_RingBufferShifting);
   RUN_TEST(ae::test_ring_buffer::test_RingBufferDistance);
+  RUN_TEST(ae::test_ring_buffer::test_RingBufferPowerOfTwo);
   return UNITY_END();
 }